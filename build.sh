@@ -15,7 +15,7 @@ CONFIGURATION=${1:-Debug}
 mkdir -p ../LemonNet/bin/$CONFIGURATION/net9.0
 
 # Compile the wrapper with static libstdc++ to avoid version issues
-g++ -fPIC -shared -O2 -std=c++11 \
+g++ -fPIC -shared -O2 -std=c++11 -pthread \
     -static-libstdc++ -static-libgcc \
     $LEMON_INCLUDE \
     lemon_wrapper.cpp \
@@ -0,0 +1,80 @@
+using BenchmarkDotNet.Attributes;
+using LemonNet;
+
+/// <summary>
+/// Direction-optimizing BFS against LEMON's top-down Bfs on a power-law (R-MAT) graph,
+/// where the middle levels of the search cover most of the graph.
+/// </summary>
+[MemoryDiagnoser]
+public class BfsBenchmarks
+{
+    private LemonDigraph? graph;
+    private Node sourceNode;
+    private int[] distances = Array.Empty<int>();
+    private int[] predecessors = Array.Empty<int>();
+
+    [Params(16, 18)]
+    public int Scale { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        // R-MAT graph with 2^Scale nodes and 8 * 2^Scale edges in both directions,
+        // using the Graph500 quadrant probabilities (0.57, 0.19, 0.19, 0.05)
+        int nodeCount = 1 << Scale;
+        int edgeCount = 8 * nodeCount;
+        var random = new Random(42); // Fixed seed for reproducibility
+
+        graph = new LemonDigraph();
+        var nodes = new Node[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            nodes[i] = graph.AddNode();
+        }
+
+        for (int i = 0; i < edgeCount; i++)
+        {
+            int u = 0;
+            int v = 0;
+            for (int bit = 0; bit < Scale; bit++)
+            {
+                double r = random.NextDouble();
+                u = 2 * u + (r >= 0.76 ? 1 : 0);
+                v = 2 * v + (r >= 0.57 && r < 0.76 || r >= 0.95 ? 1 : 0);
+            }
+            graph.AddArc(nodes[u], nodes[v]);
+            graph.AddArc(nodes[v], nodes[u]);
+        }
+
+        // Node 0 collects the most edges under these probabilities
+        sourceNode = nodes[0];
+        distances = new int[nodeCount];
+        predecessors = new int[nodeCount];
+
+        // Build the CSR snapshot outside the measured runs
+        using var warmup = new BreadthFirstSearch(graph);
+        warmup.Run(sourceNode, distances, predecessors);
+
+        Console.WriteLine($"Created R-MAT graph with {graph.NodeCount} nodes and {graph.ArcCount} arcs");
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        graph?.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public int BenchmarkTopDownBfs()
+    {
+        using var bfs = new BreadthFirstSearch(graph!) { DirectionOptimizing = false };
+        return bfs.Run(sourceNode, distances, predecessors);
+    }
+
+    [Benchmark]
+    public int BenchmarkDirectionOptimizingBfs()
+    {
+        using var bfs = new BreadthFirstSearch(graph!);
+        return bfs.Run(sourceNode, distances, predecessors);
+    }
+}
@@ -0,0 +1,99 @@
+using BenchmarkDotNet.Attributes;
+using LemonNet;
+
+/// <summary>
+/// Cost of repairing a shortest path tree after a batch of arc length changes,
+/// against recomputing the tree from scratch, for growing batch sizes.
+/// </summary>
+[MemoryDiagnoser]
+public class DynamicShortestPathBenchmarks
+{
+    private const int BatchCount = 64;
+
+    private LemonDigraph? graph;
+    private ArcMapDouble? lengthMap;
+    private DynamicShortestPathTree? tree;
+    private Node sourceNode;
+    private Node unreachableNode;
+    private Arc[][] batchArcs = Array.Empty<Arc[]>();
+    private double[][] batchLengths = Array.Empty<double[]>();
+    private Node[] changedNodes = Array.Empty<Node>();
+    private int nextBatch;
+
+    [Params(1, 10, 100, 1000)]
+    public int BatchSize { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        // Random graph with 200,000 nodes and 2,000,000 arcs, lengths 1-1000
+        const int nodeCount = 200_000;
+        const int arcCount = 2_000_000;
+        var random = new Random(42); // Fixed seed for reproducibility
+
+        graph = new LemonDigraph();
+        var nodes = new Node[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            nodes[i] = graph.AddNode();
+        }
+
+        lengthMap = new ArcMapDouble(graph);
+        var arcs = new Arc[arcCount];
+        for (int i = 0; i < arcCount; i++)
+        {
+            arcs[i] = graph.AddArc(nodes[random.Next(nodeCount)], nodes[random.Next(nodeCount)]);
+            lengthMap[arcs[i]] = random.Next(1, 1001);
+        }
+
+        // Batches of random arcs with new random lengths, so both increases and decreases occur
+        batchArcs = new Arc[BatchCount][];
+        batchLengths = new double[BatchCount][];
+        for (int b = 0; b < BatchCount; b++)
+        {
+            batchArcs[b] = new Arc[BatchSize];
+            batchLengths[b] = new double[BatchSize];
+            for (int i = 0; i < BatchSize; i++)
+            {
+                batchArcs[b][i] = arcs[random.Next(arcCount)];
+                batchLengths[b][i] = random.Next(1, 1001);
+            }
+        }
+
+        // An isolated target makes the recompute settle every reachable node, i.e. build the full tree
+        sourceNode = nodes[0];
+        unreachableNode = graph.AddNode();
+        tree = new DynamicShortestPathTree(graph, lengthMap, sourceNode);
+        changedNodes = new Node[graph.NodeCount];
+
+        Console.WriteLine($"Created random graph with {graph.NodeCount} nodes and {graph.ArcCount} arcs");
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        tree?.Dispose();
+        lengthMap?.Dispose();
+        graph?.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public bool BenchmarkRecompute()
+    {
+        int b = nextBatch++ % BatchCount;
+        for (int i = 0; i < BatchSize; i++)
+        {
+            lengthMap![batchArcs[b][i]] = batchLengths[b][i];
+        }
+
+        using var dijkstra = new Dijkstra(graph!, lengthMap!);
+        return dijkstra.Run(sourceNode, unreachableNode).TargetReached;
+    }
+
+    [Benchmark]
+    public int BenchmarkIncrementalUpdate()
+    {
+        int b = nextBatch++ % BatchCount;
+        return tree!.Update(batchArcs[b], batchLengths[b], changedNodes);
+    }
+}
@@ -22,12 +22,34 @@ public class MaxFlowBenchmarks
     private List<Arc> extraLargeArcs = new();
     private List<int> extraLargeCapacities = new();
     
+    private ArcMap? smallCapacityMap;
+    private ArcMap? largeCapacityMap;
+    private List<Node> smallNodes = new();
+    private List<Node> largeNodes = new();
+    
     [GlobalSetup]
     public void Setup()
     {
         SetupSmallGraph();
         SetupLargeGraph();
         SetupExtraLargeGraph();
+        
+        smallCapacityMap = CreateCapacityMap(smallGraph!, smallArcs, smallCapacities);
+        largeCapacityMap = CreateCapacityMap(largeGraph!, largeArcs, largeCapacities);
+        
+        // Every node of the layered graphs has an arc, so the arcs give the node list
+        smallNodes = smallArcs.SelectMany(a => new[] { smallGraph!.Source(a), smallGraph!.Target(a) }).Distinct().ToList();
+        largeNodes = largeArcs.SelectMany(a => new[] { largeGraph!.Source(a), largeGraph!.Target(a) }).Distinct().ToList();
+    }
+    
+    private static ArcMap CreateCapacityMap(LemonDigraph graph, List<Arc> arcs, List<int> capacities)
+    {
+        var capacityMap = new ArcMap(graph);
+        for (int i = 0; i < arcs.Count; i++)
+        {
+            capacityMap[arcs[i]] = capacities[i];
+        }
+        return capacityMap;
     }
     
     private void SetupSmallGraph()
@@ -424,6 +446,8 @@ public class MaxFlowBenchmarks
     [GlobalCleanup]
     public void Cleanup()
     {
+        smallCapacityMap?.Dispose();
+        largeCapacityMap?.Dispose();
         smallGraph?.Dispose();
         largeGraph?.Dispose();
         extraLargeGraph?.Dispose();
@@ -518,4 +542,49 @@ public class MaxFlowBenchmarks
         // Run the algorithm
         return preflow.Run(extraLargeSourceNode, extraLargeSinkNode);
     }
-}
\ No newline at end of file
+    
+    // Global minimum cut: Hao-Orlin against the naive approach of fixing one
+    // node and running a max flow to and from every other node
+    [Benchmark]
+    public long BenchmarkGlobalMinCut()
+    {
+        return GlobalMinCut.Run(smallGraph!, smallCapacityMap!).Value;
+    }
+    
+    [Benchmark]
+    public long BenchmarkGlobalMinCutNaive()
+    {
+        return NaiveGlobalMinCut(smallGraph!, smallCapacityMap!, smallNodes);
+    }
+    
+    [Benchmark]
+    public long BenchmarkGlobalMinCutLarge()
+    {
+        return GlobalMinCut.Run(largeGraph!, largeCapacityMap!).Value;
+    }
+    
+    [Benchmark]
+    public long BenchmarkGlobalMinCutNaiveLarge()
+    {
+        return NaiveGlobalMinCut(largeGraph!, largeCapacityMap!, largeNodes);
+    }
+    
+    [Benchmark]
+    public long BenchmarkGlobalMinCutUndirectedLarge()
+    {
+        return GlobalMinCut.Run(largeGraph!, largeCapacityMap!, undirected: true).Value;
+    }
+    
+    private static long NaiveGlobalMinCut(LemonDigraph graph, ArcMap capacityMap, List<Node> nodes)
+    {
+        using var preflow = new Preflow(graph, capacityMap);
+        
+        long best = long.MaxValue;
+        for (int i = 1; i < nodes.Count; i++)
+        {
+            best = Math.Min(best, preflow.Run(nodes[0], nodes[i]).MaxFlowValue);
+            best = Math.Min(best, preflow.Run(nodes[i], nodes[0]).MaxFlowValue);
+        }
+        return best;
+    }
+}
@@ -4,4 +4,12 @@ using BenchmarkDotNet.Running;
 var config = DefaultConfig.Instance
     .WithOptions(ConfigOptions.DisableOptimizationsValidator);
 
-BenchmarkRunner.Run<MaxFlowBenchmarks>(config);
\ No newline at end of file
+// Runs MaxFlowBenchmarks by default; pass --filter to pick other benchmark classes
+if (args.Length == 0)
+{
+    BenchmarkRunner.Run<MaxFlowBenchmarks>(config);
+}
+else
+{
+    BenchmarkSwitcher.FromAssembly(typeof(MaxFlowBenchmarks).Assembly).Run(args, config);
+}
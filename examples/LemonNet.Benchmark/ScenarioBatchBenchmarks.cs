@@ -0,0 +1,91 @@
+using BenchmarkDotNet.Attributes;
+using LemonNet;
+
+/// <summary>
+/// Max flow over a block of perturbed capacity vectors: one Preflow per scenario on
+/// a refilled ArcMap, against a parallel ScenarioBatch sweep.
+/// </summary>
+[MemoryDiagnoser]
+public class ScenarioBatchBenchmarks
+{
+    private LemonDigraph? graph;
+    private ArcMap? capacityMap;
+    private Node sourceNode;
+    private Node targetNode;
+    private Arc[] arcs = Array.Empty<Arc>();
+    private long[] capacities = Array.Empty<long>();
+    private long[] flowValues = Array.Empty<long>();
+
+    [Params(100, 500)]
+    public int ScenarioCount { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        // Random graph with 5,000 nodes and 40,000 arcs, capacities perturbed by up to ±20% per scenario
+        const int nodeCount = 5_000;
+        const int arcCount = 40_000;
+        var random = new Random(42); // Fixed seed for reproducibility
+
+        graph = new LemonDigraph();
+        var nodes = new Node[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            nodes[i] = graph.AddNode();
+        }
+
+        arcs = new Arc[arcCount];
+        var baseCapacities = new long[arcCount];
+        for (int i = 0; i < arcCount; i++)
+        {
+            arcs[i] = graph.AddArc(nodes[random.Next(nodeCount)], nodes[random.Next(nodeCount)]);
+            baseCapacities[i] = random.Next(100, 1001);
+        }
+
+        capacities = new long[ScenarioCount * arcCount];
+        for (int k = 0; k < ScenarioCount; k++)
+        {
+            for (int i = 0; i < arcCount; i++)
+            {
+                capacities[k * arcCount + i] = baseCapacities[i] * random.Next(80, 121) / 100;
+            }
+        }
+
+        capacityMap = new ArcMap(graph);
+        flowValues = new long[ScenarioCount];
+        sourceNode = nodes[0];
+        targetNode = nodes[nodeCount - 1];
+
+        Console.WriteLine($"Created random graph with {graph.NodeCount} nodes and {graph.ArcCount} arcs, {ScenarioCount} scenarios");
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        capacityMap?.Dispose();
+        graph?.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public long BenchmarkSequentialPreflow()
+    {
+        long total = 0;
+        using var preflow = new Preflow(graph!, capacityMap!);
+        for (int k = 0; k < ScenarioCount; k++)
+        {
+            for (int i = 0; i < arcs.Length; i++)
+            {
+                capacityMap![arcs[i]] = capacities[k * arcs.Length + i];
+            }
+            total += preflow.Run(sourceNode, targetNode).MaxFlowValue;
+        }
+        return total;
+    }
+
+    [Benchmark]
+    public long BenchmarkScenarioBatch()
+    {
+        ScenarioBatch.Run(graph!, ScenarioAlgorithm.Preflow, sourceNode, targetNode, capacities, flowValues);
+        return flowValues.Sum();
+    }
+}
@@ -0,0 +1,75 @@
+using BenchmarkDotNet.Attributes;
+using LemonNet;
+
+/// <summary>
+/// Strong-scaling benchmark for the parallel delta-stepping engine against
+/// a full-tree Dijkstra run on the same random graph.
+/// </summary>
+[MemoryDiagnoser]
+public class ShortestPathBenchmarks
+{
+    private LemonDigraph? graph;
+    private ArcMapDouble? lengthMap;
+    private Node sourceNode;
+    private Node isolatedNode;
+    private double[] distances = Array.Empty<double>();
+    private int[] predecessors = Array.Empty<int>();
+
+    [Params(1, 2, 4, 8, 16, 32)]
+    public int ThreadCount { get; set; }
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        // Random graph with 200,000 nodes and 2,000,000 arcs, lengths 1-1000
+        const int nodeCount = 200_000;
+        const int arcCount = 2_000_000;
+        var random = new Random(42); // Fixed seed for reproducibility
+
+        graph = new LemonDigraph();
+        var nodes = new Node[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            nodes[i] = graph.AddNode();
+        }
+
+        lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < arcCount; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodeCount)], nodes[random.Next(nodeCount)]);
+            lengthMap[arc] = random.Next(1, 1001);
+        }
+
+        sourceNode = nodes[0];
+
+        // Dijkstra stops at its target, so aim it at an unreachable node to
+        // make it build the full tree like delta-stepping does
+        isolatedNode = graph.AddNode();
+
+        distances = new double[graph.NodeCount];
+        predecessors = new int[graph.NodeCount];
+
+        Console.WriteLine($"Created random graph with {graph.NodeCount} nodes and {graph.ArcCount} arcs");
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        lengthMap?.Dispose();
+        graph?.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public double BenchmarkDijkstraFullTree()
+    {
+        using var dijkstra = new Dijkstra(graph!, lengthMap!);
+        return dijkstra.FindDistance(sourceNode, isolatedNode);
+    }
+
+    [Benchmark]
+    public int BenchmarkDeltaStepping()
+    {
+        using var deltaStepping = new DeltaStepping(graph!, lengthMap!) { ThreadCount = ThreadCount };
+        return deltaStepping.Run(sourceNode, distances, predecessors);
+    }
+}
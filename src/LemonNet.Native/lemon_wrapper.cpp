@@ -5,13 +5,46 @@
 #include <lemon/preflow.h>
 #include <lemon/dijkstra.h>
 #include <lemon/bellman_ford.h>
+#include <lemon/bin_heap.h>
+#include <lemon/radix_heap.h>
+#include <lemon/bucket_heap.h>
 #include <lemon/path.h>
+#include <lemon/adaptors.h>
+#include <lemon/bfs.h>
+#include <lemon/dfs.h>
+#include <lemon/suurballe.h>
+#include <lemon/hao_orlin.h>
+#include <lemon/nagamochi_ibaraki.h>
+#include <lemon/matching.h>
 #include <lemon/tolerance.h>
+#include <lemon/radix_sort.h>
+#include <lemon/connectivity.h>
 #include <vector>
+#include <memory>
+#include <cstdint>
+#include <algorithm>
 #include <map>
+#include <set>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <climits>
+#include <cmath>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define LEMON_WRAPPER_AVX2
+    #define LEMON_WRAPPER_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+    #include <immintrin.h>
+    #include <intrin.h>
+    #define LEMON_WRAPPER_AVX2
+    #define LEMON_WRAPPER_TARGET_AVX2
+#endif
 
 using namespace lemon;
 
@@ -27,10 +60,32 @@ namespace lemon {
     const Invalid INVALID = Invalid();
 }
 
+// Compressed sparse row view of a digraph, used by the engines that stream
+// over adjacency arrays instead of walking SmartDigraph's linked lists.
+struct CsrGraph {
+    int node_count;
+    int arc_count;
+    std::vector<int> out_begin;   // node_count + 1 offsets into out_arc
+    std::vector<int> out_arc;     // arc ids grouped by source node
+    std::vector<int> out_target;  // target node of each out_arc entry
+
+    // In-adjacency, only filled when requested from get_csr()
+    bool has_in;
+    std::vector<int> in_begin;    // node_count + 1 offsets into in_arc
+    std::vector<int> in_arc;      // arc ids grouped by target node
+    std::vector<int> in_source;   // source node of each in_arc entry
+
+    CsrGraph() : node_count(-1), arc_count(-1), has_in(false) {}
+};
+
 struct GraphWrapper { 
     SmartDigraph graph;
     std::vector<SmartDigraph::Node> nodes;
     std::vector<SmartDigraph::Arc> arcs;
+
+    // Built lazily by get_csr() and rebuilt once nodes or arcs were added
+    CsrGraph csr;
+    std::mutex csr_mutex;
     
     GraphWrapper() {
     }
@@ -84,10 +139,85 @@ struct NodeMapWrapper {
     }
 };
 
-// Template function for running max flow algorithms
-template<typename Algorithm>
+// Undirected graph. Node and edge ids are the SmartGraph ids, which equal the
+// indices into nodes and edges.
+struct UGraphWrapper {
+    SmartGraph graph;
+    std::vector<SmartGraph::Node> nodes;
+    std::vector<SmartGraph::Edge> edges;
+};
+
+struct EdgeMapWrapper {
+    union {
+        SmartGraph::EdgeMap<long>* long_map;
+        SmartGraph::EdgeMap<double>* double_map;
+    };
+    MapType type;
+    UGraphWrapper* graph_wrapper;
+
+    EdgeMapWrapper(UGraphWrapper* gw, MapType t) : type(t), graph_wrapper(gw) {
+        if (type == MapType::LONG) {
+            long_map = new SmartGraph::EdgeMap<long>(gw->graph);
+        } else {
+            double_map = new SmartGraph::EdgeMap<double>(gw->graph);
+        }
+    }
+
+    ~EdgeMapWrapper() {
+        if (type == MapType::LONG) {
+            delete long_map;
+        } else {
+            delete double_map;
+        }
+    }
+};
+
+// Read-only bool map over a caller bitset of 64-bit words indexed by item id,
+// the filter of MaskedDigraph. A null bitset enables every item.
+template <typename Item>
+class BitMaskMap {
+public:
+    typedef Item Key;
+    typedef bool Value;
+
+    explicit BitMaskMap(const unsigned long long* words) : _words(words) {}
+
+    Value operator[](const Key& item) const {
+        if (!_words) return true;
+        int id = SmartDigraph::id(item);
+        return (_words[id >> 6] >> (id & 63)) & 1;
+    }
+
+private:
+    const unsigned long long* _words;
+};
+
+// Graph view with the masked-out nodes and arcs hidden, so one graph serves
+// many failure scenarios without being rebuilt
+typedef SubDigraph<const SmartDigraph, BitMaskMap<SmartDigraph::Node>,
+                   BitMaskMap<SmartDigraph::Arc> > MaskedDigraph;
+
+// Hands the flows over as a malloc'ed FlowResult array (null if empty)
+static bool store_flow_results(const std::vector<FlowResult>& results,
+                               FlowResult** flow_results, int* flow_count) {
+    *flow_count = 0;
+    *flow_results = nullptr;
+    if (results.empty()) return true;
+
+    *flow_results = static_cast<FlowResult*>(malloc(sizeof(FlowResult) * results.size()));
+    if (!*flow_results) return false;
+    memcpy(*flow_results, results.data(), sizeof(FlowResult) * results.size());
+    *flow_count = static_cast<int>(results.size());
+    return true;
+}
+
+// Template function for running max flow algorithms. Algorithm runs on the
+// whole graph, MaskedAlgorithm on the MaskedDigraph view when a mask is given.
+template<typename Algorithm, typename MaskedAlgorithm>
 static long long run_max_flow_algorithm(LemonGraph graph, LemonArcMap capacity_map,
                                         int source, int target,
+                                        const unsigned long long* arc_mask,
+                                        const unsigned long long* node_mask,
                                         FlowResult** flow_results, int* flow_count) {
     if (!graph || !capacity_map || !flow_results || !flow_count) return -1;
     
@@ -107,422 +237,5677 @@ static long long run_max_flow_algorithm(LemonGraph graph, LemonArcMap capacity_m
         return -1;
     }
     
-    SmartDigraph::ArcMap<long> flow_map(graph_wrapper->graph);
-    Algorithm alg(graph_wrapper->graph, *(capacity_wrapper->long_map),
-                  graph_wrapper->nodes[source], graph_wrapper->nodes[target]);
-    alg.flowMap(flow_map);
-    
-    alg.run();
-    
-    long long max_flow = alg.flowValue();
-    
+    const SmartDigraph& g = graph_wrapper->graph;
+    long long max_flow = 0;
     std::vector<FlowResult> results;
-    
-    for (size_t i = 0; i < graph_wrapper->arcs.size(); ++i) {
-        long long flow = flow_map[graph_wrapper->arcs[i]];
-        if (flow > 0) {
-            FlowResult result;
-            result.arc_id = static_cast<int>(i);
-            result.flow = flow;
-            results.push_back(result);
+
+    if (!arc_mask && !node_mask) {
+        SmartDigraph::ArcMap<long> flow_map(g);
+        Algorithm alg(g, *(capacity_wrapper->long_map),
+                      graph_wrapper->nodes[source], graph_wrapper->nodes[target]);
+        alg.flowMap(flow_map);
+
+        alg.run();
+
+        max_flow = alg.flowValue();
+
+        for (size_t i = 0; i < graph_wrapper->arcs.size(); ++i) {
+            long long flow = flow_map[graph_wrapper->arcs[i]];
+            if (flow > 0) {
+                FlowResult result;
+                result.arc_id = static_cast<int>(i);
+                result.flow = flow;
+                results.push_back(result);
+            }
         }
-    }
-    
-    if (results.empty()) {
-        *flow_count = 0;
-        *flow_results = nullptr;
     } else {
-        *flow_count = static_cast<int>(results.size());
-        *flow_results = static_cast<FlowResult*>(malloc(sizeof(FlowResult) * results.size()));
-        if (*flow_results) {
-            memcpy(*flow_results, results.data(), sizeof(FlowResult) * results.size());
-        } else {
-            *flow_count = 0;
-            return -1;
+        BitMaskMap<SmartDigraph::Node> node_filter(node_mask);
+        BitMaskMap<SmartDigraph::Arc> arc_filter(arc_mask);
+        SmartDigraph::Node s = graph_wrapper->nodes[source];
+        SmartDigraph::Node t = graph_wrapper->nodes[target];
+
+        // The view hides arcs into disabled nodes but not out of them,
+        // so a disabled terminal is handled here
+        if (node_filter[s] && node_filter[t]) {
+            MaskedDigraph masked(g, node_filter, arc_filter);
+            MaskedAlgorithm alg(masked, *(capacity_wrapper->long_map), s, t);
+
+            alg.run();
+
+            max_flow = alg.flowValue();
+
+            for (size_t i = 0; i < graph_wrapper->arcs.size(); ++i) {
+                SmartDigraph::Arc arc = graph_wrapper->arcs[i];
+                if (!arc_filter[arc] || !node_filter[g.source(arc)] || !node_filter[g.target(arc)]) continue;
+                long long flow = alg.flow(arc);
+                if (flow > 0) {
+                    FlowResult result;
+                    result.arc_id = static_cast<int>(i);
+                    result.flow = flow;
+                    results.push_back(result);
+                }
+            }
         }
     }
     
+    if (!store_flow_results(results, flow_results, flow_count)) return -1;
+    
     return max_flow;
 }
 
-extern "C" {
+// Converts a LEMON path into a malloc'ed PathResult. SmartDigraph arc ids
+// coincide with the wrapper's arc indices, so no lookup is needed.
+static PathResult* create_path_result(const Path<SmartDigraph>& path) {
+    PathResult* result = static_cast<PathResult*>(malloc(sizeof(PathResult)));
+    if (!result) return nullptr;
 
-LEMON_API LemonGraph lemon_create_graph() {
-    return new GraphWrapper();
-}
+    result->count = path.length();
+    result->arc_ids = nullptr;
 
-LEMON_API void lemon_destroy_graph(LemonGraph graph) {
-    if (graph) {
-        delete static_cast<GraphWrapper*>(graph);
+    if (result->count > 0) {
+        result->arc_ids = static_cast<int*>(malloc(sizeof(int) * result->count));
+        if (!result->arc_ids) {
+            free(result);
+            return nullptr;
+        }
+
+        int i = 0;
+        for (Path<SmartDigraph>::ArcIt it(path); it != INVALID; ++it) {
+            result->arc_ids[i++] = SmartDigraph::id(it);
+        }
     }
-}
 
-LEMON_API int lemon_add_node(LemonGraph graph) {
-    if (!graph) return -1;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    SmartDigraph::Node node = wrapper->graph.addNode();
-    wrapper->nodes.push_back(node);
-    return static_cast<int>(wrapper->nodes.size() - 1);
+    return result;
 }
 
-LEMON_API int lemon_add_arc(LemonGraph graph, int source, int target) {
-    if (!graph) return -1;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    
-    if (source < 0 || source >= static_cast<int>(wrapper->nodes.size()) ||
-        target < 0 || target >= static_cast<int>(wrapper->nodes.size())) {
-        return -1;
-    }
-    
-    SmartDigraph::Arc arc = wrapper->graph.addArc(
-        wrapper->nodes[source], 
-        wrapper->nodes[target]
-    );
-    wrapper->arcs.push_back(arc);
-    return static_cast<int>(wrapper->arcs.size() - 1);
-}
+// Runs Dijkstra over a long length map with the given integer heap and
+// fills an integer shortest path result.
+template<typename Heap>
+static ShortestPathResultLong* run_dijkstra_long(GraphWrapper* graph_wrapper,
+                                                 SmartDigraph::ArcMap<long>& lengths,
+                                                 int source, int target) {
+    typedef typename Dijkstra<SmartDigraph, SmartDigraph::ArcMap<long> >
+        ::template SetStandardHeap<Heap>::Create DijkstraAlg;
+    DijkstraAlg dijkstra(graph_wrapper->graph, lengths);
 
-LEMON_API int lemon_arc_source(LemonGraph graph, int arc_id) {
-    if (!graph) return -1;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    
-    if (arc_id < 0 || arc_id >= static_cast<int>(wrapper->arcs.size())) {
-        return -1;
-    }
-    
-    SmartDigraph::Node source = wrapper->graph.source(wrapper->arcs[arc_id]);
-    
-    // Find the node index
-    for (size_t i = 0; i < wrapper->nodes.size(); ++i) {
-        if (wrapper->nodes[i] == source) {
-            return static_cast<int>(i);
-        }
+    SmartDigraph::Node t = graph_wrapper->nodes[target];
+    dijkstra.run(graph_wrapper->nodes[source], t);
+
+    ShortestPathResultLong* result = static_cast<ShortestPathResultLong*>(malloc(sizeof(ShortestPathResultLong)));
+    if (!result) return nullptr;
+
+    result->reached = dijkstra.reached(t) ? 1 : 0;
+    result->negative_cycle = 0;
+
+    if (result->reached) {
+        result->distance = dijkstra.dist(t);
+        result->path = create_path_result(dijkstra.path(t));
+    } else {
+        result->distance = std::numeric_limits<long long>::max();
+        result->path = nullptr;
     }
-    
-    return -1;
+
+    return result;
 }
 
-LEMON_API int lemon_arc_target(LemonGraph graph, int arc_id) {
-    if (!graph) return -1;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    
-    if (arc_id < 0 || arc_id >= static_cast<int>(wrapper->arcs.size())) {
-        return -1;
+// Groups the arc ids by one endpoint (counting sort). key_of_arc and
+// other_of_arc give the grouping node and the opposite node of each arc.
+static void build_adjacency(int node_count, const std::vector<int>& key_of_arc,
+                            const std::vector<int>& other_of_arc,
+                            std::vector<int>& begin, std::vector<int>& arc_ids,
+                            std::vector<int>& other) {
+    int arc_count = static_cast<int>(key_of_arc.size());
+
+    begin.assign(node_count + 1, 0);
+    arc_ids.resize(arc_count);
+    other.resize(arc_count);
+
+    for (int a = 0; a < arc_count; ++a) {
+        ++begin[key_of_arc[a] + 1];
     }
-    
-    SmartDigraph::Node target = wrapper->graph.target(wrapper->arcs[arc_id]);
-    
-    // Find the node index
-    for (size_t i = 0; i < wrapper->nodes.size(); ++i) {
-        if (wrapper->nodes[i] == target) {
-            return static_cast<int>(i);
-        }
+    for (int v = 0; v < node_count; ++v) {
+        begin[v + 1] += begin[v];
     }
-    
-    return -1;
-}
 
-LEMON_API int lemon_node_count(LemonGraph graph) {
-    if (!graph) return 0;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    return static_cast<int>(wrapper->nodes.size());
+    std::vector<int> next(begin.begin(), begin.end() - 1);
+    for (int a = 0; a < arc_count; ++a) {
+        int pos = next[key_of_arc[a]]++;
+        arc_ids[pos] = a;
+        other[pos] = other_of_arc[a];
+    }
 }
 
-LEMON_API int lemon_arc_count(LemonGraph graph) {
-    if (!graph) return 0;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    return static_cast<int>(wrapper->arcs.size());
-}
+// Returns the CSR view of the graph, rebuilding it if the graph has grown
+// since it was last built. Node and arc ids coincide with SmartDigraph ids.
+// The in-adjacency is only built when with_in is set.
+static const CsrGraph& get_csr(GraphWrapper* graph_wrapper, bool with_in = false) {
+    std::lock_guard<std::mutex> lock(graph_wrapper->csr_mutex);
 
-// Arc map operations - long values
-LEMON_API LemonArcMap lemon_create_arc_map_long(LemonGraph graph) {
-    if (!graph) return nullptr;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    return new ArcMapWrapper(wrapper, MapType::LONG);
-}
+    CsrGraph& csr = graph_wrapper->csr;
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    int arc_count = static_cast<int>(graph_wrapper->arcs.size());
 
-// Arc map operations - double values
-LEMON_API LemonArcMap lemon_create_arc_map_double(LemonGraph graph) {
-    if (!graph) return nullptr;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    return new ArcMapWrapper(wrapper, MapType::DOUBLE);
-}
+    bool current = csr.node_count == node_count && csr.arc_count == arc_count;
+    if (current && (csr.has_in || !with_in)) {
+        return csr;
+    }
 
-LEMON_API void lemon_destroy_arc_map(LemonArcMap map) {
-    if (map) {
-        delete static_cast<ArcMapWrapper*>(map);
+    const SmartDigraph& g = graph_wrapper->graph;
+    std::vector<int> sources(arc_count);
+    std::vector<int> targets(arc_count);
+    for (int a = 0; a < arc_count; ++a) {
+        sources[a] = g.id(g.source(graph_wrapper->arcs[a]));
+        targets[a] = g.id(g.target(graph_wrapper->arcs[a]));
     }
-}
 
-LEMON_API void lemon_set_arc_value_long(LemonArcMap map, int arc, long long value) {
-    if (!map) return;
-    
-    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
-    
-    if (wrapper->type != MapType::LONG) return;
-    
-    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
-        return;
+    if (!current) {
+        build_adjacency(node_count, sources, targets, csr.out_begin, csr.out_arc, csr.out_target);
+        csr.has_in = false;
+        csr.in_begin.clear();
+        csr.in_arc.clear();
+        csr.in_source.clear();
     }
-    
-    (*(wrapper->long_map))[wrapper->graph_wrapper->arcs[arc]] = value;
-}
 
-LEMON_API long long lemon_get_arc_value_long(LemonArcMap map, int arc) {
-    if (!map) return 0;
-    
-    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
-    
-    if (wrapper->type != MapType::LONG) return 0;
-    
-    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
-        return 0;
+    if (with_in) {
+        build_adjacency(node_count, targets, sources, csr.in_begin, csr.in_arc, csr.in_source);
+        csr.has_in = true;
     }
-    
-    return (*(wrapper->long_map))[wrapper->graph_wrapper->arcs[arc]];
+
+    csr.node_count = node_count;
+    csr.arc_count = arc_count;
+    return csr;
 }
 
-LEMON_API void lemon_set_arc_value_double(LemonArcMap map, int arc, double value) {
-    if (!map) return;
-    
-    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
-    
-    if (wrapper->type != MapType::DOUBLE) return;
-    
-    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
-        return;
-    }
-    
-    (*(wrapper->double_map))[wrapper->graph_wrapper->arcs[arc]] = value;
+static int resolve_thread_count(int requested) {
+    if (requested > 0) return requested;
+    unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
 }
 
-LEMON_API double lemon_get_arc_value_double(LemonArcMap map, int arc) {
-    if (!map) return 0.0;
-    
-    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
-    
-    if (wrapper->type != MapType::DOUBLE) return 0.0;
-    
-    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
-        return 0.0;
+// Runs body(thread_index) on thread_count threads, using the calling thread
+// as thread 0, and waits for all of them.
+template<typename Body>
+static void run_parallel(int thread_count, Body body) {
+    std::vector<std::thread> workers;
+    for (int t = 1; t < thread_count; ++t) {
+        workers.push_back(std::thread(body, t));
+    }
+    body(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
     }
-    
-    return (*(wrapper->double_map))[wrapper->graph_wrapper->arcs[arc]];
 }
 
-LEMON_API long long lemon_edmonds_karp(LemonGraph graph, LemonArcMap capacity_map,
-                                   int source, int target, 
-                                   FlowResult** flow_results, int* flow_count) {
-    typedef EdmondsKarp<SmartDigraph, SmartDigraph::ArcMap<long>> EK;
-    return run_max_flow_algorithm<EK>(graph, capacity_map, source, target, 
-                                      flow_results, flow_count);
-}
+// Reusable barrier for the fixed-size thread teams started by run_parallel()
+class ThreadBarrier {
+public:
+    explicit ThreadBarrier(int count) : _count(count), _waiting(0), _generation(0) {}
 
-LEMON_API void lemon_free_results(FlowResult* results) {
-    if (results) {
-        free(results);
+    void wait() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        int generation = _generation;
+        if (++_waiting == _count) {
+            _waiting = 0;
+            ++_generation;
+            _cv.notify_all();
+        } else {
+            while (generation == _generation) {
+                _cv.wait(lock);
+            }
+        }
     }
-}
 
-LEMON_API long long lemon_preflow(LemonGraph graph, LemonArcMap capacity_map,
-                              int source, int target,
-                              FlowResult** flow_results, int* flow_count) {
-    typedef Preflow<SmartDigraph, SmartDigraph::ArcMap<long>> PF;
-    return run_max_flow_algorithm<PF>(graph, capacity_map, source, target,
-                                      flow_results, flow_count);
-}
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int _count;
+    int _waiting;
+    int _generation;
+};
 
-// Node map operations
-LEMON_API LemonNodeMap lemon_create_node_map_double(LemonGraph graph) {
-    if (!graph) return nullptr;
-    
-    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
-    return new NodeMapWrapper(wrapper);
-}
+// Parallel delta-stepping (Meyer & Sanders) over the CSR view.
+//
+// Every node is owned by thread (node % thread_count), which alone keeps it
+// in its buckets and writes its dist/pred entries. Relaxations are written
+// to per-owner outboxes and applied by the owners after a barrier, so
+// dist and pred always stay consistent and no atomic min is required.
+// Each node's out-arcs are split into light (length <= delta) arcs, relaxed
+// repeatedly while its bucket is processed, and heavy arcs, relaxed once
+// when the bucket is settled.
+class DeltaStepping {
+public:
+    DeltaStepping(const CsrGraph& csr, const std::vector<double>& lengths,
+                  double delta, int thread_count)
+        : _csr(csr), _lengths(lengths), _delta(delta), _thread_count(thread_count),
+          _barrier(thread_count) {}
 
-LEMON_API void lemon_destroy_node_map(LemonNodeMap map) {
-    if (map) {
-        delete static_cast<NodeMapWrapper*>(map);
-    }
-}
+    void run(int source, double* dist, int* pred) {
+        int node_count = _csr.node_count;
+        _dist = dist;
+        _pred = pred;
 
-LEMON_API void lemon_set_node_value_double(LemonNodeMap map, int node, double value) {
-    if (!map) return;
-    
-    NodeMapWrapper* wrapper = static_cast<NodeMapWrapper*>(map);
+        _bucket_of.assign(node_count, NO_BUCKET);
+        _in_settled.assign(node_count, 0);
+        _light_end.resize(node_count);
+        _adj_target.resize(_csr.arc_count);
+        _adj_arc.resize(_csr.arc_count);
+        _adj_length.resize(_csr.arc_count);
+        _workers.assign(_thread_count, Worker());
+        _next_bucket.assign(_thread_count, NO_BUCKET);
+        _has_work.assign(_thread_count, 0);
+
+        for (int t = 0; t < _thread_count; ++t) {
+            _workers[t].outbox.resize(_thread_count);
+        }
+
+        for (int v = 0; v < node_count; ++v) {
+            dist[v] = std::numeric_limits<double>::infinity();
+            pred[v] = -1;
+        }
+
+        dist[source] = 0.0;
+        _bucket_of[source] = 0;
+        _workers[owner(source)].buckets[0].push_back(source);
+
+        run_parallel(_thread_count, [this](int t) { work(t); });
+    }
+
+private:
+    struct Relaxation {
+        int node;
+        int arc;
+        double dist;
+    };
+
+    struct Worker {
+        std::map<long long, std::vector<int> > buckets;
+        std::vector<int> settled;
+        std::vector<std::vector<Relaxation> > outbox;
+    };
+
+    static const long long NO_BUCKET = std::numeric_limits<long long>::max();
+
+    int owner(int node) const { return node % _thread_count; }
+
+    long long bucket_index(double d) const {
+        double index = std::floor(d / _delta);
+        return index < 9e18 ? static_cast<long long>(index) : 9000000000000000000LL;
+    }
+
+    void split_arcs(int t) {
+        int node_count = _csr.node_count;
+        int begin = static_cast<int>(static_cast<long long>(node_count) * t / _thread_count);
+        int end = static_cast<int>(static_cast<long long>(node_count) * (t + 1) / _thread_count);
+
+        for (int v = begin; v < end; ++v) {
+            int light = _csr.out_begin[v];
+            int heavy = _csr.out_begin[v + 1];
+            for (int i = _csr.out_begin[v]; i < _csr.out_begin[v + 1]; ++i) {
+                double length = _lengths[_csr.out_arc[i]];
+                int pos = length <= _delta ? light++ : --heavy;
+                _adj_target[pos] = _csr.out_target[i];
+                _adj_arc[pos] = _csr.out_arc[i];
+                _adj_length[pos] = length;
+            }
+            _light_end[v] = light;
+        }
+    }
+
+    void relax(Worker& worker, int v, int begin, int end) {
+        double d = _dist[v];
+        for (int i = begin; i < end; ++i) {
+            int target = _adj_target[i];
+            double nd = d + _adj_length[i];
+            if (nd < _dist[target]) {
+                Relaxation r = { target, _adj_arc[i], nd };
+                worker.outbox[owner(target)].push_back(r);
+            }
+        }
+    }
+
+    void apply(int t) {
+        Worker& worker = _workers[t];
+        for (int src = 0; src < _thread_count; ++src) {
+            std::vector<Relaxation>& inbox = _workers[src].outbox[t];
+            for (size_t i = 0; i < inbox.size(); ++i) {
+                const Relaxation& r = inbox[i];
+                if (r.dist < _dist[r.node]) {
+                    _dist[r.node] = r.dist;
+                    _pred[r.node] = r.arc;
+                    long long b = bucket_index(r.dist);
+                    if (_bucket_of[r.node] != b) {
+                        worker.buckets[b].push_back(r.node);
+                        _bucket_of[r.node] = b;
+                    }
+                }
+            }
+            inbox.clear();
+        }
+    }
+
+    void work(int t) {
+        Worker& worker = _workers[t];
+
+        split_arcs(t);
+        _barrier.wait();
+
+        while (true) {
+            _next_bucket[t] = worker.buckets.empty() ? NO_BUCKET : worker.buckets.begin()->first;
+            _barrier.wait();
+
+            long long current = NO_BUCKET;
+            for (int i = 0; i < _thread_count; ++i) {
+                if (_next_bucket[i] < current) current = _next_bucket[i];
+            }
+            if (current == NO_BUCKET) break;
+
+            // Light phases: repeat until no thread has nodes left in the bucket
+            while (true) {
+                std::map<long long, std::vector<int> >::iterator it = worker.buckets.find(current);
+                if (it != worker.buckets.end()) {
+                    std::vector<int> nodes;
+                    nodes.swap(it->second);
+                    worker.buckets.erase(it);
+
+                    for (size_t i = 0; i < nodes.size(); ++i) {
+                        int v = nodes[i];
+                        if (_bucket_of[v] != current) continue;
+                        _bucket_of[v] = NO_BUCKET;
+                        if (!_in_settled[v]) {
+                            _in_settled[v] = 1;
+                            worker.settled.push_back(v);
+                        }
+                        relax(worker, v, _csr.out_begin[v], _light_end[v]);
+                    }
+                }
+                _barrier.wait();
+
+                apply(t);
+                _has_work[t] = worker.buckets.count(current) ? 1 : 0;
+                _barrier.wait();
+
+                bool any = false;
+                for (int i = 0; i < _thread_count; ++i) {
+                    if (_has_work[i]) any = true;
+                }
+                if (!any) break;
+            }
+
+            // Heavy phase: the bucket is settled, relax its heavy arcs once
+            for (size_t i = 0; i < worker.settled.size(); ++i) {
+                int v = worker.settled[i];
+                _in_settled[v] = 0;
+                relax(worker, v, _light_end[v], _csr.out_begin[v + 1]);
+            }
+            worker.settled.clear();
+            _barrier.wait();
+
+            apply(t);
+        }
+    }
+
+    const CsrGraph& _csr;
+    const std::vector<double>& _lengths;
+    double _delta;
+    int _thread_count;
+    ThreadBarrier _barrier;
+
+    double* _dist;
+    int* _pred;
+    std::vector<long long> _bucket_of;
+    std::vector<char> _in_settled;
+    std::vector<int> _light_end;
+    std::vector<int> _adj_target;
+    std::vector<int> _adj_arc;
+    std::vector<double> _adj_length;
+    std::vector<Worker> _workers;
+    std::vector<long long> _next_bucket;
+    std::vector<char> _has_work;
+};
+
+const long long DeltaStepping::NO_BUCKET;
+
+// Searches the predecessor graph given by pred_node/pred_arc (-1 for roots)
+// for a cycle and stores its arcs in order. In a shortest path search with
+// strict improvements, any such cycle has negative length.
+static bool find_predecessor_cycle(const std::vector<int>& pred_node,
+                                   const std::vector<int>& pred_arc,
+                                   std::vector<int>& cycle) {
+    int node_count = static_cast<int>(pred_node.size());
+    std::vector<int> state(node_count, -1);
+
+    cycle.clear();
+    for (int start = 0; start < node_count; ++start) {
+        if (state[start] != -1) continue;
+        int v = start;
+        while (v >= 0 && state[v] == -1) {
+            state[v] = start;
+            v = pred_node[v];
+        }
+        if (v >= 0 && state[v] == start) {
+            int u = v;
+            do {
+                cycle.push_back(pred_arc[u]);
+                u = pred_node[u];
+            } while (u != v);
+            std::reverse(cycle.begin(), cycle.end());
+            return true;
+        }
+    }
+    return false;
+}
+
+// Queue-based Bellman-Ford (SPFA) over the CSR view.
+//
+// Only nodes whose distance changed are scanned, in FIFO order. A node is
+// skipped when its parent is still queued, since the parent's pending scan
+// will improve it again anyway. Every node_count relaxations the
+// predecessor graph is searched for a cycle (amortized O(1) per
+// relaxation); any such cycle is a negative cycle, which stops the search.
+class QueueBellmanFord {
+public:
+    QueueBellmanFord(const CsrGraph& csr, const std::vector<double>& lengths)
+        : _csr(csr), _lengths(lengths) {}
+
+    // Returns false if a negative cycle reachable from the source was found
+    bool run(int source) {
+        init();
+        _dist[source] = 0.0;
+        _queue[0] = source;
+        _queued[source] = 1;
+        return process(1);
+    }
+
+    // Runs from a virtual source joined to every node by a zero length arc,
+    // which yields feasible potentials. Returns false on any negative cycle.
+    bool runFromAll() {
+        init();
+        for (int v = 0; v < _csr.node_count; ++v) {
+            _dist[v] = 0.0;
+            _queue[v] = v;
+            _queued[v] = 1;
+        }
+        return process(_csr.node_count);
+    }
+
+    bool reached(int v) const { return _dist[v] != std::numeric_limits<double>::infinity(); }
+    double dist(int v) const { return _dist[v]; }
+
+    // Tree path arcs from the source to v, in order
+    std::vector<int> path(int v) const {
+        std::vector<int> arcs;
+        for (; _pred_arc[v] >= 0; v = _pred_node[v]) {
+            arcs.push_back(_pred_arc[v]);
+        }
+        return std::vector<int>(arcs.rbegin(), arcs.rend());
+    }
+
+    const std::vector<int>& cycle() const { return _cycle; }
+
+private:
+    void init() {
+        int node_count = _csr.node_count;
+
+        _dist.assign(node_count, std::numeric_limits<double>::infinity());
+        _pred_arc.assign(node_count, -1);
+        _pred_node.assign(node_count, -1);
+        _queued.assign(node_count, 0);
+        _queue.assign(node_count, 0);
+        _cycle.clear();
+    }
+
+    // Processes the queue, initially holding size nodes from index 0
+    bool process(int size) {
+        int node_count = _csr.node_count;
+        int head = 0;
+        int relaxations = 0;
+
+        while (size > 0) {
+            int u = _queue[head];
+            head = head + 1 == node_count ? 0 : head + 1;
+            --size;
+            _queued[u] = 0;
+
+            if (_pred_node[u] >= 0 && _queued[_pred_node[u]]) continue;
+
+            double du = _dist[u];
+            for (int i = _csr.out_begin[u]; i < _csr.out_begin[u + 1]; ++i) {
+                int arc = _csr.out_arc[i];
+                int v = _csr.out_target[i];
+                double nd = du + _lengths[arc];
+                if (nd < _dist[v]) {
+                    _dist[v] = nd;
+                    _pred_arc[v] = arc;
+                    _pred_node[v] = u;
+                    if (!_queued[v]) {
+                        int tail = head + size;
+                        _queue[tail >= node_count ? tail - node_count : tail] = v;
+                        _queued[v] = 1;
+                        ++size;
+                    }
+                    if (++relaxations >= node_count) {
+                        relaxations = 0;
+                        if (find_predecessor_cycle(_pred_node, _pred_arc, _cycle)) return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const CsrGraph& _csr;
+    const std::vector<double>& _lengths;
+    std::vector<double> _dist;
+    std::vector<int> _pred_arc;
+    std::vector<int> _pred_node;
+    std::vector<char> _queued;
+    std::vector<int> _queue;
+    std::vector<int> _cycle;
+};
+
+// Computes cand[i] = dist[source[i]] + length[i] for a block of arcs
+static void gather_candidates(const double* dist, const int* source, const double* length,
+                              int count, double* cand) {
+    for (int i = 0; i < count; ++i) {
+        cand[i] = dist[source[i]] + length[i];
+    }
+}
+
+#ifdef LEMON_WRAPPER_AVX2
+// AVX2 version of gather_candidates(), four arcs per gather
+LEMON_WRAPPER_TARGET_AVX2
+static void gather_candidates_avx2(const double* dist, const int* source, const double* length,
+                                   int count, double* cand) {
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m256d d = _mm256_i32gather_pd(dist, index, 8);
+        _mm256_storeu_pd(cand + i, _mm256_add_pd(d, _mm256_loadu_pd(length + i)));
+    }
+    for (; i < count; ++i) {
+        cand[i] = dist[source[i]] + length[i];
+    }
+}
+#endif
+
+static bool cpu_has_avx2() {
+#if defined(LEMON_WRAPPER_AVX2) && defined(__GNUC__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#elif defined(LEMON_WRAPPER_AVX2) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                        (_xgetbv(0) & 6) == 6;
+    if (!os_saves_ymm) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+// Edge-list Bellman-Ford over flat source/target/length arrays of the
+// in-adjacency (arcs sorted by target).
+//
+// Each round recomputes every distance from the previous round's values
+// (Jacobi style), so rounds are race free: the arcs are split into
+// contiguous target ranges of about equal size, one per thread, and each
+// thread only writes the distances and predecessors of its own targets.
+// Candidate distances are computed in blocks with AVX2 gathers when the
+// CPU supports them. The search stops at the first round without change,
+// or reports a negative cycle if distances still change in round n.
+class EdgeListBellmanFord {
+public:
+    EdgeListBellmanFord(const CsrGraph& csr, const std::vector<double>& lengths, int thread_count)
+        : _csr(csr), _lengths(lengths), _thread_count(thread_count), _barrier(thread_count) {}
+
+    // Returns false if a negative cycle reachable from the source was found
+    bool run(int source) {
+        int node_count = _csr.node_count;
+        int arc_count = _csr.arc_count;
+
+        _dist_a.assign(node_count, std::numeric_limits<double>::infinity());
+        _dist_b.assign(node_count, std::numeric_limits<double>::infinity());
+        _pred_arc.assign(node_count, -1);
+        _in_target.resize(arc_count);
+        _in_length.resize(arc_count);
+        _changed[0].assign(_thread_count, 0);
+        _changed[1].assign(_thread_count, 0);
+        _range_begin.resize(_thread_count + 1);
+        _dist_a[source] = 0.0;
+
+        // Balance the target ranges by arc count
+        for (int t = 0; t <= _thread_count; ++t) {
+            long long arcs_before = static_cast<long long>(arc_count) * t / _thread_count;
+            _range_begin[t] = static_cast<int>(
+                std::lower_bound(_csr.in_begin.begin(), _csr.in_begin.end() - 1, arcs_before)
+                - _csr.in_begin.begin());
+        }
+        _range_begin[_thread_count] = node_count;
+
+        _use_avx2 = cpu_has_avx2();
+        run_parallel(_thread_count, [this](int t) { work(t); });
+        return !_negative_cycle;
+    }
+
+    const std::vector<double>& dist() const { return *_dist; }
+    const std::vector<int>& pred_arc() const { return _pred_arc; }
+
+private:
+    static const int BLOCK_SIZE = 1024;
+
+    bool relax_round(int t, const double* cur, double* next, std::vector<double>& cand) {
+        int node_begin = _range_begin[t];
+        int node_end = _range_begin[t + 1];
+        int arc_begin = _csr.in_begin[node_begin];
+        int arc_end = _csr.in_begin[node_end];
+        bool changed = false;
+
+        for (int v = node_begin; v < node_end; ++v) {
+            next[v] = cur[v];
+        }
+
+        for (int block = arc_begin; block < arc_end; block += BLOCK_SIZE) {
+            int count = std::min(BLOCK_SIZE, arc_end - block);
+#ifdef LEMON_WRAPPER_AVX2
+            if (_use_avx2) {
+                gather_candidates_avx2(cur, &_csr.in_source[block], &_in_length[block], count, &cand[0]);
+            } else
+#endif
+            {
+                gather_candidates(cur, &_csr.in_source[block], &_in_length[block], count, &cand[0]);
+            }
+
+            for (int i = 0; i < count; ++i) {
+                int v = _in_target[block + i];
+                if (cand[i] < next[v]) {
+                    next[v] = cand[i];
+                    _pred_arc[v] = _csr.in_arc[block + i];
+                    changed = true;
+                }
+            }
+        }
+
+        return changed;
+    }
+
+    void work(int t) {
+        int node_count = _csr.node_count;
+
+        // Flat target/length arrays for this thread's arc range
+        for (int v = _range_begin[t]; v < _range_begin[t + 1]; ++v) {
+            for (int i = _csr.in_begin[v]; i < _csr.in_begin[v + 1]; ++i) {
+                _in_target[i] = v;
+                _in_length[i] = _lengths[_csr.in_arc[i]];
+            }
+        }
+        _barrier.wait();
+
+        std::vector<double> cand(BLOCK_SIZE);
+        double* cur = &_dist_a[0];
+        double* next = &_dist_b[0];
+        bool negative_cycle = false;
+
+        for (int round = 1; ; ++round) {
+            _changed[round & 1][t] = relax_round(t, cur, next, cand) ? 1 : 0;
+            _barrier.wait();
+            std::swap(cur, next);
+
+            bool any = false;
+            for (int i = 0; i < _thread_count; ++i) {
+                if (_changed[round & 1][i]) any = true;
+            }
+            if (!any) break;
+            if (round >= node_count) {
+                negative_cycle = true;
+                break;
+            }
+        }
+
+        if (t == 0) {
+            _dist = cur == &_dist_a[0] ? &_dist_a : &_dist_b;
+            _negative_cycle = negative_cycle;
+        }
+    }
+
+    const CsrGraph& _csr;
+    const std::vector<double>& _lengths;
+    int _thread_count;
+    ThreadBarrier _barrier;
+    bool _use_avx2;
+    bool _negative_cycle;
+
+    std::vector<double> _dist_a;
+    std::vector<double> _dist_b;
+    const std::vector<double>* _dist;
+    std::vector<int> _pred_arc;
+    std::vector<int> _in_target;
+    std::vector<double> _in_length;
+    std::vector<char> _changed[2];
+    std::vector<int> _range_begin;
+};
+
+// Arc lengths reduced by node potentials, l(uv) + p(u) - p(v), computed on
+// access so Johnson never materializes a reweighted copy per thread
+class ReducedLengthMap {
+public:
+    typedef SmartDigraph::Arc Key;
+    typedef double Value;
+
+    ReducedLengthMap(const SmartDigraph& graph, const std::vector<double>& lengths,
+                     const double* potentials)
+        : _graph(graph), _lengths(lengths), _potentials(potentials) {}
+
+    Value operator[](const Key& arc) const {
+        return _lengths[SmartDigraph::id(arc)]
+             + _potentials[SmartDigraph::id(_graph.source(arc))]
+             - _potentials[SmartDigraph::id(_graph.target(arc))];
+    }
+
+private:
+    const SmartDigraph& _graph;
+    const std::vector<double>& _lengths;
+    const double* _potentials;
+};
+
+// Yen's K shortest simple paths.
+//
+// One Dijkstra from the target over the reversed graph gives the exact
+// distance to the target from every node. It yields the first path directly
+// and serves as a potential for the spur searches: with lengths reduced by
+// it, Dijkstra runs goal directed (A*) and stops as soon as the target is
+// settled, and root cost plus distance to the target is a lower bound that
+// skips spur nodes which cannot produce one of the remaining paths.
+// Spur searches run on a SubDigraph whose node and arc masks are toggled and
+// restored around each search, so the graph is never copied and a single
+// Dijkstra instance is reused for all of them.
+class YenKShortestPaths {
+public:
+    typedef SubDigraph<const SmartDigraph, SmartDigraph::NodeMap<bool>,
+                       SmartDigraph::ArcMap<bool> > MaskedDigraph;
+
+    YenKShortestPaths(const SmartDigraph& graph, const SmartDigraph::ArcMap<double>& length_map,
+                      const std::vector<double>& lengths)
+        : _graph(graph), _length_map(length_map), _lengths(lengths),
+          _potentials(std::max(countNodes(graph), 1), 0.0),
+          _node_enabled(graph, true), _arc_enabled(graph, true),
+          _masked(graph, _node_enabled, _arc_enabled),
+          _reduced(graph, lengths, &_potentials[0]),
+          _dijkstra(_masked, _reduced) {}
+
+    void run(int source, int target, int k) {
+        typedef ReverseDigraph<const SmartDigraph> ReversedDigraph;
+
+        _paths.clear();
+        _costs.clear();
+
+        SmartDigraph::Node s = _graph.nodeFromId(source);
+        SmartDigraph::Node t = _graph.nodeFromId(target);
+
+        ReversedDigraph reversed(_graph);
+        Dijkstra<ReversedDigraph, SmartDigraph::ArcMap<double> > to_target(reversed, _length_map);
+        to_target.run(t);
+        if (!to_target.reached(s)) return;
+
+        // Nodes that cannot reach the target never lie on a path
+        for (SmartDigraph::NodeIt n(_graph); n != INVALID; ++n) {
+            bool reached = to_target.reached(n);
+            _potentials[SmartDigraph::id(n)] = reached ? -to_target.dist(n) : 0.0;
+            _node_enabled[n] = reached;
+        }
+
+        std::vector<int> first;
+        for (SmartDigraph::Node v = s; v != t; ) {
+            SmartDigraph::Arc arc = to_target.predArc(v);
+            first.push_back(SmartDigraph::id(arc));
+            v = _graph.target(arc);
+        }
+
+        std::multimap<double, std::vector<int> > candidates;
+        std::set<std::vector<int> > known;
+        known.insert(first);
+        _paths.push_back(first);
+        _costs.push_back(cost(first));
+
+        std::vector<SmartDigraph::Node> disabled_nodes;
+        std::vector<SmartDigraph::Arc> disabled_arcs;
+
+        while (static_cast<int>(_paths.size()) < k) {
+            const std::vector<int> previous = _paths.back();
+            size_t needed = k - _paths.size();
+            double root_cost = 0.0;
+            SmartDigraph::Node spur = s;
+
+            for (size_t i = 0; i < previous.size(); ++i) {
+                SmartDigraph::Arc next_arc = _graph.arcFromId(previous[i]);
+
+                // Enough candidates at least as short as anything from this spur
+                double bound = root_cost - _potentials[SmartDigraph::id(spur)];
+                bool skip = false;
+                if (candidates.size() >= needed) {
+                    std::multimap<double, std::vector<int> >::const_iterator it = candidates.begin();
+                    std::advance(it, needed - 1);
+                    skip = it->first <= bound;
+                }
+
+                if (!skip) {
+                    // Mask the root path and the arcs leaving the spur node on
+                    // known paths that share this root
+                    for (size_t j = 0; j < i; ++j) {
+                        SmartDigraph::Node root_node = _graph.source(_graph.arcFromId(previous[j]));
+                        if (_node_enabled[root_node]) {
+                            _node_enabled[root_node] = false;
+                            disabled_nodes.push_back(root_node);
+                        }
+                    }
+                    for (size_t p = 0; p < _paths.size(); ++p) {
+                        const std::vector<int>& path = _paths[p];
+                        if (path.size() > i && std::equal(previous.begin(), previous.begin() + i, path.begin())) {
+                            SmartDigraph::Arc arc = _graph.arcFromId(path[i]);
+                            if (_arc_enabled[arc]) {
+                                _arc_enabled[arc] = false;
+                                disabled_arcs.push_back(arc);
+                            }
+                        }
+                    }
+
+                    _dijkstra.init();
+                    _dijkstra.addSource(spur);
+                    _dijkstra.start(t);
+
+                    if (_dijkstra.reached(t)) {
+                        std::vector<int> spur_path;
+                        for (SmartDigraph::Node v = t; v != spur; ) {
+                            SmartDigraph::Arc arc = _dijkstra.predArc(v);
+                            spur_path.push_back(SmartDigraph::id(arc));
+                            v = _graph.source(arc);
+                        }
+
+                        std::vector<int> candidate(previous.begin(), previous.begin() + i);
+                        candidate.insert(candidate.end(), spur_path.rbegin(), spur_path.rend());
+                        if (known.insert(candidate).second) {
+                            candidates.insert(std::make_pair(cost(candidate), candidate));
+                        }
+                    }
+
+                    for (size_t j = 0; j < disabled_nodes.size(); ++j) _node_enabled[disabled_nodes[j]] = true;
+                    for (size_t j = 0; j < disabled_arcs.size(); ++j) _arc_enabled[disabled_arcs[j]] = true;
+                    disabled_nodes.clear();
+                    disabled_arcs.clear();
+                }
+
+                root_cost += _lengths[previous[i]];
+                spur = _graph.target(next_arc);
+            }
+
+            if (candidates.empty()) break;
+
+            _paths.push_back(candidates.begin()->second);
+            _costs.push_back(candidates.begin()->first);
+            candidates.erase(candidates.begin());
+        }
+    }
+
+    const std::vector<std::vector<int> >& paths() const { return _paths; }
+    const std::vector<double>& costs() const { return _costs; }
+
+private:
+    double cost(const std::vector<int>& arcs) const {
+        double total = 0.0;
+        for (size_t i = 0; i < arcs.size(); ++i) total += _lengths[arcs[i]];
+        return total;
+    }
+
+    const SmartDigraph& _graph;
+    const SmartDigraph::ArcMap<double>& _length_map;
+    const std::vector<double>& _lengths;
+    std::vector<double> _potentials;
+    SmartDigraph::NodeMap<bool> _node_enabled;
+    SmartDigraph::ArcMap<bool> _arc_enabled;
+    MaskedDigraph _masked;
+    ReducedLengthMap _reduced;
+    Dijkstra<MaskedDigraph, ReducedLengthMap> _dijkstra;
+    std::vector<std::vector<int> > _paths;
+    std::vector<double> _costs;
+};
+
+static int original_arc_id(const SmartDigraph::Arc& arc) {
+    return SmartDigraph::id(arc);
+}
+
+// Arcs of the split graph map back to original arcs; the in/out bind arcs
+// have no counterpart (-1)
+static int original_arc_id(const SplitNodes<SmartDigraph>::Arc& arc) {
+    return SplitNodes<SmartDigraph>::origArc(arc) ? SmartDigraph::id(static_cast<SmartDigraph::Arc>(arc)) : -1;
+}
+
+// Persistent Suurballe state for repeated disjoint path queries.
+//
+// Lengths are copied when the handle is created. Arc-disjoint queries run on
+// the graph itself; node-disjoint queries run on SplitNodes, where every node
+// becomes an in/out pair joined by a zero length bind arc, so that paths
+// sharing no arc of the split graph share no inner node of the original.
+// The initial full Dijkstra is kept for further queries from the same source.
+struct SuurballeWrapper {
+    typedef SplitNodes<SmartDigraph> SplitDigraph;
+    typedef ConstMap<SmartDigraph::Node, double> ZeroNodeMap;
+    typedef SplitDigraph::CombinedArcMap<const SmartDigraph::ArcMap<double>, const ZeroNodeMap> SplitLengthMap;
+
+    GraphWrapper* graph_wrapper;
+    int disjoint;
+    int node_count;
+    int arc_count;
+    SmartDigraph::ArcMap<double> lengths;
+    SplitDigraph split;
+    ZeroNodeMap zero;
+    SplitLengthMap split_lengths;
+    Suurballe<SmartDigraph, SmartDigraph::ArcMap<double> > arc_suurballe;
+    Suurballe<SplitDigraph, SplitLengthMap> node_suurballe;
+    int cached_source;
+    std::vector<char> reachable;
+
+    SuurballeWrapper(GraphWrapper* gw, const SmartDigraph::ArcMap<double>& length_values, int mode)
+        : graph_wrapper(gw), disjoint(mode),
+          node_count(static_cast<int>(gw->nodes.size())), arc_count(static_cast<int>(gw->arcs.size())),
+          lengths(gw->graph), split(gw->graph), zero(0.0), split_lengths(lengths, zero),
+          arc_suurballe(gw->graph, lengths), node_suurballe(split, split_lengths),
+          cached_source(-1) {
+        mapCopy(gw->graph, length_values, lengths);
+    }
+
+    // Returns the number of paths found, or -1 if arc_capacity is too small
+    int run(int source, int target, int k, double* total_length,
+            int* path_offsets, int* arc_ids, int arc_capacity) {
+        if (source != cached_source) {
+            SmartDigraph::Node s = graph_wrapper->nodes[source];
+
+            Bfs<SmartDigraph> bfs(graph_wrapper->graph);
+            bfs.run(s);
+            reachable.assign(node_count, 0);
+            for (int v = 0; v < node_count; ++v) {
+                reachable[v] = bfs.reached(graph_wrapper->nodes[v]) ? 1 : 0;
+            }
+
+            if (disjoint == LEMON_DISJOINT_NODES) {
+                node_suurballe.fullInit(split.outNode(s));
+            } else {
+                arc_suurballe.fullInit(s);
+            }
+            cached_source = source;
+        }
+
+        *total_length = 0.0;
+        path_offsets[0] = 0;
+        // The cached initial path would be empty for an unreachable target
+        if (k == 0 || !reachable[target]) return 0;
+
+        SmartDigraph::Node t = graph_wrapper->nodes[target];
+        if (disjoint == LEMON_DISJOINT_NODES) {
+            node_suurballe.start(split.inNode(t), k);
+            return copyPaths(node_suurballe, total_length, path_offsets, arc_ids, arc_capacity);
+        }
+        arc_suurballe.start(t, k);
+        return copyPaths(arc_suurballe, total_length, path_offsets, arc_ids, arc_capacity);
+    }
+
+private:
+    template<typename Alg>
+    static int copyPaths(const Alg& alg, double* total_length,
+                         int* path_offsets, int* arc_ids, int arc_capacity) {
+        int offset = 0;
+        for (int i = 0; i < alg.pathNum(); ++i) {
+            path_offsets[i] = offset;
+            for (typename Alg::Path::ArcIt it(alg.path(i)); it != INVALID; ++it) {
+                int arc = original_arc_id(it);
+                if (arc < 0) continue;
+                if (offset >= arc_capacity) return -1;
+                arc_ids[offset++] = arc;
+            }
+        }
+        path_offsets[alg.pathNum()] = offset;
+        *total_length = alg.totalLength();
+        return alg.pathNum();
+    }
+};
+
+// Copies a digraph into an undirected SmartGraph with one edge per arc and the
+// same node and edge ids. Returns false if a capacity is negative.
+static bool build_undirected_network(GraphWrapper* graph_wrapper, ArcMapWrapper* capacity_wrapper,
+                                     SmartGraph& undirected, SmartGraph::EdgeMap<long>& capacity) {
+    const SmartDigraph& g = graph_wrapper->graph;
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+
+    undirected.reserveNode(node_count);
+    undirected.reserveEdge(static_cast<int>(graph_wrapper->arcs.size()));
+    for (int v = 0; v < node_count; ++v) undirected.addNode();
+
+    for (size_t a = 0; a < graph_wrapper->arcs.size(); ++a) {
+        SmartDigraph::Arc arc = graph_wrapper->arcs[a];
+        long value = (*(capacity_wrapper->long_map))[arc];
+        if (value < 0) return false;
+
+        SmartGraph::Edge edge = undirected.addEdge(undirected.nodeFromId(g.id(g.source(arc))),
+                                                   undirected.nodeFromId(g.id(g.target(arc))));
+        capacity[edge] = value;
+    }
+    return true;
+}
+
+// Runs Nagamochi-Ibaraki and writes one side of the cut to side[node_count]
+static long long run_nagamochi_ibaraki(const SmartGraph& g, const SmartGraph::EdgeMap<long>& capacity,
+                                       unsigned char* side) {
+    NagamochiIbaraki<SmartGraph, SmartGraph::EdgeMap<long>> ni(g, capacity);
+    ni.run();
+
+    SmartGraph::NodeMap<bool> cut(g);
+    long long value = ni.minCutMap(cut);
+    if (side) {
+        for (SmartGraph::NodeIt n(g); n != INVALID; ++n) {
+            side[g.id(n)] = cut[n] ? 1 : 0;
+        }
+    }
+    return value;
+}
+
+// Gomory-Hu cut tree over the undirected view of a digraph (every arc is an
+// edge with its capacity). Node 0 is the root; pred/weight give each other
+// node's tree parent and the min cut value between the two, and order is a
+// numbering in which parents precede their children.
+struct GomoryHuWrapper {
+    int node_count;
+    std::vector<int> pred;
+    std::vector<long long> weight;
+    std::vector<int> order;
+    std::vector<int> by_order;
+
+    explicit GomoryHuWrapper(int n) : node_count(n), pred(n, -1), weight(n, 0) {}
+
+    // Gusfield's algorithm as in lemon/gomory_hu.h, with the n - 1 min cuts
+    // computed speculatively in batches of thread_count nodes. A batch is
+    // committed in node order up to the first node whose tree parent was
+    // changed by an earlier commit; that node starts the next batch. The cut
+    // of (n, pred[n]) depends on nothing else, so the tree equals the
+    // sequential one.
+    void build(const SmartGraph& graph, const SmartGraph::EdgeMap<long>& capacity, int thread_count) {
+        typedef Preflow<SmartGraph, SmartGraph::EdgeMap<long> > MinCutAlg;
+
+        for (int v = 1; v < node_count; ++v) pred[v] = 0;
+
+        if (node_count > 1) {
+            int threads = std::max(1, std::min(thread_count, node_count - 1));
+            ThreadBarrier barrier(threads);
+            std::vector<int> used_pred(threads);
+            std::vector<long> values(threads);
+            std::vector<std::vector<char> > sides(threads, std::vector<char>(node_count));
+            int next = 1;
+            int batch_end = std::min(node_count, 1 + threads);
+
+            run_parallel(threads, [&](int t) {
+                MinCutAlg min_cut(graph, capacity, graph.nodeFromId(0), graph.nodeFromId(1));
+
+                while (true) {
+                    barrier.wait();
+                    if (next >= node_count) break;
+
+                    int v = next + t;
+                    if (v < batch_end) {
+                        used_pred[t] = pred[v];
+                        min_cut.source(graph.nodeFromId(v));
+                        min_cut.target(graph.nodeFromId(pred[v]));
+                        min_cut.runMinCut();
+                        values[t] = min_cut.flowValue();
+                        for (int u = 0; u < node_count; ++u) {
+                            sides[t][u] = min_cut.minCut(graph.nodeFromId(u)) ? 1 : 0;
+                        }
+                    }
+                    barrier.wait();
+
+                    if (t == 0) {
+                        int committed = next;
+                        while (committed < batch_end && pred[committed] == used_pred[committed - next]) {
+                            commit(committed, values[committed - next], sides[committed - next]);
+                            ++committed;
+                        }
+                        next = committed;
+                        batch_end = std::min(node_count, next + threads);
+                    }
+                }
+            });
+        }
+
+        computeOrder();
+    }
+
+    void computeOrder() {
+        order.assign(node_count, -1);
+        by_order.clear();
+        for (int v = 0; v < node_count; ++v) {
+            std::vector<int> stack;
+            for (int u = v; u >= 0 && order[u] == -1; u = pred[u]) {
+                stack.push_back(u);
+            }
+            while (!stack.empty()) {
+                order[stack.back()] = static_cast<int>(by_order.size());
+                by_order.push_back(stack.back());
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Minimum weight on the tree path between s and t; *child receives the
+    // lower end of that tree edge
+    long long minCutValue(int s, int t, int* child) const {
+        long long value = std::numeric_limits<long long>::max();
+        while (s != t) {
+            int lower = order[s] < order[t] ? t : s;
+            if (weight[lower] < value) {
+                value = weight[lower];
+                *child = lower;
+            }
+            if (lower == s) s = pred[s]; else t = pred[t];
+        }
+        return value;
+    }
+
+    // Marks the side of the minimum s-t cut that contains s
+    long long minCutSide(int s, int t, unsigned char* s_side) const {
+        int child = -1;
+        long long value = minCutValue(s, t, &child);
+
+        // The subtree below the minimum edge is one side of the cut
+        std::vector<char> below(node_count, 0);
+        for (size_t i = 0; i < by_order.size(); ++i) {
+            int v = by_order[i];
+            below[v] = v == child || (pred[v] >= 0 && below[pred[v]]);
+        }
+        for (int v = 0; v < node_count; ++v) {
+            s_side[v] = below[v] == below[s] ? 1 : 0;
+        }
+        return value;
+    }
+
+private:
+    void commit(int v, long value, const std::vector<char>& side) {
+        int pv = pred[v];
+        weight[v] = value;
+        for (int u = 0; u < node_count; ++u) {
+            if (u != v && side[u] && pred[u] == pv) pred[u] = v;
+        }
+        if (pred[pv] >= 0 && side[pred[pv]]) {
+            pred[v] = pred[pv];
+            pred[pv] = v;
+            weight[v] = weight[pv];
+            weight[pv] = value;
+        }
+    }
+};
+
+// Maximum weighted (perfect) matching on an undirected graph. The algorithm
+// object and its heaps are kept between runs; each run copies the current
+// weights and only rebuilds the object after nodes or edges were added.
+struct MatchingWrapper {
+    typedef SmartGraph::EdgeMap<long> WeightMap;
+    typedef MaxWeightedMatching<SmartGraph, WeightMap> Matching;
+    typedef MaxWeightedPerfectMatching<SmartGraph, WeightMap> PerfectMatching;
+
+    UGraphWrapper* graph_wrapper;
+    bool perfect;
+    int node_count;
+    int edge_count;
+    WeightMap weights;
+    Matching* matching;
+    PerfectMatching* perfect_matching;
+
+    MatchingWrapper(UGraphWrapper* gw, bool perfect_only)
+        : graph_wrapper(gw), perfect(perfect_only), node_count(-1), edge_count(-1),
+          weights(gw->graph), matching(nullptr), perfect_matching(nullptr) {
+    }
+
+    ~MatchingWrapper() {
+        delete matching;
+        delete perfect_matching;
+    }
+
+    // Returns 1 if a matching was found (always, unless a perfect one was
+    // requested and none exists), 0 otherwise
+    int run(const WeightMap& weight_values, bool jumpstart, long long* weight, int* mate) {
+        const SmartGraph& g = graph_wrapper->graph;
+        if (weight) *weight = 0;
+
+        int nodes = static_cast<int>(graph_wrapper->nodes.size());
+        int edges = static_cast<int>(graph_wrapper->edges.size());
+        if (nodes != node_count || edges != edge_count) {
+            delete matching;
+            delete perfect_matching;
+            matching = nullptr;
+            perfect_matching = nullptr;
+            node_count = nodes;
+            edge_count = edges;
+        }
+
+        mapCopy(g, weight_values, weights);
+
+        if (perfect) {
+            if (!perfect_matching) perfect_matching = new PerfectMatching(g, weights);
+            if (jumpstart) perfect_matching->fractionalInit(); else perfect_matching->init();
+            if (!perfect_matching->start()) return 0;
+            copyResult(*perfect_matching, weight, mate);
+        } else {
+            if (!matching) matching = new Matching(g, weights);
+            if (jumpstart) matching->fractionalInit(); else matching->init();
+            matching->start();
+            copyResult(*matching, weight, mate);
+        }
+        return 1;
+    }
+
+private:
+    template<typename Alg>
+    void copyResult(const Alg& alg, long long* weight, int* mate) const {
+        const SmartGraph& g = graph_wrapper->graph;
+        if (weight) *weight = alg.matchingWeight();
+        if (mate) {
+            for (SmartGraph::NodeIt n(g); n != INVALID; ++n) {
+                SmartGraph::Node m = alg.mate(n);
+                mate[g.id(n)] = m == INVALID ? -1 : g.id(m);
+            }
+        }
+    }
+};
+
+// One row of the dense assignment search: relaxes the shortest path costs of
+// all columns through row `row` (cost h + cost_row[j] - v[j]) and returns the
+// unscanned column with the smallest cost in *argmin (-1 if none is finite).
+// Scanned columns have blocked[j] = +inf, which keeps them out of both steps
+// without a branch.
+static double scan_assignment_row(const double* cost_row, const double* v, const double* blocked,
+                                  double h, int row, int n, double* shortest, int* path, int* argmin) {
+    const double inf = std::numeric_limits<double>::infinity();
+    double best = inf;
+    int best_j = -1;
+    for (int j = 0; j < n; ++j) {
+        double r = ((h + cost_row[j]) - v[j]) + blocked[j];
+        if (r < shortest[j]) {
+            shortest[j] = r;
+            path[j] = row;
+        }
+        double key = shortest[j] + blocked[j];
+        if (key < best) {
+            best = key;
+            best_j = j;
+        }
+    }
+    *argmin = best_j;
+    return best;
+}
+
+#ifdef LEMON_WRAPPER_AVX2
+// AVX2 version of scan_assignment_row(), four columns per step
+LEMON_WRAPPER_TARGET_AVX2
+static double scan_assignment_row_avx2(const double* cost_row, const double* v, const double* blocked,
+                                       double h, int row, int n, double* shortest, int* path, int* argmin) {
+    const double inf = std::numeric_limits<double>::infinity();
+    __m256d vh = _mm256_set1_pd(h);
+    __m256d vbest = _mm256_set1_pd(inf);
+    __m256d vbest_j = _mm256_set1_pd(-1.0);
+    __m256d vj = _mm256_setr_pd(0.0, 1.0, 2.0, 3.0);
+    const __m256d four = _mm256_set1_pd(4.0);
+
+    int j = 0;
+    for (; j + 4 <= n; j += 4) {
+        __m256d b = _mm256_loadu_pd(blocked + j);
+        __m256d r = _mm256_add_pd(_mm256_sub_pd(_mm256_add_pd(vh, _mm256_loadu_pd(cost_row + j)),
+                                                _mm256_loadu_pd(v + j)), b);
+        __m256d s = _mm256_loadu_pd(shortest + j);
+        __m256d lt = _mm256_cmp_pd(r, s, _CMP_LT_OQ);
+        int mask = _mm256_movemask_pd(lt);
+        if (mask) {
+            s = _mm256_blendv_pd(s, r, lt);
+            _mm256_storeu_pd(shortest + j, s);
+            for (int k = 0; k < 4; ++k) {
+                if (mask & (1 << k)) path[j + k] = row;
+            }
+        }
+
+        __m256d key = _mm256_add_pd(s, b);
+        __m256d better = _mm256_cmp_pd(key, vbest, _CMP_LT_OQ);
+        vbest = _mm256_blendv_pd(vbest, key, better);
+        vbest_j = _mm256_blendv_pd(vbest_j, vj, better);
+        vj = _mm256_add_pd(vj, four);
+    }
+
+    // Each lane holds its first minimum; take the smallest, then the lowest column
+    alignas(32) double lane_best[4];
+    alignas(32) double lane_j[4];
+    _mm256_store_pd(lane_best, vbest);
+    _mm256_store_pd(lane_j, vbest_j);
+    double best = inf;
+    int best_j = -1;
+    for (int k = 0; k < 4; ++k) {
+        int lj = static_cast<int>(lane_j[k]);
+        if (lj >= 0 && (lane_best[k] < best || (lane_best[k] == best && lj < best_j))) {
+            best = lane_best[k];
+            best_j = lj;
+        }
+    }
+
+    for (; j < n; ++j) {
+        double r = ((h + cost_row[j]) - v[j]) + blocked[j];
+        if (r < shortest[j]) {
+            shortest[j] = r;
+            path[j] = row;
+        }
+        double key = shortest[j] + blocked[j];
+        if (key < best) {
+            best = key;
+            best_j = j;
+        }
+    }
+    *argmin = best_j;
+    return best;
+}
+#endif
+
+// Dense linear assignment on a row-major n x n cost matrix with the
+// shortest augmenting path method of Jonker and Volgenant.
+//
+// The column duals start at the column minima, which makes every reduced
+// cost non-negative, and each column's cheapest row is assigned greedily if
+// still free. Every remaining row is then matched along a shortest
+// augmenting path, found with a Dijkstra-like search that scans one full
+// matrix row per step (see scan_assignment_row). +inf costs forbid a pair.
+class DenseAssignment {
+public:
+    DenseAssignment(const double* cost, int n)
+        : _cost(cost), _n(n), _use_avx2(cpu_has_avx2()),
+          _u(n, 0.0), _v(n), _col4row(n, -1), _row4col(n, -1),
+          _shortest(n), _blocked(n), _path(n) {}
+
+    // Returns false if some row cannot be assigned
+    bool run() {
+        const double inf = std::numeric_limits<double>::infinity();
+
+        // Column reduction, one contiguous row at a time
+        std::vector<int> min_row(_n, -1);
+        std::fill(_v.begin(), _v.end(), inf);
+        for (int i = 0; i < _n; ++i) {
+            const double* row = _cost + static_cast<size_t>(i) * _n;
+            for (int j = 0; j < _n; ++j) {
+                if (row[j] < _v[j]) {
+                    _v[j] = row[j];
+                    min_row[j] = i;
+                }
+            }
+        }
+        for (int j = 0; j < _n; ++j) {
+            if (min_row[j] < 0) return false;
+            int i = min_row[j];
+            if (_col4row[i] < 0) {
+                _col4row[i] = j;
+                _row4col[j] = i;
+            }
+        }
+
+        for (int i = 0; i < _n; ++i) {
+            if (_col4row[i] < 0 && !augment(i)) return false;
+        }
+        return true;
+    }
+
+    const std::vector<int>& columnForRow() const { return _col4row; }
+
+private:
+    bool augment(int cur) {
+        const double inf = std::numeric_limits<double>::infinity();
+        std::fill(_shortest.begin(), _shortest.end(), inf);
+        std::fill(_blocked.begin(), _blocked.end(), 0.0);
+        _scanned_rows.clear();
+        _scanned_cols.clear();
+
+        double min_val = 0.0;
+        int i = cur;
+        int sink = -1;
+        while (sink < 0) {
+            _scanned_rows.push_back(i);
+            const double* row = _cost + static_cast<size_t>(i) * _n;
+            double h = min_val - _u[i];
+            int j;
+#ifdef LEMON_WRAPPER_AVX2
+            if (_use_avx2) {
+                min_val = scan_assignment_row_avx2(row, &_v[0], &_blocked[0], h, i, _n,
+                                                   &_shortest[0], &_path[0], &j);
+            } else
+#endif
+            {
+                min_val = scan_assignment_row(row, &_v[0], &_blocked[0], h, i, _n,
+                                              &_shortest[0], &_path[0], &j);
+            }
+            if (j < 0) return false;
+
+            _blocked[j] = inf;
+            _scanned_cols.push_back(j);
+            if (_row4col[j] < 0) {
+                sink = j;
+            } else {
+                i = _row4col[j];
+            }
+        }
+
+        // Dual update keeps the reduced costs non-negative and the matched pairs tight
+        _u[cur] += min_val;
+        for (size_t k = 1; k < _scanned_rows.size(); ++k) {
+            int r = _scanned_rows[k];
+            _u[r] += min_val - _shortest[_col4row[r]];
+        }
+        for (size_t k = 0; k < _scanned_cols.size(); ++k) {
+            int c = _scanned_cols[k];
+            _v[c] -= min_val - _shortest[c];
+        }
+
+        for (int j = sink;;) {
+            int r = _path[j];
+            _row4col[j] = r;
+            std::swap(_col4row[r], j);
+            if (r == cur) break;
+        }
+        return true;
+    }
+
+    const double* _cost;
+    int _n;
+    bool _use_avx2;
+    std::vector<double> _u;
+    std::vector<double> _v;
+    std::vector<int> _col4row;
+    std::vector<int> _row4col;
+    std::vector<double> _shortest;
+    std::vector<double> _blocked;
+    std::vector<int> _path;
+    std::vector<int> _scanned_rows;
+    std::vector<int> _scanned_cols;
+};
+
+// Sparse linear assignment on a SmartBpGraph: rows are the red nodes, columns
+// the blue nodes and every allowed pair an edge. Same shortest augmenting path
+// method as DenseAssignment, but each search only follows the edges of the
+// scanned rows and keeps the open columns in a binary heap.
+class SparseAssignment {
+public:
+    typedef SmartBpGraph::BlueNodeMap<int> HeapIndex;
+    typedef BinHeap<double, HeapIndex> Heap;
+
+    SparseAssignment(int row_count, int col_count, const int* rows, const int* cols,
+                     const double* costs, int entry_count)
+        : _row_count(row_count), _col_count(col_count), _cost(_graph), _heap_index(_graph),
+          _heap(_heap_index), _u(row_count, 0.0), _v(col_count, 0.0),
+          _col4row(row_count, -1), _row4col(col_count, -1),
+          _dist(col_count), _path(col_count), _done(col_count, 0) {
+        _graph.reserveNode(row_count + col_count);
+        _graph.reserveEdge(entry_count);
+        _reds.reserve(row_count);
+        _blues.reserve(col_count);
+        for (int i = 0; i < row_count; ++i) _reds.push_back(_graph.addRedNode());
+        for (int j = 0; j < col_count; ++j) {
+            _blues.push_back(_graph.addBlueNode());
+            _heap_index[_blues.back()] = Heap::PRE_HEAP;
+        }
+        for (int e = 0; e < entry_count; ++e) {
+            _cost[_graph.addEdge(_reds[rows[e]], _blues[cols[e]])] = costs[e];
+        }
+    }
+
+    // Returns false if some row cannot be assigned
+    bool run() {
+        const double inf = std::numeric_limits<double>::infinity();
+
+        // Column reduction over the allowed pairs, then greedy assignment. With
+        // spare columns the prices of unassigned columns must stay zero, so the
+        // rectangular case starts from zero prices instead.
+        if (_row_count < _col_count) {
+            for (int i = 0; i < _row_count; ++i) {
+                if (!augment(i)) return false;
+            }
+            return true;
+        }
+
+        std::vector<int> min_row(_col_count, -1);
+        std::fill(_v.begin(), _v.end(), inf);
+        for (SmartBpGraph::EdgeIt e(_graph); e != INVALID; ++e) {
+            int j = _graph.id(_graph.blueNode(e));
+            if (_cost[e] < _v[j]) {
+                _v[j] = _cost[e];
+                min_row[j] = _graph.id(_graph.redNode(e));
+            }
+        }
+        for (int j = 0; j < _col_count; ++j) {
+            if (min_row[j] < 0) {
+                _v[j] = 0.0;
+                continue;
+            }
+            int i = min_row[j];
+            if (_col4row[i] < 0) {
+                _col4row[i] = j;
+                _row4col[j] = i;
+            }
+        }
+
+        for (int i = 0; i < _row_count; ++i) {
+            if (_col4row[i] < 0 && !augment(i)) return false;
+        }
+        return true;
+    }
+
+    const std::vector<int>& columnForRow() const { return _col4row; }
+
+    double cost(int row, int col) const {
+        double best = std::numeric_limits<double>::infinity();
+        for (SmartBpGraph::IncEdgeIt e(_graph, _reds[row]); e != INVALID; ++e) {
+            if (_graph.id(_graph.blueNode(e)) == col && _cost[e] < best) best = _cost[e];
+        }
+        return best;
+    }
+
+private:
+    bool augment(int cur) {
+        _scanned_rows.clear();
+        _scanned_cols.clear();
+        _touched.clear();
+
+        double min_val = 0.0;
+        int i = cur;
+        int sink = -1;
+        while (sink < 0) {
+            _scanned_rows.push_back(i);
+            double h = min_val - _u[i];
+            for (SmartBpGraph::IncEdgeIt e(_graph, _reds[i]); e != INVALID; ++e) {
+                SmartBpGraph::BlueNode blue = _graph.blueNode(e);
+                int j = _graph.id(blue);
+                if (_done[j]) continue;
+
+                double r = (h + _cost[e]) - _v[j];
+                Heap::State state = _heap.state(blue);
+                if (state == Heap::PRE_HEAP) {
+                    _dist[j] = r;
+                    _path[j] = i;
+                    _heap.push(blue, r);
+                    _touched.push_back(j);
+                } else if (state == Heap::IN_HEAP && r < _dist[j]) {
+                    _dist[j] = r;
+                    _path[j] = i;
+                    _heap.decrease(blue, r);
+                }
+            }
+
+            if (_heap.empty()) {
+                reset();
+                return false;
+            }
+
+            int j = _graph.id(_heap.top());
+            min_val = _heap.prio();
+            _heap.pop();
+            _done[j] = 1;
+            _scanned_cols.push_back(j);
+            if (_row4col[j] < 0) {
+                sink = j;
+            } else {
+                i = _row4col[j];
+            }
+        }
+
+        _u[cur] += min_val;
+        for (size_t k = 1; k < _scanned_rows.size(); ++k) {
+            int r = _scanned_rows[k];
+            _u[r] += min_val - _dist[_col4row[r]];
+        }
+        for (size_t k = 0; k < _scanned_cols.size(); ++k) {
+            int c = _scanned_cols[k];
+            _v[c] -= min_val - _dist[c];
+        }
+
+        for (int j = sink;;) {
+            int r = _path[j];
+            _row4col[j] = r;
+            std::swap(_col4row[r], j);
+            if (r == cur) break;
+        }
+
+        reset();
+        return true;
+    }
+
+    // Returns the columns touched by the last search to their initial state
+    void reset() {
+        _heap.clear();
+        for (size_t k = 0; k < _touched.size(); ++k) {
+            int j = _touched[k];
+            _heap_index[_blues[j]] = Heap::PRE_HEAP;
+            _done[j] = 0;
+        }
+    }
+
+    int _row_count;
+    int _col_count;
+    SmartBpGraph _graph;
+    std::vector<SmartBpGraph::RedNode> _reds;
+    std::vector<SmartBpGraph::BlueNode> _blues;
+    SmartBpGraph::EdgeMap<double> _cost;
+    HeapIndex _heap_index;
+    Heap _heap;
+    std::vector<double> _u;
+    std::vector<double> _v;
+    std::vector<int> _col4row;
+    std::vector<int> _row4col;
+    std::vector<double> _dist;
+    std::vector<int> _path;
+    std::vector<char> _done;
+    std::vector<int> _scanned_rows;
+    std::vector<int> _scanned_cols;
+    std::vector<int> _touched;
+};
+
+// Minimum spanning forest of an edge list. Edges are ordered by (key, id),
+// where key is an order-preserving unsigned image of the weight, so ties
+// break by id and Kruskal and Boruvka select exactly the same edges.
+class SpanningForest {
+public:
+    enum Algorithm { AUTO = 0, KRUSKAL = 1, BORUVKA = 2 };
+
+    SpanningForest(int node_count, const std::vector<int>& u, const std::vector<int>& v,
+                   const std::vector<uint64_t>& key)
+        : _node_count(node_count), _u(u), _v(v), _key(key) {}
+
+    // Maps weights onto unsigned keys with the same order
+    static uint64_t weightKey(long weight) {
+        return static_cast<uint64_t>(static_cast<long long>(weight)) ^ (uint64_t(1) << 63);
+    }
+
+    static uint64_t weightKey(double weight) {
+        if (weight == 0.0) weight = 0.0;  // -0.0 and 0.0 compare equal
+        uint64_t bits;
+        std::memcpy(&bits, &weight, sizeof(bits));
+        return (bits >> 63) ? ~bits : bits | (uint64_t(1) << 63);
+    }
+
+    // Writes the selected edge ids and returns their number
+    int run(int algorithm, int thread_count, int* edge_ids) {
+        thread_count = resolve_thread_count(thread_count);
+        int edge_count = static_cast<int>(_u.size());
+        if (algorithm == AUTO) {
+            algorithm = thread_count > 1 && edge_count >= BORUVKA_THRESHOLD ? BORUVKA : KRUSKAL;
+        }
+        return algorithm == BORUVKA ? boruvka(thread_count, edge_ids) : kruskal(edge_ids);
+    }
+
+private:
+    static const int BORUVKA_THRESHOLD = 1 << 18;
+
+    struct KeyedEdge {
+        uint64_t key;
+        int id;
+    };
+
+    template <typename Composite>
+    struct CompositeKey {
+        typedef Composite result_type;
+        Composite operator()(Composite composite) const { return composite; }
+    };
+
+    struct EdgeKey {
+        typedef uint64_t result_type;
+        uint64_t operator()(const KeyedEdge& edge) const { return edge.key; }
+    };
+
+    int find(std::vector<int>& parent, int x) const {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    bool unite(std::vector<int>& parent, std::vector<int>& size, int a, int b) const {
+        a = find(parent, a);
+        b = find(parent, b);
+        if (a == b) return false;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        return true;
+    }
+
+    // Sorts the edge ids into (key, id) order. When the key range and the ids
+    // fit into 64 bits together, each edge becomes a single composite integer;
+    // otherwise (key, id) pairs are sorted stably on the full key.
+    std::vector<int> sortedEdges() const {
+        int edge_count = static_cast<int>(_u.size());
+        std::vector<int> order(edge_count);
+        if (edge_count == 0) return order;
+
+        uint64_t min_key = *std::min_element(_key.begin(), _key.end());
+        uint64_t max_key = *std::max_element(_key.begin(), _key.end());
+        int key_bits = 0;
+        while (key_bits < 64 && ((max_key - min_key) >> key_bits) != 0) ++key_bits;
+        int id_bits = 0;
+        while ((static_cast<uint64_t>(edge_count - 1) >> id_bits) != 0) ++id_bits;
+
+        if (key_bits + id_bits <= 32) {
+            sortComposite<uint32_t>(min_key, id_bits, order);
+        } else if (key_bits + id_bits <= 64) {
+            sortComposite<uint64_t>(min_key, id_bits, order);
+        } else {
+            std::vector<KeyedEdge> keyed(edge_count);
+            for (int e = 0; e < edge_count; ++e) {
+                keyed[e].key = _key[e];
+                keyed[e].id = e;
+            }
+            stableRadixSort(keyed.begin(), keyed.end(), EdgeKey());
+            for (int k = 0; k < edge_count; ++k) {
+                order[k] = keyed[k].id;
+            }
+        }
+        return order;
+    }
+
+    // Radix sorts (key - min_key) << id_bits | id, which is unique per edge
+    template <typename Composite>
+    void sortComposite(uint64_t min_key, int id_bits, std::vector<int>& order) const {
+        int edge_count = static_cast<int>(order.size());
+        std::vector<Composite> composite(edge_count);
+        for (int e = 0; e < edge_count; ++e) {
+            composite[e] = static_cast<Composite>(((_key[e] - min_key) << id_bits) | static_cast<uint64_t>(e));
+        }
+        stableRadixSort(composite.begin(), composite.end(), CompositeKey<Composite>());
+        Composite id_mask = static_cast<Composite>((uint64_t(1) << id_bits) - 1);
+        for (int k = 0; k < edge_count; ++k) {
+            order[k] = static_cast<int>(composite[k] & id_mask);
+        }
+    }
+
+    int kruskal(int* edge_ids) const {
+        std::vector<int> parent(_node_count);
+        std::vector<int> size(_node_count, 1);
+        for (int i = 0; i < _node_count; ++i) parent[i] = i;
+
+        std::vector<int> order = sortedEdges();
+        int count = 0;
+        for (size_t k = 0; k < order.size() && count < _node_count - 1; ++k) {
+            int e = order[k];
+            if (unite(parent, size, _u[e], _v[e])) {
+                edge_ids[count++] = e;
+            }
+        }
+        return count;
+    }
+
+    bool lighter(int a, int b) const {
+        return _key[a] < _key[b] || (_key[a] == _key[b] && a < b);
+    }
+
+    // Each round every component picks its lightest incident edge in
+    // parallel over the surviving edges, the picks are merged, and edges
+    // inside a component are dropped. Components at least halve per round.
+    int boruvka(int thread_count, int* edge_ids) const {
+        std::vector<int> comp(_node_count);
+        std::vector<int> parent(_node_count);
+        std::vector<int> size(_node_count, 1);
+        std::vector<int> roots(_node_count);
+        for (int i = 0; i < _node_count; ++i) comp[i] = parent[i] = roots[i] = i;
+        std::unique_ptr<std::atomic<int>[]> best(new std::atomic<int>[_node_count]);
+
+        std::vector<int> active;
+        active.reserve(_u.size());
+        for (int e = 0; e < static_cast<int>(_u.size()); ++e) {
+            if (_u[e] != _v[e]) active.push_back(e);
+        }
+
+        std::vector<std::vector<int> > survivors(thread_count);
+        int count = 0;
+        while (!active.empty()) {
+            for (size_t k = 0; k < roots.size(); ++k) {
+                best[roots[k]].store(-1, std::memory_order_relaxed);
+            }
+
+            int active_count = static_cast<int>(active.size());
+            run_parallel(thread_count, [&](int t) {
+                int begin = static_cast<int>(static_cast<long long>(active_count) * t / thread_count);
+                int end = static_cast<int>(static_cast<long long>(active_count) * (t + 1) / thread_count);
+                std::vector<int>& kept = survivors[t];
+                kept.clear();
+                for (int k = begin; k < end; ++k) {
+                    int e = active[k];
+                    int cu = comp[_u[e]];
+                    int cv = comp[_v[e]];
+                    if (cu == cv) continue;
+                    kept.push_back(e);
+                    offer(best[cu], e);
+                    offer(best[cv], e);
+                }
+            });
+
+            active.clear();
+            for (int t = 0; t < thread_count; ++t) {
+                active.insert(active.end(), survivors[t].begin(), survivors[t].end());
+            }
+            if (active.empty()) break;
+
+            for (size_t k = 0; k < roots.size(); ++k) {
+                int e = best[roots[k]].load(std::memory_order_relaxed);
+                if (e >= 0 && unite(parent, size, comp[_u[e]], comp[_v[e]])) {
+                    edge_ids[count++] = e;
+                }
+            }
+
+            size_t kept_roots = 0;
+            for (size_t k = 0; k < roots.size(); ++k) {
+                int r = roots[k];
+                parent[r] = find(parent, r);
+                if (parent[r] == r) roots[kept_roots++] = r;
+            }
+            roots.resize(kept_roots);
+
+            run_parallel(thread_count, [&](int t) {
+                int begin = static_cast<int>(static_cast<long long>(_node_count) * t / thread_count);
+                int end = static_cast<int>(static_cast<long long>(_node_count) * (t + 1) / thread_count);
+                for (int i = begin; i < end; ++i) {
+                    comp[i] = parent[comp[i]];
+                }
+            });
+        }
+        return count;
+    }
+
+    void offer(std::atomic<int>& slot, int e) const {
+        int current = slot.load(std::memory_order_relaxed);
+        while ((current < 0 || lighter(e, current)) &&
+               !slot.compare_exchange_weak(current, e, std::memory_order_relaxed)) {
+        }
+    }
+
+    int _node_count;
+    const std::vector<int>& _u;
+    const std::vector<int>& _v;
+    const std::vector<uint64_t>& _key;
+};
+
+// Runs SpanningForest on edge weights and sums the selected weights
+template <typename Value, typename Total>
+static int spanning_forest(int node_count, const std::vector<int>& u, const std::vector<int>& v,
+                           const std::vector<Value>& weight, int algorithm, int thread_count,
+                           int* edge_ids, Total* total_weight) {
+    std::vector<uint64_t> key(weight.size());
+    for (size_t e = 0; e < weight.size(); ++e) {
+        if (weight[e] != weight[e]) return -1;  // NaN
+        key[e] = SpanningForest::weightKey(weight[e]);
+    }
+
+    SpanningForest forest(node_count, u, v, key);
+    int count = forest.run(algorithm, thread_count, edge_ids);
+    if (total_weight) {
+        Total total = 0;
+        for (int k = 0; k < count; ++k) total += weight[edge_ids[k]];
+        *total_weight = total;
+    }
+    return count;
+}
+
+// Read-write int map over a caller buffer indexed by item id, so the
+// connectivity algorithms write their results without a NodeMap copy
+template <typename Graph, typename Item>
+class IdBufferMap {
+public:
+    typedef Item Key;
+    typedef int Value;
+
+    IdBufferMap(const Graph& graph, int* values) : _graph(graph), _values(values) {}
+
+    Value operator[](const Key& item) const { return _values[_graph.id(item)]; }
+    void set(const Key& item, const Value& value) { _values[_graph.id(item)] = value; }
+
+private:
+    const Graph& _graph;
+    int* _values;
+};
+
+// Read-write bool map over a caller bitset of 64-bit words indexed by item id
+template <typename Graph, typename Item>
+class IdBitsetMap {
+public:
+    typedef Item Key;
+    typedef bool Value;
+
+    IdBitsetMap(const Graph& graph, unsigned long long* words) : _graph(graph), _words(words) {}
+
+    Value operator[](const Key& item) const {
+        int id = _graph.id(item);
+        return (_words[id >> 6] >> (id & 63)) & 1;
+    }
+
+    void set(const Key& item, const Value& value) {
+        int id = _graph.id(item);
+        if (value) {
+            _words[id >> 6] |= 1ULL << (id & 63);
+        } else {
+            _words[id >> 6] &= ~(1ULL << (id & 63));
+        }
+    }
+
+private:
+    const Graph& _graph;
+    unsigned long long* _words;
+};
+
+// Bool edge map that hides self-loops: the connectivity algorithms would
+// count a self-loop as a block of its own and its node as a cut node
+template <typename Graph>
+class NonLoopMap {
+public:
+    typedef typename Graph::Edge Key;
+    typedef bool Value;
+
+    explicit NonLoopMap(const Graph& graph) : _graph(graph) {}
+
+    Value operator[](const Key& edge) const { return _graph.u(edge) != _graph.v(edge); }
+
+private:
+    const Graph& _graph;
+};
+
+// Runs find on the graph, or on a loop-free view of it if it has self-loops
+template <typename Graph, typename Find>
+static int run_without_loops(const Graph& graph, Find find) {
+    for (typename Graph::EdgeIt e(graph); e != INVALID; ++e) {
+        if (graph.u(e) == graph.v(e)) {
+            NonLoopMap<Graph> non_loop(graph);
+            FilterEdges<const Graph, const NonLoopMap<Graph> > loop_free(graph, non_loop);
+            return find(loop_free);
+        }
+    }
+    return find(graph);
+}
+
+// Cut nodes, bridges and biconnected blocks of an undirected graph, written
+// to caller buffers: cut_nodes and bridges are bitsets of 64-bit words and
+// block_of_edge gets -1 for self-loops, which belong to no block.
+struct CutNodeFinder {
+    unsigned long long* cut_nodes;
+
+    template <typename View>
+    int operator()(const View& view) const {
+        IdBitsetMap<View, typename View::Node> cut(view, cut_nodes);
+        return biNodeConnectedCutNodes(view, cut);
+    }
+};
+
+struct BridgeFinder {
+    unsigned long long* bridges;
+
+    template <typename View>
+    int operator()(const View& view) const {
+        IdBitsetMap<View, typename View::Edge> cut(view, bridges);
+        return biEdgeConnectedCutEdges(view, cut);
+    }
+};
+
+struct BlockFinder {
+    int* block_of_edge;
+
+    template <typename View>
+    int operator()(const View& view) const {
+        IdBufferMap<View, typename View::Edge> block(view, block_of_edge);
+        return biNodeConnectedComponents(view, block);
+    }
+};
+
+template <typename Graph>
+static int find_cut_nodes(const Graph& graph, int node_count, unsigned long long* cut_nodes) {
+    std::fill(cut_nodes, cut_nodes + (node_count + 63) / 64, 0ULL);
+    CutNodeFinder finder = { cut_nodes };
+    return run_without_loops(graph, finder);
+}
+
+template <typename Graph>
+static int find_bridges(const Graph& graph, int edge_count, unsigned long long* bridges) {
+    std::fill(bridges, bridges + (edge_count + 63) / 64, 0ULL);
+    BridgeFinder finder = { bridges };
+    return run_without_loops(graph, finder);
+}
+
+template <typename Graph>
+static int find_blocks(const Graph& graph, int edge_count, int* block_of_edge) {
+    std::fill(block_of_edge, block_of_edge + edge_count, -1);
+    BlockFinder finder = { block_of_edge };
+    return run_without_loops(graph, finder);
+}
+
+// Builds the condensation of a graph whose nodes are labelled with their
+// strongly connected components: node c stands for component c and there is
+// one arc for every pair of components joined by at least one arc
+static GraphWrapper* build_condensation(GraphWrapper* graph_wrapper, const int* component,
+                                        int component_count) {
+    const CsrGraph& csr = get_csr(graph_wrapper);
+    int node_count = csr.node_count;
+
+    // Group the nodes by component with a counting sort
+    std::vector<int> begin(component_count + 1, 0);
+    for (int i = 0; i < node_count; ++i) ++begin[component[i] + 1];
+    for (int c = 0; c < component_count; ++c) begin[c + 1] += begin[c];
+    std::vector<int> members(node_count);
+    std::vector<int> fill(begin.begin(), begin.end() - 1);
+    for (int i = 0; i < node_count; ++i) members[fill[component[i]]++] = i;
+
+    GraphWrapper* condensed = new GraphWrapper();
+    SmartDigraph& g = condensed->graph;
+    g.reserveNode(component_count);
+    condensed->nodes.reserve(component_count);
+    for (int c = 0; c < component_count; ++c) {
+        condensed->nodes.push_back(g.addNode());
+    }
+
+    // last_source[d] == c marks the arc c -> d as already added
+    std::vector<int> last_source(component_count, -1);
+    for (int c = 0; c < component_count; ++c) {
+        for (int k = begin[c]; k < begin[c + 1]; ++k) {
+            int node = members[k];
+            for (int a = csr.out_begin[node]; a < csr.out_begin[node + 1]; ++a) {
+                int d = component[csr.out_target[a]];
+                if (d == c || last_source[d] == c) continue;
+                last_source[d] = c;
+                condensed->arcs.push_back(g.addArc(condensed->nodes[c], condensed->nodes[d]));
+            }
+        }
+    }
+    return condensed;
+}
+
+// Index of the lowest set bit of a non-zero word
+static inline int lowest_bit(unsigned long long bits) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(bits);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    int index = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// Direction-optimizing breadth-first search (Beamer et al.) over the CSR
+// snapshot. Top-down steps expand a queue frontier along out-arcs. Once the
+// arcs leaving the frontier exceed 1/alpha of the arcs left to explore, it
+// switches to bottom-up steps, in which every unvisited node scans its
+// in-arcs for a parent in a bitset frontier and stops at the first one.
+// It returns to top-down when the frontier shrinks below node_count/beta.
+class DirectionOptimizingBfs {
+public:
+    DirectionOptimizingBfs(const CsrGraph& csr, int alpha, int beta)
+        : _csr(csr), _alpha(alpha > 0 ? alpha : 14), _beta(beta > 0 ? beta : 24),
+          _words((csr.node_count + 63) / 64) {}
+
+    // Fills dist (-1 if unreached) and pred (-1 for the source and unreached
+    // nodes) and returns the number of reached nodes
+    int run(int source, int* dist, int* pred) {
+        int node_count = _csr.node_count;
+        std::fill(dist, dist + node_count, -1);
+        std::fill(pred, pred + node_count, -1);
+
+        _visited.assign(_words, 0ULL);
+        _frontier.assign(_words, 0ULL);
+        _next.assign(_words, 0ULL);
+        _queue.clear();
+        _queue.push_back(source);
+        dist[source] = 0;
+        mark(_visited, source);
+
+        long long unexplored = static_cast<long long>(_csr.arc_count) - outDegree(source);
+        long long frontier_arcs = outDegree(source);
+        int frontier_size = 1;
+        int reached = 1;
+        bool bottom_up = false;
+
+        for (int level = 0; frontier_size > 0; ++level) {
+            if (!bottom_up && frontier_arcs > unexplored / _alpha) {
+                bottom_up = true;
+                queueToBitset();
+            } else if (bottom_up && frontier_size < node_count / _beta) {
+                bottom_up = false;
+                bitsetToQueue();
+            }
+
+            if (bottom_up) {
+                frontier_size = bottomUpStep(level, dist, pred, frontier_arcs);
+            } else {
+                frontier_size = topDownStep(level, dist, pred, frontier_arcs);
+            }
+            unexplored -= frontier_arcs;
+            reached += frontier_size;
+        }
+        return reached;
+    }
+
+private:
+    static void mark(std::vector<unsigned long long>& bits, int node) {
+        bits[node >> 6] |= 1ULL << (node & 63);
+    }
+
+    static bool marked(const std::vector<unsigned long long>& bits, int node) {
+        return (bits[node >> 6] >> (node & 63)) & 1;
+    }
+
+    int outDegree(int node) const {
+        return _csr.out_begin[node + 1] - _csr.out_begin[node];
+    }
+
+    int topDownStep(int level, int* dist, int* pred, long long& next_arcs) {
+        _next_queue.clear();
+        next_arcs = 0;
+        for (size_t k = 0; k < _queue.size(); ++k) {
+            int u = _queue[k];
+            for (int a = _csr.out_begin[u]; a < _csr.out_begin[u + 1]; ++a) {
+                int v = _csr.out_target[a];
+                if (marked(_visited, v)) continue;
+                mark(_visited, v);
+                dist[v] = level + 1;
+                pred[v] = _csr.out_arc[a];
+                _next_queue.push_back(v);
+                next_arcs += outDegree(v);
+            }
+        }
+        _queue.swap(_next_queue);
+        return static_cast<int>(_queue.size());
+    }
+
+    int bottomUpStep(int level, int* dist, int* pred, long long& next_arcs) {
+        std::fill(_next.begin(), _next.end(), 0ULL);
+        next_arcs = 0;
+        int found = 0;
+        int node_count = _csr.node_count;
+        for (int w = 0; w < _words; ++w) {
+            unsigned long long unvisited = ~_visited[w];
+            while (unvisited != 0) {
+                int bit = lowest_bit(unvisited);
+                unvisited &= unvisited - 1;
+                int v = (w << 6) + bit;
+                if (v >= node_count) break;
+                for (int k = _csr.in_begin[v]; k < _csr.in_begin[v + 1]; ++k) {
+                    if (marked(_frontier, _csr.in_source[k])) {
+                        dist[v] = level + 1;
+                        pred[v] = _csr.in_arc[k];
+                        mark(_next, v);
+                        next_arcs += outDegree(v);
+                        ++found;
+                        break;
+                    }
+                }
+            }
+        }
+        for (int w = 0; w < _words; ++w) {
+            _visited[w] |= _next[w];
+        }
+        _frontier.swap(_next);
+        return found;
+    }
+
+    void queueToBitset() {
+        std::fill(_frontier.begin(), _frontier.end(), 0ULL);
+        for (size_t k = 0; k < _queue.size(); ++k) {
+            mark(_frontier, _queue[k]);
+        }
+    }
+
+    void bitsetToQueue() {
+        _queue.clear();
+        for (int w = 0; w < _words; ++w) {
+            unsigned long long bits = _frontier[w];
+            while (bits != 0) {
+                _queue.push_back((w << 6) + lowest_bit(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    const CsrGraph& _csr;
+    int _alpha;
+    int _beta;
+    int _words;
+    std::vector<unsigned long long> _visited;
+    std::vector<unsigned long long> _frontier;
+    std::vector<unsigned long long> _next;
+    std::vector<int> _queue;
+    std::vector<int> _next_queue;
+};
+
+// Number of set bits of a word
+static inline int bit_count(unsigned long long bits) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(bits);
+#else
+    int count = 0;
+    for (; bits != 0; bits &= bits - 1) ++count;
+    return count;
+#endif
+}
+
+// Writes level as the distance of node from every source whose bit is set
+// in bits; dist holds one row per source, lane selects the 64-source block
+static inline void record_distances(int* dist, int node_count, int node, int lane,
+                                    unsigned long long bits, int level) {
+    for (; bits != 0; bits &= bits - 1) {
+        size_t source = static_cast<size_t>(lane) * 64 + lowest_bit(bits);
+        dist[source * node_count + node] = level;
+    }
+}
+
+// Applies the sources that reach node w for the first time and returns
+// how many there are; w joins the next frontier if it had no bits yet
+static inline long long gain_sources(const CsrGraph& csr, int lanes, int w,
+                                     const unsigned long long* fresh, unsigned long long* seen_w,
+                                     unsigned long long* next_w, std::vector<int>& next_frontier,
+                                     int* dist, int level) {
+    bool queued = false;
+    for (int lane = 0; lane < lanes; ++lane) {
+        queued = queued || next_w[lane] != 0;
+    }
+    if (!queued) next_frontier.push_back(w);
+
+    long long reached = 0;
+    for (int lane = 0; lane < lanes; ++lane) {
+        if (fresh[lane] == 0) continue;
+        seen_w[lane] |= fresh[lane];
+        next_w[lane] |= fresh[lane];
+        reached += bit_count(fresh[lane]);
+        if (dist) record_distances(dist, csr.node_count, w, lane, fresh[lane], level);
+    }
+    return reached;
+}
+
+// Expands one level of a multi-source BFS. Every node carries `lanes` words
+// of source bits; along an arc v->w the sources reaching w for the first
+// time are visit[v] & ~seen[w]. Returns the number of (source, node) pairs
+// reached on this level.
+static long long expand_sources(const CsrGraph& csr, int lanes, const std::vector<int>& frontier,
+                                const unsigned long long* visit, unsigned long long* seen,
+                                unsigned long long* next, std::vector<int>& next_frontier,
+                                int* dist, int level) {
+    long long reached = 0;
+    unsigned long long fresh[4];
+    for (size_t k = 0; k < frontier.size(); ++k) {
+        int v = frontier[k];
+        const unsigned long long* from = visit + static_cast<size_t>(v) * lanes;
+        for (int a = csr.out_begin[v]; a < csr.out_begin[v + 1]; ++a) {
+            int w = csr.out_target[a];
+            unsigned long long* seen_w = seen + static_cast<size_t>(w) * lanes;
+            unsigned long long any = 0;
+            for (int lane = 0; lane < lanes; ++lane) {
+                fresh[lane] = from[lane] & ~seen_w[lane];
+                any |= fresh[lane];
+            }
+            if (any == 0) continue;
+            reached += gain_sources(csr, lanes, w, fresh, seen_w, next + static_cast<size_t>(w) * lanes,
+                                    next_frontier, dist, level);
+        }
+    }
+    return reached;
+}
+
+#ifdef LEMON_WRAPPER_AVX2
+// AVX2 version of expand_sources() for four lanes (256 sources): the
+// and-not and the emptiness test of each arc take one instruction each
+LEMON_WRAPPER_TARGET_AVX2
+static long long expand_sources_avx2(const CsrGraph& csr, const std::vector<int>& frontier,
+                                     const unsigned long long* visit, unsigned long long* seen,
+                                     unsigned long long* next, std::vector<int>& next_frontier,
+                                     int* dist, int level) {
+    long long reached = 0;
+    unsigned long long fresh[4];
+    for (size_t k = 0; k < frontier.size(); ++k) {
+        int v = frontier[k];
+        __m256i from = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(visit + static_cast<size_t>(v) * 4));
+        for (int a = csr.out_begin[v]; a < csr.out_begin[v + 1]; ++a) {
+            int w = csr.out_target[a];
+            unsigned long long* seen_w = seen + static_cast<size_t>(w) * 4;
+            __m256i gained = _mm256_andnot_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(seen_w)), from);
+            if (_mm256_testz_si256(gained, gained)) continue;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(fresh), gained);
+            reached += gain_sources(csr, 4, w, fresh, seen_w, next + static_cast<size_t>(w) * 4,
+                                    next_frontier, dist, level);
+        }
+    }
+    return reached;
+}
+#endif
+
+// Bit-parallel BFS from up to 256 sources at once (MS-BFS): one traversal
+// carries a source mask per node, so the sources share every arc scan.
+// Larger source sets run in batches of 256.
+class MultiSourceBfs {
+public:
+    static const int MAX_BATCH = 256;
+
+    explicit MultiSourceBfs(const CsrGraph& csr) : _csr(csr), _use_avx2(cpu_has_avx2()) {}
+
+    // dist (may be null) gets source_count rows of node_count hop counts, -1
+    // if unreachable; reach (may be null) gets source_count bitset rows of
+    // (node_count + 63) / 64 words. Returns the reached (source, node) pairs.
+    long long run(const int* sources, int source_count, int* dist, unsigned long long* reach) {
+        int node_count = _csr.node_count;
+        size_t words = (node_count + 63) / 64;
+        if (dist) std::fill(dist, dist + static_cast<size_t>(source_count) * node_count, -1);
+        if (reach) std::fill(reach, reach + static_cast<size_t>(source_count) * words, 0ULL);
+
+        long long reached = 0;
+        for (int first = 0; first < source_count; first += MAX_BATCH) {
+            int batch = std::min(MAX_BATCH, source_count - first);
+            reached += runBatch(sources + first, batch,
+                                dist ? dist + static_cast<size_t>(first) * node_count : nullptr,
+                                reach ? reach + static_cast<size_t>(first) * words : nullptr);
+        }
+        return reached;
+    }
+
+private:
+    long long runBatch(const int* sources, int batch, int* dist, unsigned long long* reach) {
+        int node_count = _csr.node_count;
+        int lanes = (batch + 63) / 64;
+        if (_use_avx2 && lanes > 1) lanes = 4;
+
+        size_t size = static_cast<size_t>(node_count) * lanes;
+        _seen.assign(size, 0ULL);
+        _visit.assign(size, 0ULL);
+        _next.assign(size, 0ULL);
+        _frontier.clear();
+
+        long long reached = 0;
+        for (int s = 0; s < batch; ++s) {
+            int source = sources[s];
+            unsigned long long bit = 1ULL << (s & 63);
+            size_t word = static_cast<size_t>(source) * lanes + (s >> 6);
+            bool queued = false;
+            for (int lane = 0; lane < lanes; ++lane) {
+                queued = queued || _visit[static_cast<size_t>(source) * lanes + lane] != 0;
+            }
+            if (!queued) _frontier.push_back(source);
+            _seen[word] |= bit;
+            _visit[word] |= bit;
+            ++reached;
+            if (dist) dist[static_cast<size_t>(s) * node_count + source] = 0;
+        }
+
+        for (int level = 1; !_frontier.empty(); ++level) {
+            _next_frontier.clear();
+#ifdef LEMON_WRAPPER_AVX2
+            if (lanes == 4 && _use_avx2) {
+                reached += expand_sources_avx2(_csr, _frontier, &_visit[0], &_seen[0], &_next[0],
+                                               _next_frontier, dist, level);
+            } else
+#endif
+            {
+                reached += expand_sources(_csr, lanes, _frontier, &_visit[0], &_seen[0], &_next[0],
+                                          _next_frontier, dist, level);
+            }
+
+            for (size_t k = 0; k < _frontier.size(); ++k) {
+                std::fill_n(&_visit[static_cast<size_t>(_frontier[k]) * lanes], lanes, 0ULL);
+            }
+            _visit.swap(_next);
+            _frontier.swap(_next_frontier);
+        }
+
+        if (reach) {
+            size_t words = (node_count + 63) / 64;
+            for (int w = 0; w < node_count; ++w) {
+                for (int lane = 0; lane < lanes; ++lane) {
+                    for (unsigned long long bits = _seen[static_cast<size_t>(w) * lanes + lane]; bits != 0;
+                         bits &= bits - 1) {
+                        size_t source = static_cast<size_t>(lane) * 64 + lowest_bit(bits);
+                        reach[source * words + (w >> 6)] |= 1ULL << (w & 63);
+                    }
+                }
+            }
+        }
+        return reached;
+    }
+
+    const CsrGraph& _csr;
+    bool _use_avx2;
+    std::vector<unsigned long long> _seen;
+    std::vector<unsigned long long> _visit;
+    std::vector<unsigned long long> _next;
+    std::vector<int> _frontier;
+    std::vector<int> _next_frontier;
+};
+
+// Threads only pay off once a traversal has enough arcs to split
+static int parallel_traversal_threads(int thread_count, int arc_count) {
+    return thread_count > 0 ? thread_count : (arc_count < 65536 ? 1 : resolve_thread_count(0));
+}
+
+// Level-synchronous parallel BFS over the CSR snapshot. The threads take
+// chunks of the current frontier and claim unvisited targets with an atomic
+// fetch_or on a visited bitset; the winner writes dist/pred and appends the
+// node to a private queue, which is published into the next frontier once the
+// level is done. Each level ends with one barrier.
+class ParallelBfs {
+public:
+    ParallelBfs(const CsrGraph& csr, int thread_count)
+        : _csr(csr), _thread_count(thread_count), _barrier(thread_count) {}
+
+    int run(int source, int* dist, int* pred) {
+        int node_count = _csr.node_count;
+        std::fill(dist, dist + node_count, -1);
+        std::fill(pred, pred + node_count, -1);
+
+        size_t words = (node_count + 63) / 64;
+        _visited.reset(new std::atomic<unsigned long long>[words]);
+        for (size_t i = 0; i < words; ++i) _visited[i].store(0, std::memory_order_relaxed);
+        _frontier.assign(node_count, 0);
+        _next.assign(node_count, 0);
+
+        _visited[source >> 6].store(1ULL << (source & 63), std::memory_order_relaxed);
+        dist[source] = 0;
+        _frontier[0] = source;
+        _frontier_size = 1;
+        _next_size.store(0);
+        _cursor.store(0);
+        _reached = 1;
+        _dist = dist;
+        _pred = pred;
+
+        run_parallel(_thread_count, [this](int t) { work(t); });
+        return _reached;
+    }
+
+private:
+    static const int CHUNK = 64;
+
+    void work(int t) {
+        std::vector<int> local;
+        for (int level = 1; _frontier_size > 0; ++level) {
+            for (int begin = _cursor.fetch_add(CHUNK); begin < _frontier_size; begin = _cursor.fetch_add(CHUNK)) {
+                int end = std::min(_frontier_size, begin + CHUNK);
+                for (int k = begin; k < end; ++k) {
+                    int v = _frontier[k];
+                    for (int a = _csr.out_begin[v]; a < _csr.out_begin[v + 1]; ++a) {
+                        int w = _csr.out_target[a];
+                        unsigned long long bit = 1ULL << (w & 63);
+                        std::atomic<unsigned long long>& word = _visited[w >> 6];
+                        if (word.load(std::memory_order_relaxed) & bit) continue;
+                        if (word.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+                        _dist[w] = level;
+                        _pred[w] = _csr.out_arc[a];
+                        local.push_back(w);
+                    }
+                }
+            }
+
+            if (!local.empty()) {
+                int offset = _next_size.fetch_add(static_cast<int>(local.size()));
+                std::copy(local.begin(), local.end(), _next.begin() + offset);
+                local.clear();
+            }
+            _barrier.wait();
+
+            if (t == 0) {
+                _frontier.swap(_next);
+                _frontier_size = _next_size.load();
+                _reached += _frontier_size;
+                _next_size.store(0);
+                _cursor.store(0);
+            }
+            _barrier.wait();
+        }
+    }
+
+    const CsrGraph& _csr;
+    int _thread_count;
+    ThreadBarrier _barrier;
+    std::unique_ptr<std::atomic<unsigned long long>[]> _visited;
+    std::vector<int> _frontier;
+    std::vector<int> _next;
+    int _frontier_size;
+    std::atomic<int> _next_size;
+    std::atomic<int> _cursor;
+    int _reached;
+    int* _dist;
+    int* _pred;
+};
+
+// Parallel connected components (Afforest, Sutton et al.) with a lock-free
+// union-find: a root is only ever hooked below a smaller root with a CAS, so
+// every tree stays rooted at its smallest node. The first two neighbors of
+// every node are linked in parallel rounds, which already merges most of the
+// giant component; a sample of nodes then finds that component, and the final
+// pass links the remaining arcs only for nodes outside it. Arcs are treated
+// as undirected: out-adjacency lists holding each edge once from either end
+// need the in-adjacency as well (has_in) so that nodes outside the giant
+// component see all their arcs.
+class ParallelComponents {
+public:
+    ParallelComponents(const CsrGraph& csr, int thread_count)
+        : _csr(csr), _thread_count(thread_count), _parent(new std::atomic<int>[csr.node_count > 0 ? csr.node_count : 1]) {}
+
+    // Writes component_of_node, numbering the components in the order of
+    // their smallest node, and returns the number of components
+    int run(int* component_of_node) {
+        int node_count = _csr.node_count;
+        if (node_count == 0) return 0;
+
+        parallel_for(node_count, [this](int v) { _parent[v].store(v, std::memory_order_relaxed); });
+
+        const int rounds = 2;
+        for (int r = 0; r < rounds; ++r) {
+            parallel_for(node_count, [this, r](int v) {
+                int a = _csr.out_begin[v] + r;
+                if (a < _csr.out_begin[v + 1]) link(v, _csr.out_target[a]);
+            });
+            parallel_for(node_count, [this](int v) { compress(v); });
+        }
+
+        int giant = sample_frequent_root();
+        parallel_for(node_count, [this, giant](int v) {
+            if (_parent[v].load(std::memory_order_relaxed) == giant) return;
+            for (int a = _csr.out_begin[v] + rounds; a < _csr.out_begin[v + 1]; ++a) {
+                link(v, _csr.out_target[a]);
+            }
+            if (_csr.has_in) {
+                for (int a = _csr.in_begin[v]; a < _csr.in_begin[v + 1]; ++a) {
+                    link(v, _csr.in_source[a]);
+                }
+            }
+        });
+        parallel_for(node_count, [this](int v) { compress(v); });
+
+        return number_components(component_of_node);
+    }
+
+private:
+    static const int BLOCK = 4096;
+
+    // Runs body(v) for every v < count, handing out blocks to the threads
+    template<typename Body>
+    void parallel_for(int count, Body body) {
+        int threads = std::min(_thread_count, (count + BLOCK - 1) / BLOCK);
+        if (threads <= 1) {
+            for (int v = 0; v < count; ++v) body(v);
+            return;
+        }
+        std::atomic<int> next(0);
+        run_parallel(threads, [&](int) {
+            for (int begin = next.fetch_add(BLOCK); begin < count; begin = next.fetch_add(BLOCK)) {
+                int end = std::min(count, begin + BLOCK);
+                for (int v = begin; v < end; ++v) body(v);
+            }
+        });
+    }
+
+    void link(int u, int v) {
+        int p1 = _parent[u].load(std::memory_order_relaxed);
+        int p2 = _parent[v].load(std::memory_order_relaxed);
+        while (p1 != p2) {
+            int high = std::max(p1, p2);
+            int low = std::min(p1, p2);
+            int p_high = _parent[high].load(std::memory_order_relaxed);
+            if (p_high == low) break;
+            if (p_high == high) {
+                int expected = high;
+                if (_parent[high].compare_exchange_strong(expected, low)) break;
+            }
+            p1 = _parent[_parent[high].load(std::memory_order_relaxed)].load(std::memory_order_relaxed);
+            p2 = _parent[low].load(std::memory_order_relaxed);
+        }
+    }
+
+    void compress(int v) {
+        int p = _parent[v].load(std::memory_order_relaxed);
+        int gp = _parent[p].load(std::memory_order_relaxed);
+        while (p != gp) {
+            _parent[v].store(gp, std::memory_order_relaxed);
+            p = gp;
+            gp = _parent[p].load(std::memory_order_relaxed);
+        }
+    }
+
+    // Most frequent root among 1024 sampled nodes, with a fixed seed so
+    // that runs are reproducible
+    int sample_frequent_root() const {
+        const int samples = 1024;
+        std::vector<int> roots(samples);
+        unsigned long long state = 0x9E3779B97F4A7C15ULL;
+        for (int i = 0; i < samples; ++i) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            roots[i] = _parent[static_cast<int>(state % static_cast<unsigned long long>(_csr.node_count))]
+                .load(std::memory_order_relaxed);
+        }
+        std::sort(roots.begin(), roots.end());
+        int best = roots[0];
+        int best_count = 0;
+        for (int i = 0, j; i < samples; i = j) {
+            for (j = i; j < samples && roots[j] == roots[i]; ++j) {}
+            if (j - i > best_count) {
+                best = roots[i];
+                best_count = j - i;
+            }
+        }
+        return best;
+    }
+
+    // Roots are the smallest node of their component, so counting roots
+    // per block and taking prefix sums numbers components by smallest node
+    int number_components(int* component_of_node) {
+        int node_count = _csr.node_count;
+        int blocks = (node_count + BLOCK - 1) / BLOCK;
+        std::vector<int> first_label(blocks + 1, 0);
+        parallel_blocks(blocks, [&](int b) {
+            int end = std::min(node_count, (b + 1) * BLOCK);
+            int roots = 0;
+            for (int v = b * BLOCK; v < end; ++v) {
+                if (_parent[v].load(std::memory_order_relaxed) == v) ++roots;
+            }
+            first_label[b + 1] = roots;
+        });
+        for (int b = 0; b < blocks; ++b) first_label[b + 1] += first_label[b];
+
+        parallel_blocks(blocks, [&](int b) {
+            int end = std::min(node_count, (b + 1) * BLOCK);
+            int label = first_label[b];
+            for (int v = b * BLOCK; v < end; ++v) {
+                if (_parent[v].load(std::memory_order_relaxed) == v) component_of_node[v] = label++;
+            }
+        });
+        parallel_for(node_count, [&](int v) {
+            component_of_node[v] = component_of_node[_parent[v].load(std::memory_order_relaxed)];
+        });
+        return first_label[blocks];
+    }
+
+    template<typename Body>
+    void parallel_blocks(int blocks, Body body) {
+        int threads = std::min(_thread_count, blocks);
+        std::atomic<int> next(0);
+        run_parallel(std::max(1, threads), [&](int) {
+            for (int b = next++; b < blocks; b = next++) body(b);
+        });
+    }
+
+    const CsrGraph& _csr;
+    int _thread_count;
+    std::unique_ptr<std::atomic<int>[]> _parent;
+};
+
+// Ring buffer of traversal events. Its capacity stays fixed unless a single
+// traversal step records more events than are free, in which case it grows.
+class TraversalEventRing {
+public:
+    explicit TraversalEventRing(int capacity) : _events(capacity), _head(0), _size(0) {}
+
+    size_t size() const { return _size; }
+
+    void clear() {
+        _head = 0;
+        _size = 0;
+    }
+
+    void push(int kind, int node, int arc) {
+        if (_size == _events.size()) grow();
+        LemonTraversalEvent& event = _events[(_head + _size) % _events.size()];
+        event.kind = kind;
+        event.node = node;
+        event.arc = arc;
+        ++_size;
+    }
+
+    // Moves up to max_events of the oldest events to events
+    int pop(LemonTraversalEvent* events, int max_events) {
+        int count = static_cast<int>(std::min(_size, static_cast<size_t>(max_events)));
+        for (int i = 0; i < count; ++i) {
+            events[i] = _events[_head];
+            _head = (_head + 1) % _events.size();
+        }
+        _size -= count;
+        return count;
+    }
+
+private:
+    void grow() {
+        std::vector<LemonTraversalEvent> events(2 * _events.size());
+        for (size_t i = 0; i < _size; ++i) {
+            events[i] = _events[(_head + i) % _events.size()];
+        }
+        _events.swap(events);
+        _head = 0;
+    }
+
+    std::vector<LemonTraversalEvent> _events;
+    size_t _head;
+    size_t _size;
+};
+
+// BfsVisit/DfsVisit visitor that records the events selected by mask.
+// Arc events carry the node the traversal moves to: the target of a
+// discovered or examined arc, the source of a backtracked one.
+struct RecordingVisitor {
+    typedef SmartDigraph::Node Node;
+    typedef SmartDigraph::Arc Arc;
+
+    const SmartDigraph* graph;
+    TraversalEventRing* ring;
+    int mask;
+
+    RecordingVisitor(const SmartDigraph& g, TraversalEventRing& r) : graph(&g), ring(&r), mask(0) {}
+
+    void record(int kind, Node node, Arc arc) {
+        if (mask & kind) ring->push(kind, graph->id(node), arc == INVALID ? -1 : graph->id(arc));
+    }
+
+    void start(const Node& node) { record(LEMON_TRAVERSAL_START, node, INVALID); }
+    void reach(const Node& node) { record(LEMON_TRAVERSAL_REACH, node, INVALID); }
+    void discover(const Arc& arc) { record(LEMON_TRAVERSAL_DISCOVER, graph->target(arc), arc); }
+    void examine(const Arc& arc) { record(LEMON_TRAVERSAL_EXAMINE, graph->target(arc), arc); }
+    void process(const Node& node) { record(LEMON_TRAVERSAL_PROCESS, node, INVALID); }
+    void leave(const Node& node) { record(LEMON_TRAVERSAL_LEAVE, node, INVALID); }
+    void backtrack(const Arc& arc) { record(LEMON_TRAVERSAL_BACKTRACK, graph->source(arc), arc); }
+    void stop(const Node& node) { record(LEMON_TRAVERSAL_STOP, node, INVALID); }
+};
+
+// Resumable BFS or DFS that records visitor events into a ring buffer, so
+// that callers can drain them in chunks instead of taking one callback per
+// event. A read advances the traversal one step (a node for BFS, an arc for
+// DFS) at a time until flush_threshold events are buffered or the traversal
+// ends. Sources that are still unreached when the previous search runs dry
+// start a new search tree.
+class TraversalStream {
+public:
+    TraversalStream(GraphWrapper* graph_wrapper, int kind, int capacity)
+        : _graph_wrapper(graph_wrapper), _kind(kind), _ring(capacity),
+          _visitor(graph_wrapper->graph, _ring), _threshold(capacity), _next_source(0),
+          _bfs(graph_wrapper->graph, _visitor), _dfs(graph_wrapper->graph, _visitor) {}
+
+    int node_count() const { return static_cast<int>(_graph_wrapper->nodes.size()); }
+
+    void start(const int* sources, int source_count, int mask, int flush_threshold) {
+        _sources.assign(sources, sources + source_count);
+        _next_source = 0;
+        _visitor.mask = mask;
+        _threshold = static_cast<size_t>(flush_threshold);
+        _ring.clear();
+        if (_kind == LEMON_TRAVERSAL_BFS) {
+            _bfs.init();
+        } else {
+            _dfs.init();
+        }
+    }
+
+    int read(LemonTraversalEvent* events, int max_events) {
+        if (_kind == LEMON_TRAVERSAL_BFS) {
+            fill(_bfs);
+        } else {
+            fill(_dfs);
+        }
+        return _ring.pop(events, max_events);
+    }
+
+private:
+    static void step(BfsVisit<SmartDigraph, RecordingVisitor>& bfs) { bfs.processNextNode(); }
+    static void step(DfsVisit<SmartDigraph, RecordingVisitor>& dfs) { dfs.processNextArc(); }
+
+    template<typename Visit>
+    void fill(Visit& visit) {
+        while (_ring.size() < _threshold) {
+            if (visit.emptyQueue()) {
+                while (_next_source < _sources.size() &&
+                       visit.reached(_graph_wrapper->nodes[_sources[_next_source]])) {
+                    ++_next_source;
+                }
+                if (_next_source == _sources.size()) return;
+                visit.addSource(_graph_wrapper->nodes[_sources[_next_source++]]);
+            } else {
+                step(visit);
+            }
+        }
+    }
+
+    GraphWrapper* _graph_wrapper;
+    int _kind;
+    TraversalEventRing _ring;
+    RecordingVisitor _visitor;
+    size_t _threshold;
+    std::vector<int> _sources;
+    size_t _next_source;
+    BfsVisit<SmartDigraph, RecordingVisitor> _bfs;
+    DfsVisit<SmartDigraph, RecordingVisitor> _dfs;
+};
+
+// Nearest-facility (graph Voronoi) labels: for every node the closest
+// facility and the distance to it, by one Dijkstra seeded with all
+// facilities that carries an origin label along. Keys are compared as
+// (distance, facility id), so ties go to the smaller facility id and the
+// labels are unique. Adding or removing a facility repairs only the cells
+// that change: a new facility runs a search that stops wherever it does not
+// win; a removed facility's cell (its shortest path subtree) is cleared and
+// refilled from the labels on its boundary. Arc lengths and adjacency are
+// snapshots taken at construction.
+class NearestFacilityLabels {
+public:
+    NearestFacilityLabels(const CsrGraph& csr, const std::vector<double>& lengths)
+        : _csr(csr), _lengths(lengths),
+          _dist(csr.node_count, std::numeric_limits<double>::infinity()),
+          _origin(csr.node_count, -1), _pred(csr.node_count, -1),
+          _is_facility(csr.node_count, 0), _facility_count(0),
+          _heap_index(csr.node_count, Heap::PRE_HEAP), _heap(_heap_index) {}
+
+    int node_count() const { return _csr.node_count; }
+    int facility_count() const { return _facility_count; }
+    const std::vector<double>& dist() const { return _dist; }
+    const std::vector<int>& origin() const { return _origin; }
+    const std::vector<int>& pred() const { return _pred; }
+
+    // Labels all nodes with one search seeded with every facility
+    void build(const int* facilities, int facility_count) {
+        for (int i = 0; i < facility_count; ++i) {
+            int f = facilities[i];
+            if (_is_facility[f]) continue;
+            _is_facility[f] = 1;
+            ++_facility_count;
+            relax(f, 0.0, f, -1);
+        }
+        run();
+    }
+
+    // Returns the number of nodes that now take facility f, 0 if f already
+    // was a facility
+    int add(int f) {
+        if (_is_facility[f]) return 0;
+        _is_facility[f] = 1;
+        ++_facility_count;
+        relax(f, 0.0, f, -1);
+        return run();
+    }
+
+    // Returns the number of nodes that lost facility f, 0 if f was not one
+    int remove(int f) {
+        if (!_is_facility[f]) return 0;
+        _is_facility[f] = 0;
+        --_facility_count;
+        if (_origin[f] != f) return 0;  // f lost its own node to a tie
+
+        // The cell of f is its shortest path subtree: walk it along tree arcs
+        std::vector<int> cell(1, f);
+        for (size_t k = 0; k < cell.size(); ++k) {
+            int v = cell[k];
+            for (int a = _csr.out_begin[v]; a < _csr.out_begin[v + 1]; ++a) {
+                int w = _csr.out_target[a];
+                if (_pred[w] == _csr.out_arc[a] && _origin[w] == f) cell.push_back(w);
+            }
+        }
+        for (size_t k = 0; k < cell.size(); ++k) {
+            int v = cell[k];
+            _dist[v] = std::numeric_limits<double>::infinity();
+            _origin[v] = -1;
+            _pred[v] = -1;
+        }
+
+        // Refill it from the labeled nodes around it and from the facilities
+        // inside it that had lost their own node to f in a zero-length tie
+        for (size_t k = 0; k < cell.size(); ++k) {
+            int v = cell[k];
+            if (_is_facility[v]) relax(v, 0.0, v, -1);
+            for (int a = _csr.in_begin[v]; a < _csr.in_begin[v + 1]; ++a) {
+                int u = _csr.in_source[a];
+                if (_origin[u] >= 0) relax(v, _dist[u] + _lengths[_csr.in_arc[a]], _origin[u], _csr.in_arc[a]);
+            }
+        }
+        run();
+        return static_cast<int>(cell.size());
+    }
+
+private:
+    typedef std::pair<double, int> Key;  // (distance, facility)
+    typedef RangeMap<int> HeapIndex;
+    typedef BinHeap<Key, HeapIndex> Heap;
+
+    void relax(int v, double dist, int origin, int arc) {
+        if (dist > _dist[v] || (dist == _dist[v] && origin >= _origin[v])) return;
+        _dist[v] = dist;
+        _origin[v] = origin;
+        _pred[v] = arc;
+        if (_heap.state(v) == Heap::IN_HEAP) {
+            _heap.decrease(v, Key(dist, origin));
+        } else {
+            _heap.push(v, Key(dist, origin));
+        }
+    }
+
+    // Settles the queued nodes and returns how many there were
+    int run() {
+        int settled = 0;
+        while (!_heap.empty()) {
+            int v = _heap.top();
+            _heap.pop();
+            ++settled;
+            for (int a = _csr.out_begin[v]; a < _csr.out_begin[v + 1]; ++a) {
+                int arc = _csr.out_arc[a];
+                relax(_csr.out_target[a], _dist[v] + _lengths[arc], _origin[v], arc);
+            }
+        }
+        return settled;
+    }
+
+    CsrGraph _csr;
+    std::vector<double> _lengths;
+    std::vector<double> _dist;
+    std::vector<int> _origin;
+    std::vector<int> _pred;
+    std::vector<char> _is_facility;
+    int _facility_count;
+    HeapIndex _heap_index;
+    Heap _heap;
+};
+
+// Dynamic single-source shortest path tree (Ramalingam-Reps) for
+// non-negative lengths. Keeps dist/pred of one source together with a
+// snapshot of the adjacency and lengths, and repairs them after a batch of
+// arc length changes instead of recomputing the tree:
+//   - a tree arc that got longer invalidates the subtree below it; those
+//     nodes are reset and re-seeded from their in-arcs outside the subtree,
+//   - an arc that got shorter offers its target a better distance,
+// and one Dijkstra pass over the seeded nodes settles everything that
+// improves. Only the affected region is touched.
+class DynamicShortestPathTree {
+public:
+    DynamicShortestPathTree(const CsrGraph& csr, const std::vector<double>& lengths, int source)
+        : _csr(csr), _lengths(lengths), _source(source),
+          _dist(csr.node_count, std::numeric_limits<double>::infinity()), _pred(csr.node_count, -1),
+          _heap_index(csr.node_count, Heap::PRE_HEAP), _heap(_heap_index),
+          _arc_source(csr.arc_count), _arc_target(csr.arc_count),
+          _touched_mark(csr.node_count, 0), _affected(csr.node_count, 0) {
+        for (int v = 0; v < csr.node_count; ++v) {
+            for (int a = csr.out_begin[v]; a < csr.out_begin[v + 1]; ++a) {
+                _arc_source[csr.out_arc[a]] = v;
+                _arc_target[csr.out_arc[a]] = csr.out_target[a];
+            }
+        }
+    }
+
+    int node_count() const { return _csr.node_count; }
+    int arc_count() const { return _csr.arc_count; }
+    int source() const { return _source; }
+    const std::vector<double>& dist() const { return _dist; }
+    const std::vector<int>& pred() const { return _pred; }
+    const std::vector<double>& lengths() const { return _lengths; }
+
+    void build() {
+        relax(_source, 0.0, -1);
+        run();
+        for (size_t k = 0; k < _touched.size(); ++k) _touched_mark[_touched[k].node] = 0;
+        _touched.clear();
+    }
+
+    // Adopts a stored tree after checking that it is a shortest path tree
+    // of the current lengths; returns false otherwise
+    bool load(const double* dist, const int* pred) {
+        int node_count = _csr.node_count;
+        if (dist[_source] != 0.0 || pred[_source] != -1) return false;
+
+        int reached = 0;
+        for (int v = 0; v < node_count; ++v) {
+            if (std::isinf(dist[v]) && dist[v] > 0) {
+                if (pred[v] != -1) return false;
+                continue;
+            }
+            if (!(dist[v] >= 0.0)) return false;
+            ++reached;
+            if (v == _source) continue;
+            int arc = pred[v];
+            if (arc < 0 || arc >= _csr.arc_count || _arc_target[arc] != v) return false;
+            if (dist[_arc_source[arc]] + _lengths[arc] != dist[v]) return false;
+        }
+
+        // No arc may offer a shorter distance
+        for (int a = 0; a < _csr.arc_count; ++a) {
+            if (dist[_arc_source[a]] + _lengths[a] < dist[_arc_target[a]]) return false;
+        }
+
+        // The tree arcs must connect every reached node to the source
+        std::copy(dist, dist + node_count, _dist.begin());
+        std::copy(pred, pred + node_count, _pred.begin());
+        std::vector<int> order;
+        collect_subtree(_source, order);
+        for (size_t k = 0; k < order.size(); ++k) _affected[order[k]] = 0;
+        return static_cast<int>(order.size()) == reached;
+    }
+
+    // Applies the new lengths and repairs the tree. Writes the nodes whose
+    // distance or tree arc changed to changed (if not null) and returns
+    // their number.
+    int update(const int* arc_ids, const double* lengths, int count, int* changed) {
+        std::vector<double> old_lengths(count);
+        for (int i = 0; i < count; ++i) {
+            old_lengths[i] = _lengths[arc_ids[i]];
+        }
+        for (int i = 0; i < count; ++i) {
+            _lengths[arc_ids[i]] = lengths[i];
+        }
+
+        // Longer tree arcs: reset the subtrees below them
+        std::vector<int> reset;
+        for (int i = 0; i < count; ++i) {
+            int arc = arc_ids[i];
+            if (!(_lengths[arc] > old_lengths[i])) continue;
+            int v = _arc_target[arc];
+            if (_pred[v] != arc || _affected[v]) continue;
+            collect_subtree(v, reset);
+        }
+        for (size_t k = 0; k < reset.size(); ++k) {
+            int v = reset[k];
+            touch(v);
+            _dist[v] = std::numeric_limits<double>::infinity();
+            _pred[v] = -1;
+        }
+        for (size_t k = 0; k < reset.size(); ++k) {
+            int v = reset[k];
+            for (int a = _csr.in_begin[v]; a < _csr.in_begin[v + 1]; ++a) {
+                int u = _csr.in_source[a];
+                if (!_affected[u] && !std::isinf(_dist[u])) relax(v, _dist[u] + _lengths[_csr.in_arc[a]], _csr.in_arc[a]);
+            }
+        }
+        for (size_t k = 0; k < reset.size(); ++k) _affected[reset[k]] = 0;
+
+        // Shorter arcs: offer their targets the new distance
+        for (int i = 0; i < count; ++i) {
+            int arc = arc_ids[i];
+            if (!(_lengths[arc] < old_lengths[i])) continue;
+            int u = _arc_source[arc];
+            if (!std::isinf(_dist[u])) relax(_arc_target[arc], _dist[u] + _lengths[arc], arc);
+        }
+
+        run();
+
+        int changed_count = 0;
+        for (size_t k = 0; k < _touched.size(); ++k) {
+            const Touched& t = _touched[k];
+            _touched_mark[t.node] = 0;
+            if (t.dist != _dist[t.node] || t.pred != _pred[t.node]) {
+                if (changed) changed[changed_count] = t.node;
+                ++changed_count;
+            }
+        }
+        _touched.clear();
+        return changed_count;
+    }
+
+private:
+    typedef RangeMap<int> HeapIndex;
+    typedef BinHeap<double, HeapIndex> Heap;
+
+    struct Touched {
+        int node;
+        double dist;
+        int pred;
+    };
+
+    // Appends the tree nodes below root (root included) to nodes and marks
+    // them as affected
+    void collect_subtree(int root, std::vector<int>& nodes) {
+        size_t first = nodes.size();
+        nodes.push_back(root);
+        _affected[root] = 1;
+        for (size_t k = first; k < nodes.size(); ++k) {
+            int v = nodes[k];
+            for (int a = _csr.out_begin[v]; a < _csr.out_begin[v + 1]; ++a) {
+                int w = _csr.out_target[a];
+                if (_pred[w] == _csr.out_arc[a] && !_affected[w]) {
+                    _affected[w] = 1;
+                    nodes.push_back(w);
+                }
+            }
+        }
+    }
+
+    // Remembers the label of v before the first change of this update
+    void touch(int v) {
+        if (_touched_mark[v]) return;
+        _touched_mark[v] = 1;
+        Touched t = { v, _dist[v], _pred[v] };
+        _touched.push_back(t);
+    }
+
+    void relax(int v, double dist, int arc) {
+        if (!(dist < _dist[v])) return;
+        touch(v);
+        _dist[v] = dist;
+        _pred[v] = arc;
+        if (_heap.state(v) == Heap::IN_HEAP) {
+            _heap.decrease(v, dist);
+        } else {
+            _heap.push(v, dist);
+        }
+    }
+
+    void run() {
+        while (!_heap.empty()) {
+            int v = _heap.top();
+            _heap.pop();
+            for (int a = _csr.out_begin[v]; a < _csr.out_begin[v + 1]; ++a) {
+                int arc = _csr.out_arc[a];
+                relax(_csr.out_target[a], _dist[v] + _lengths[arc], arc);
+            }
+        }
+    }
+
+    CsrGraph _csr;
+    std::vector<double> _lengths;
+    int _source;
+    std::vector<double> _dist;
+    std::vector<int> _pred;
+    HeapIndex _heap_index;
+    Heap _heap;
+    std::vector<int> _arc_source;
+    std::vector<int> _arc_target;
+    std::vector<Touched> _touched;
+    std::vector<char> _touched_mark;
+    std::vector<char> _affected;
+};
+
+// Reachability index over the condensation of a digraph. Components are
+// renumbered in topological order, so u can only reach v if comp(u) <=
+// comp(v). Each component stores:
+//   - the range [reach_begin, reach_end] that holds all its descendants,
+//   - label_count GRAIL interval labels (Yildirim et al.) from randomized
+//     post-order DFS traversals; if v's interval is not nested in u's for
+//     some label, u cannot reach v,
+//   - its descendant set as a bitset over the word-aligned window of its
+//     descendant range, if that window is within the cap chosen for the
+//     byte budget. A child's window lies inside its parent's, so whenever a
+//     component has a bitset, all its descendants have one too.
+// Queries the range and label tests cannot settle are bitset lookups, or a
+// DFS over the condensation, pruned by the same tests, that stops at the
+// first components with bitsets.
+class ReachabilityIndex {
+public:
+    ReachabilityIndex() : _node_count(0), _arc_count(0), _component_count(0), _label_count(0), _bit_window(0) {}
+
+    int node_count() const { return _node_count; }
+    int arc_count() const { return _arc_count; }
+    int component_count() const { return _component_count; }
+
+    int bitset_count() const {
+        int count = 0;
+        for (int c = 0; c < _component_count; ++c) {
+            if (_reach_end[c] >= 0 && has_bitset(c)) ++count;
+        }
+        return count;
+    }
+
+    // component holds the SCC of every node, component_count of them
+    void build(const CsrGraph& csr, const std::vector<int>& component, int component_count,
+               int label_count, long long max_bitset_bytes, int thread_count) {
+        _node_count = csr.node_count;
+        _arc_count = csr.arc_count;
+        _component_count = component_count;
+        _label_count = label_count;
+
+        // Condensation arcs, deduplicated
+        std::vector<std::pair<int, int> > pairs;
+        for (int v = 0; v < csr.node_count; ++v) {
+            for (int a = csr.out_begin[v]; a < csr.out_begin[v + 1]; ++a) {
+                int cu = component[v];
+                int cw = component[csr.out_target[a]];
+                if (cu != cw) pairs.push_back(std::make_pair(cu, cw));
+            }
+        }
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        // Topological ranks (Kahn)
+        std::vector<int> in_degree(component_count, 0);
+        std::vector<int> begin(component_count + 1, 0);
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            ++in_degree[pairs[i].second];
+            ++begin[pairs[i].first + 1];
+        }
+        for (int c = 0; c < component_count; ++c) begin[c + 1] += begin[c];
+        std::vector<int> rank(component_count);
+        std::vector<int> queue;
+        queue.reserve(component_count);
+        for (int c = 0; c < component_count; ++c) {
+            if (in_degree[c] == 0) queue.push_back(c);
+        }
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int c = queue[head];
+            rank[c] = static_cast<int>(head);
+            for (int i = begin[c]; i < begin[c + 1]; ++i) {
+                if (--in_degree[pairs[i].second] == 0) queue.push_back(pairs[i].second);
+            }
+        }
+
+        _component.resize(_node_count);
+        for (int v = 0; v < _node_count; ++v) _component[v] = rank[component[v]];
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            pairs[i] = std::make_pair(rank[pairs[i].first], rank[pairs[i].second]);
+        }
+        std::sort(pairs.begin(), pairs.end());
+        _dag_begin.assign(component_count + 1, 0);
+        _dag_target.resize(pairs.size());
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            ++_dag_begin[pairs[i].first + 1];
+            _dag_target[i] = pairs[i].second;
+        }
+        for (int c = 0; c < component_count; ++c) _dag_begin[c + 1] += _dag_begin[c];
+
+        compute_layout();
+        build_labels(thread_count);
+        _bit_window = choose_bit_window(max_bitset_bytes / static_cast<long long>(sizeof(unsigned long long)));
+        build_bits(layout_bits(), thread_count);
+    }
+
+    bool can_reach(int u, int v, std::vector<int>& stamp, int& stamp_value, std::vector<int>& stack) const {
+        int cu = _component[u];
+        int cv = _component[v];
+        if (cu == cv) return true;
+        if (excluded(cu, cv)) return false;
+        if (has_bitset(cu)) return test_bit(cu, cv);
+
+        // DFS over the condensation, pruned by the label tests
+        if (stamp.empty()) stamp.assign(_component_count, 0);
+        if (++stamp_value == INT_MAX) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            stamp_value = 1;
+        }
+        stack.clear();
+        stack.push_back(cu);
+        stamp[cu] = stamp_value;
+        while (!stack.empty()) {
+            int c = stack.back();
+            stack.pop_back();
+            for (int i = _dag_begin[c]; i < _dag_begin[c + 1]; ++i) {
+                int w = _dag_target[i];
+                if (w == cv) return true;
+                if (stamp[w] == stamp_value || excluded(w, cv)) continue;
+                stamp[w] = stamp_value;
+                if (!has_bitset(w)) {
+                    stack.push_back(w);
+                } else if (test_bit(w, cv)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Answers sources[i] -> targets[i] into result[i]; returns the number of
+    // reachable pairs
+    long long query(const int* sources, const int* targets, int count, int thread_count,
+                    unsigned char* result) const {
+        int threads = std::max(1, std::min(thread_count, count / 4096));
+        std::vector<long long> reachable(threads, 0);
+        run_parallel(threads, [&](int t) {
+            std::vector<int> stamp;
+            std::vector<int> stack;
+            int stamp_value = 0;
+            int first = static_cast<int>(static_cast<long long>(count) * t / threads);
+            int last = static_cast<int>(static_cast<long long>(count) * (t + 1) / threads);
+            for (int i = first; i < last; ++i) {
+                bool reach = can_reach(sources[i], targets[i], stamp, stamp_value, stack);
+                result[i] = reach ? 1 : 0;
+                if (reach) ++reachable[t];
+            }
+        });
+
+        long long total = 0;
+        for (int t = 0; t < threads; ++t) total += reachable[t];
+        return total;
+    }
+
+    // Serialized form: counts, node components, condensation arcs, labels and
+    // bitset words; the layout is recomputed on load
+    std::vector<unsigned char> serialize() const {
+        std::vector<unsigned char> data;
+        int header[6] = { 1, _node_count, _arc_count, _component_count, _label_count,
+                          static_cast<int>(_dag_target.size()) };
+        append(data, header, 6);
+        append(data, &_bit_window, 1);
+        append(data, _component.data(), _component.size());
+        append(data, _dag_begin.data(), _dag_begin.size());
+        append(data, _dag_target.data(), _dag_target.size());
+        append(data, _low.data(), _low.size());
+        append(data, _post.data(), _post.size());
+        append(data, _bits.data(), _bits.size());
+        return data;
+    }
+
+    // Returns false if data is not a valid serialized index
+    bool deserialize(const unsigned char* data, long long size) {
+        long long offset = 0;
+        int header[6];
+        if (!read(data, size, offset, header, 6) || header[0] != 1) return false;
+        if (!read(data, size, offset, &_bit_window, 1) || _bit_window < 0) return false;
+        _node_count = header[1];
+        _arc_count = header[2];
+        _component_count = header[3];
+        _label_count = header[4];
+        int dag_arc_count = header[5];
+        if (_node_count < 0 || _arc_count < 0 || _component_count < 0 || _component_count > _node_count ||
+            _label_count < 1 || _label_count > 64 || dag_arc_count < 0) return false;
+
+        long long label_size = static_cast<long long>(_label_count) * _component_count;
+        if (size - offset < (static_cast<long long>(_node_count) + _component_count + 1 + dag_arc_count +
+                             2 * label_size) * static_cast<long long>(sizeof(int))) return false;
+        _component.resize(_node_count);
+        _dag_begin.resize(_component_count + 1);
+        _dag_target.resize(dag_arc_count);
+        _low.resize(label_size);
+        _post.resize(label_size);
+        read(data, size, offset, _component.data(), _component.size());
+        read(data, size, offset, _dag_begin.data(), _dag_begin.size());
+        read(data, size, offset, _dag_target.data(), _dag_target.size());
+        read(data, size, offset, _low.data(), _low.size());
+        read(data, size, offset, _post.data(), _post.size());
+
+        for (int v = 0; v < _node_count; ++v) {
+            if (_component[v] < 0 || _component[v] >= _component_count) return false;
+        }
+        if (_dag_begin[0] != 0 || _dag_begin[_component_count] != dag_arc_count) return false;
+        for (int c = 0; c < _component_count; ++c) {
+            if (_dag_begin[c + 1] < _dag_begin[c] || _dag_begin[c + 1] > dag_arc_count) return false;
+        }
+        for (int c = 0; c < _component_count; ++c) {
+            for (int i = _dag_begin[c]; i < _dag_begin[c + 1]; ++i) {
+                if (_dag_target[i] <= c || _dag_target[i] >= _component_count) return false;
+            }
+        }
+
+        compute_layout();
+        long long word_count = layout_bits();
+        if (size - offset != word_count * static_cast<long long>(sizeof(unsigned long long))) return false;
+        _bits.resize(word_count);
+        read(data, size, offset, _bits.data(), _bits.size());
+        return true;
+    }
+
+private:
+    // True if the range or label tests prove that component cu cannot reach
+    // cv (cu != cv)
+    bool excluded(int cu, int cv) const {
+        if (cv < _reach_begin[cu] || cv > _reach_end[cu]) return true;
+        for (int i = 0; i < _label_count; ++i) {
+            size_t base = static_cast<size_t>(i) * _component_count;
+            if (_low[base + cv] < _low[base + cu] || _post[base + cv] > _post[base + cu]) return true;
+        }
+        return false;
+    }
+
+    // Descendant ranges, heights and bitset windows from the condensation
+    void compute_layout() {
+        int component_count = _component_count;
+        _reach_begin.assign(component_count, 0);
+        _reach_end.assign(component_count, 0);
+        _height.assign(component_count, 0);
+        for (int c = component_count - 1; c >= 0; --c) {
+            int reach_begin = component_count;
+            int reach_end = -1;
+            int height = 0;
+            for (int i = _dag_begin[c]; i < _dag_begin[c + 1]; ++i) {
+                int w = _dag_target[i];
+                reach_begin = std::min(reach_begin, w);
+                reach_end = std::max(reach_end, std::max(w, _reach_end[w]));
+                height = std::max(height, _height[w] + 1);
+            }
+            _reach_begin[c] = reach_begin;
+            _reach_end[c] = reach_end;
+            _height[c] = height;
+        }
+
+        _word_first.assign(component_count, 0);
+        for (int c = 0; c < component_count; ++c) {
+            if (_reach_end[c] >= 0) _word_first[c] = _reach_begin[c] >> 6;
+        }
+    }
+
+    long long window_words(int c) const {
+        return _reach_end[c] < 0 ? 0 : (_reach_end[c] >> 6) - _word_first[c] + 1;
+    }
+
+    bool has_bitset(int c) const { return window_words(c) <= _bit_window; }
+
+    bool test_bit(int c, int v) const {
+        long long bit = v - (static_cast<long long>(_word_first[c]) << 6);
+        return ((_bits[_bits_begin[c] + (bit >> 6)] >> (bit & 63)) & 1) != 0;
+    }
+
+    // Largest window size such that the bitsets of all components with a
+    // window up to that size fit in max_words
+    long long choose_bit_window(long long max_words) const {
+        std::vector<long long> sizes(_component_count);
+        for (int c = 0; c < _component_count; ++c) sizes[c] = window_words(c);
+        std::sort(sizes.begin(), sizes.end());
+
+        long long window = 0;
+        long long total = 0;
+        for (int c = 0; c < _component_count; ++c) {
+            total += sizes[c];
+            if (total > max_words) break;
+            if (c + 1 == _component_count || sizes[c + 1] != sizes[c]) window = sizes[c];
+        }
+        return window;
+    }
+
+    // Offsets of the bitsets of the components within the window; returns
+    // the number of words
+    long long layout_bits() {
+        _bits_begin.assign(_component_count + 1, 0);
+        for (int c = 0; c < _component_count; ++c) {
+            _bits_begin[c + 1] = _bits_begin[c] + (has_bitset(c) ? window_words(c) : 0);
+        }
+        return _bits_begin[_component_count];
+    }
+
+    // One randomized post-order DFS per label, labels in parallel. Roots and
+    // out-arcs are taken from a random rotation; low is the smallest post
+    // rank below a component, so descendants get nested [low, post] ranges.
+    void build_labels(int thread_count) {
+        int component_count = _component_count;
+        size_t label_size = static_cast<size_t>(_label_count) * component_count;
+        _low.assign(label_size, 0);
+        _post.assign(label_size, 0);
+        if (component_count == 0) return;
+
+        int threads = std::max(1, std::min(thread_count, _label_count));
+        run_parallel(threads, [&](int t) {
+            std::vector<char> visited(component_count);
+            std::vector<LabelFrame> stack;
+            for (int label = t; label < _label_count; label += threads) {
+                int* low = &_low[static_cast<size_t>(label) * component_count];
+                int* post = &_post[static_cast<size_t>(label) * component_count];
+                unsigned long long state = 0x9E3779B97F4A7C15ULL * static_cast<unsigned long long>(label + 1);
+                std::fill(visited.begin(), visited.end(), 0);
+                int rank = 0;
+                int root_offset = static_cast<int>(next_random(state) % component_count);
+                for (int r = 0; r < component_count; ++r) {
+                    int root = (root_offset + r) % component_count;
+                    if (visited[root]) continue;
+                    visited[root] = 1;
+                    low[root] = INT_MAX;
+                    stack.push_back(label_frame(root, state));
+                    while (!stack.empty()) {
+                        LabelFrame& frame = stack.back();
+                        int c = frame.node;
+                        int degree = _dag_begin[c + 1] - _dag_begin[c];
+                        if (frame.next < degree) {
+                            int w = _dag_target[_dag_begin[c] + (frame.start + frame.next) % degree];
+                            ++frame.next;
+                            if (visited[w]) {
+                                // Already finished, as the condensation has no cycles
+                                low[c] = std::min(low[c], low[w]);
+                            } else {
+                                visited[w] = 1;
+                                low[w] = INT_MAX;
+                                stack.push_back(label_frame(w, state));
+                            }
+                            continue;
+                        }
+
+                        post[c] = ++rank;
+                        low[c] = std::min(low[c], post[c]);
+                        stack.pop_back();
+                        if (!stack.empty()) {
+                            int parent = stack.back().node;
+                            low[parent] = std::min(low[parent], low[c]);
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    struct LabelFrame {
+        int node;
+        int start;  // Random rotation of the out-arcs
+        int next;   // Out-arcs visited so far
+    };
+
+    LabelFrame label_frame(int c, unsigned long long& state) const {
+        int degree = _dag_begin[c + 1] - _dag_begin[c];
+        LabelFrame frame = { c, degree > 1 ? static_cast<int>(next_random(state) % degree) : 0, 0 };
+        return frame;
+    }
+
+    static unsigned long long next_random(unsigned long long& state) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+
+    // Descendant bitsets, built height by height: every child has a smaller
+    // height, and its window lies inside the parent's, so a parent ORs its
+    // children's words in place. Large levels are split across the threads;
+    // runs of small levels are done by thread 0 between two barriers.
+    void build_bits(long long word_count, int thread_count) {
+        int component_count = _component_count;
+        _bits.assign(word_count, 0);
+
+        std::vector<int> order;
+        for (int c = 0; c < component_count; ++c) {
+            if (window_words(c) > 0 && has_bitset(c)) order.push_back(c);
+        }
+        std::stable_sort(order.begin(), order.end(), HeightLess(_height));
+        int order_count = static_cast<int>(order.size());
+        std::vector<int> level_begin;
+        for (int i = 0; i < order_count; ++i) {
+            if (i == 0 || _height[order[i]] != _height[order[i - 1]]) level_begin.push_back(i);
+        }
+        level_begin.push_back(order_count);
+
+        const int parallel_level = 1024;
+        int threads = order_count < parallel_level ? 1 : std::max(1, thread_count);
+        ThreadBarrier barrier(threads);
+        run_parallel(threads, [&](int t) {
+            for (size_t level = 0; level + 1 < level_begin.size();) {
+                int first = level_begin[level];
+                int last = level_begin[level + 1];
+                if (last - first >= parallel_level) {
+                    for (int i = first + t; i < last; i += threads) fill_bits(order[i]);
+                    ++level;
+                } else {
+                    while (level + 1 < level_begin.size() && level_begin[level + 1] - level_begin[level] < parallel_level) {
+                        ++level;
+                    }
+                    if (t == 0) {
+                        for (int i = first; i < level_begin[level]; ++i) fill_bits(order[i]);
+                    }
+                }
+                barrier.wait();
+            }
+        });
+    }
+
+    struct HeightLess {
+        const std::vector<int>& height;
+        explicit HeightLess(const std::vector<int>& h) : height(h) {}
+        bool operator()(int a, int b) const { return height[a] < height[b]; }
+    };
+
+    void fill_bits(int c) {
+        unsigned long long* words = &_bits[_bits_begin[c]];
+        int word_first = _word_first[c];
+        for (int i = _dag_begin[c]; i < _dag_begin[c + 1]; ++i) {
+            int w = _dag_target[i];
+            words[(w >> 6) - word_first] |= 1ULL << (w & 63);
+            const unsigned long long* child = &_bits[_bits_begin[w]];
+            long long child_words = _bits_begin[w + 1] - _bits_begin[w];
+            int offset = _word_first[w] - word_first;
+            for (long long k = 0; k < child_words; ++k) words[offset + k] |= child[k];
+        }
+    }
+
+    template<typename T>
+    static void append(std::vector<unsigned char>& data, const T* values, size_t count) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+        data.insert(data.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    template<typename T>
+    static bool read(const unsigned char* data, long long size, long long& offset, T* values, size_t count) {
+        long long bytes = static_cast<long long>(count * sizeof(T));
+        if (size - offset < bytes) return false;
+        if (bytes > 0) memcpy(values, data + offset, static_cast<size_t>(bytes));
+        offset += bytes;
+        return true;
+    }
+
+    int _node_count;
+    int _arc_count;
+    int _component_count;
+    int _label_count;
+    long long _bit_window;            // Components with windows up to this many words have bitsets
+    std::vector<int> _component;      // Topological component id of every node
+    std::vector<int> _dag_begin;      // Condensation arcs, grouped by source component
+    std::vector<int> _dag_target;
+    std::vector<int> _low;            // label_count rows of component_count entries
+    std::vector<int> _post;
+    std::vector<int> _reach_begin;    // Smallest and largest descendant (end < begin if none)
+    std::vector<int> _reach_end;
+    std::vector<int> _height;         // Longest path to a sink
+    std::vector<int> _word_first;     // Global index of the first word of each window
+    std::vector<long long> _bits_begin;  // component_count + 1 offsets into _bits
+    std::vector<unsigned long long> _bits;
+};
+
+// Copies arc ids into a PathResult
+static PathResult* create_path_result(const std::vector<int>& arc_ids) {
+    PathResult* result = static_cast<PathResult*>(malloc(sizeof(PathResult)));
+    if (!result) return nullptr;
+
+    result->count = static_cast<int>(arc_ids.size());
+    result->arc_ids = nullptr;
+
+    if (result->count > 0) {
+        result->arc_ids = static_cast<int*>(malloc(sizeof(int) * result->count));
+        if (!result->arc_ids) {
+            free(result);
+            return nullptr;
+        }
+        memcpy(result->arc_ids, arc_ids.data(), sizeof(int) * result->count);
+    }
+
+    return result;
+}
+
+// Writes a cycle into the caller's buffer, truncated to its capacity
+static void copy_cycle(const std::vector<int>& cycle, int* cycle_arcs, int cycle_capacity,
+                       int* cycle_length) {
+    if (cycle_length) *cycle_length = static_cast<int>(cycle.size());
+    if (!cycle_arcs) return;
+
+    int count = std::min(cycle_capacity, static_cast<int>(cycle.size()));
+    for (int i = 0; i < count; ++i) {
+        cycle_arcs[i] = cycle[i];
+    }
+}
+
+// Arc ids of the tree path to target, read from an algorithm's predecessor arcs
+template <typename Digraph, typename Algorithm>
+static std::vector<int> pred_path_arcs(const Digraph& g, const Algorithm& alg,
+                                       typename Digraph::Node target) {
+    std::vector<int> arcs;
+    for (typename Digraph::Arc arc = alg.predArc(target); arc != INVALID; arc = alg.predArc(g.source(arc))) {
+        arcs.push_back(SmartDigraph::id(arc));
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    return arcs;
+}
+
+// Result for a target that cannot be reached
+static ShortestPathResult* create_unreached_result() {
+    ShortestPathResult* result = static_cast<ShortestPathResult*>(malloc(sizeof(ShortestPathResult)));
+    if (!result) return nullptr;
+
+    result->distance = std::numeric_limits<double>::infinity();
+    result->path = nullptr;
+    result->reached = 0;
+    result->negative_cycle = 0;
+    return result;
+}
+
+// Whether a node is part of the graph or view. The algorithms only initialize
+// the labels of visible nodes, so those of hidden ones must not be read.
+static bool has_node(const SmartDigraph&, SmartDigraph::Node) { return true; }
+static bool has_node(const MaskedDigraph& g, SmartDigraph::Node node) { return g.status(node); }
+
+// Dijkstra from source to target on the whole graph or a masked view of it
+template <typename Digraph>
+static ShortestPathResult* run_dijkstra(const Digraph& g, const SmartDigraph::ArcMap<double>& lengths,
+                                        SmartDigraph::Node source, SmartDigraph::Node target) {
+    typedef Dijkstra<Digraph, SmartDigraph::ArcMap<double>> DijkstraAlg;
+    DijkstraAlg dijkstra(g, lengths);
+    
+    dijkstra.run(source, target);
+    
+    ShortestPathResult* result = create_unreached_result();
+    if (!result) return nullptr;
+    
+    if (has_node(g, target) && dijkstra.reached(target)) {
+        result->reached = 1;
+        result->distance = dijkstra.dist(target);
+        result->path = create_path_result(pred_path_arcs(g, dijkstra, target));
+    }
+    
+    return result;
+}
+
+// LEMON Bellman-Ford rounds on the whole graph or a masked view of it
+template <typename Digraph>
+static ShortestPathResult* run_bellman_ford_rounds(const Digraph& g, const SmartDigraph::ArcMap<double>& lengths,
+                                                   SmartDigraph::Node source, SmartDigraph::Node target,
+                                                   std::vector<int>& cycle) {
+    typedef BellmanFord<Digraph, SmartDigraph::ArcMap<double>> BellmanFordAlg;
+    BellmanFordAlg bellman_ford(g, lengths);
+
+    bellman_ford.init();
+    bellman_ford.addSource(source);
+    bool has_negative_cycle = !bellman_ford.checkedStart();
+
+    ShortestPathResult* result = create_unreached_result();
+    if (!result) return nullptr;
+
+    result->negative_cycle = has_negative_cycle ? 1 : 0;
+    if (!has_negative_cycle && has_node(g, target) && bellman_ford.reached(target)) {
+        result->reached = 1;
+        result->distance = bellman_ford.dist(target);
+        result->path = create_path_result(pred_path_arcs(g, bellman_ford, target));
+    }
+
+    if (has_negative_cycle) {
+        // The predecessor graph may need a few more rounds to close the cycle
+        Path<Digraph> negative_cycle = bellman_ford.negativeCycle();
+        for (int i = 0; negative_cycle.empty() && i < countNodes(g); ++i) {
+            bellman_ford.processNextWeakRound();
+            negative_cycle = bellman_ford.negativeCycle();
+        }
+        for (typename Path<Digraph>::ArcIt it(negative_cycle); it != INVALID; ++it) {
+            cycle.push_back(SmartDigraph::id(it));
+        }
+    }
+
+    return result;
+}
+
+// Read-only arc map over one scenario's column of a value block. Solvers
+// keep a reference to it, so moving it to the next column re-targets them.
+class ScenarioValueMap {
+public:
+    typedef SmartDigraph::Arc Key;
+    typedef long long Value;
+
+    ScenarioValueMap() : _values(nullptr) {}
+
+    void column(const long long* values) { _values = values; }
+
+    Value operator[](const Key& arc) const { return _values[SmartDigraph::id(arc)]; }
+
+private:
+    const long long* _values;
+};
+
+// Solves one graph under many capacity or length vectors. Each thread owns
+// one solver instance over the shared graph and takes the next scenario from
+// a shared counter; only the value map changes between its solves.
+class ScenarioBatch {
+public:
+    ScenarioBatch(const SmartDigraph& graph, int algorithm, int source, int target,
+                  const long long* values, int scenario_count)
+        : _graph(graph), _algorithm(algorithm), _source(graph.nodeFromId(source)),
+          _target(graph.nodeFromId(target)), _values(values), _scenario_count(scenario_count),
+          _arc_count(countArcs(graph)), _next(0), _failed(false) {}
+
+    // Writes each scenario's objective and, if arc_results is not null, its
+    // per-arc results. False if a scenario holds a negative value.
+    bool run(int thread_count, long long* objectives, long long* arc_results) {
+        int threads = std::max(1, std::min(resolve_thread_count(thread_count), _scenario_count));
+        run_parallel(threads, [&](int) {
+            switch (_algorithm) {
+            case LEMON_SCENARIO_PREFLOW:
+                solve_flows<Preflow<SmartDigraph, ScenarioValueMap> >(objectives, arc_results);
+                break;
+            case LEMON_SCENARIO_EDMONDS_KARP:
+                solve_flows<EdmondsKarp<SmartDigraph, ScenarioValueMap> >(objectives, arc_results);
+                break;
+            default:
+                solve_paths(objectives, arc_results);
+                break;
+            }
+        });
+        return !_failed;
+    }
+
+private:
+    // Claims the next scenario and points the value map at its column; -1
+    // once all are taken. A scenario with negative values is reported and
+    // skipped.
+    int next_scenario(ScenarioValueMap& values, long long* objectives) {
+        while (true) {
+            int k = _next.fetch_add(1);
+            if (k >= _scenario_count) return -1;
+
+            const long long* column = _values + static_cast<size_t>(k) * _arc_count;
+            bool valid = true;
+            for (int a = 0; a < _arc_count; ++a) {
+                if (column[a] < 0) valid = false;
+            }
+            if (valid) {
+                values.column(column);
+                return k;
+            }
+
+            objectives[k] = -1;
+            _failed = true;
+        }
+    }
+
+    template <typename Algorithm>
+    void solve_flows(long long* objectives, long long* arc_results) {
+        ScenarioValueMap capacity;
+        Algorithm alg(_graph, capacity, _source, _target);
+
+        for (int k; (k = next_scenario(capacity, objectives)) >= 0; ) {
+            if (arc_results) {
+                alg.run();
+                long long* flows = arc_results + static_cast<size_t>(k) * _arc_count;
+                for (int a = 0; a < _arc_count; ++a) {
+                    flows[a] = alg.flow(_graph.arcFromId(a));
+                }
+            } else {
+                run_flow_value(alg);
+            }
+            objectives[k] = alg.flowValue();
+        }
+    }
+
+    // Preflow knows the flow value after its first phase
+    static void run_flow_value(Preflow<SmartDigraph, ScenarioValueMap>& alg) { alg.runMinCut(); }
+    static void run_flow_value(EdmondsKarp<SmartDigraph, ScenarioValueMap>& alg) { alg.run(); }
+
+    void solve_paths(long long* objectives, long long* arc_results) {
+        ScenarioValueMap length;
+        Dijkstra<SmartDigraph, ScenarioValueMap> dijkstra(_graph, length);
+
+        for (int k; (k = next_scenario(length, objectives)) >= 0; ) {
+            dijkstra.run(_source, _target);
+            bool reached = dijkstra.reached(_target);
+            objectives[k] = reached ? dijkstra.dist(_target) : std::numeric_limits<long long>::max();
+
+            if (arc_results) {
+                long long* on_path = arc_results + static_cast<size_t>(k) * _arc_count;
+                std::fill(on_path, on_path + _arc_count, 0LL);
+                if (reached) {
+                    std::vector<int> path = pred_path_arcs(_graph, dijkstra, _target);
+                    for (size_t i = 0; i < path.size(); ++i) on_path[path[i]] = 1;
+                }
+            }
+        }
+    }
+
+    const SmartDigraph& _graph;
+    int _algorithm;
+    SmartDigraph::Node _source;
+    SmartDigraph::Node _target;
+    const long long* _values;
+    int _scenario_count;
+    int _arc_count;
+    std::atomic<int> _next;
+    std::atomic<bool> _failed;
+};
+
+extern "C" {
+
+LEMON_API LemonGraph lemon_create_graph() {
+    return new GraphWrapper();
+}
+
+LEMON_API void lemon_destroy_graph(LemonGraph graph) {
+    if (graph) {
+        delete static_cast<GraphWrapper*>(graph);
+    }
+}
+
+LEMON_API int lemon_add_node(LemonGraph graph) {
+    if (!graph) return -1;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    SmartDigraph::Node node = wrapper->graph.addNode();
+    wrapper->nodes.push_back(node);
+    return static_cast<int>(wrapper->nodes.size() - 1);
+}
+
+LEMON_API int lemon_add_arc(LemonGraph graph, int source, int target) {
+    if (!graph) return -1;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    
+    if (source < 0 || source >= static_cast<int>(wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(wrapper->nodes.size())) {
+        return -1;
+    }
+    
+    SmartDigraph::Arc arc = wrapper->graph.addArc(
+        wrapper->nodes[source], 
+        wrapper->nodes[target]
+    );
+    wrapper->arcs.push_back(arc);
+    return static_cast<int>(wrapper->arcs.size() - 1);
+}
+
+LEMON_API int lemon_arc_source(LemonGraph graph, int arc_id) {
+    if (!graph) return -1;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    
+    if (arc_id < 0 || arc_id >= static_cast<int>(wrapper->arcs.size())) {
+        return -1;
+    }
+    
+    SmartDigraph::Node source = wrapper->graph.source(wrapper->arcs[arc_id]);
+    
+    // Find the node index
+    for (size_t i = 0; i < wrapper->nodes.size(); ++i) {
+        if (wrapper->nodes[i] == source) {
+            return static_cast<int>(i);
+        }
+    }
+    
+    return -1;
+}
+
+LEMON_API int lemon_arc_target(LemonGraph graph, int arc_id) {
+    if (!graph) return -1;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    
+    if (arc_id < 0 || arc_id >= static_cast<int>(wrapper->arcs.size())) {
+        return -1;
+    }
+    
+    SmartDigraph::Node target = wrapper->graph.target(wrapper->arcs[arc_id]);
+    
+    // Find the node index
+    for (size_t i = 0; i < wrapper->nodes.size(); ++i) {
+        if (wrapper->nodes[i] == target) {
+            return static_cast<int>(i);
+        }
+    }
+    
+    return -1;
+}
+
+LEMON_API int lemon_node_count(LemonGraph graph) {
+    if (!graph) return 0;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    return static_cast<int>(wrapper->nodes.size());
+}
+
+LEMON_API int lemon_arc_count(LemonGraph graph) {
+    if (!graph) return 0;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    return static_cast<int>(wrapper->arcs.size());
+}
+
+
+// Undirected graph operations
+LEMON_API LemonUGraph lemon_create_ugraph() {
+    return new UGraphWrapper();
+}
+
+LEMON_API void lemon_destroy_ugraph(LemonUGraph graph) {
+    if (graph) {
+        delete static_cast<UGraphWrapper*>(graph);
+    }
+}
+
+LEMON_API int lemon_ugraph_add_nodes(LemonUGraph graph, int count) {
+    if (!graph || count < 0) return -1;
+
+    UGraphWrapper* wrapper = static_cast<UGraphWrapper*>(graph);
+    int first = static_cast<int>(wrapper->nodes.size());
+    wrapper->graph.reserveNode(first + count);
+    wrapper->nodes.reserve(first + count);
+    for (int i = 0; i < count; ++i) {
+        wrapper->nodes.push_back(wrapper->graph.addNode());
+    }
+    return first;
+}
+
+LEMON_API int lemon_ugraph_add_edges(LemonUGraph graph, const int* u, const int* v, int count) {
+    if (!graph || count < 0 || (count > 0 && (!u || !v))) return -1;
+
+    UGraphWrapper* wrapper = static_cast<UGraphWrapper*>(graph);
+    int node_count = static_cast<int>(wrapper->nodes.size());
+    for (int i = 0; i < count; ++i) {
+        if (u[i] < 0 || u[i] >= node_count || v[i] < 0 || v[i] >= node_count) {
+            return -1;
+        }
+    }
+
+    int first = static_cast<int>(wrapper->edges.size());
+    wrapper->graph.reserveEdge(first + count);
+    wrapper->edges.reserve(first + count);
+    for (int i = 0; i < count; ++i) {
+        wrapper->edges.push_back(wrapper->graph.addEdge(wrapper->nodes[u[i]], wrapper->nodes[v[i]]));
+    }
+    return first;
+}
+
+LEMON_API int lemon_edge_u(LemonUGraph graph, int edge) {
+    if (!graph) return -1;
+
+    UGraphWrapper* wrapper = static_cast<UGraphWrapper*>(graph);
+    if (edge < 0 || edge >= static_cast<int>(wrapper->edges.size())) return -1;
+
+    return wrapper->graph.id(wrapper->graph.u(wrapper->edges[edge]));
+}
+
+LEMON_API int lemon_edge_v(LemonUGraph graph, int edge) {
+    if (!graph) return -1;
+
+    UGraphWrapper* wrapper = static_cast<UGraphWrapper*>(graph);
+    if (edge < 0 || edge >= static_cast<int>(wrapper->edges.size())) return -1;
+
+    return wrapper->graph.id(wrapper->graph.v(wrapper->edges[edge]));
+}
+
+LEMON_API int lemon_ugraph_node_count(LemonUGraph graph) {
+    if (!graph) return 0;
+    return static_cast<int>(static_cast<UGraphWrapper*>(graph)->nodes.size());
+}
+
+LEMON_API int lemon_ugraph_edge_count(LemonUGraph graph) {
+    if (!graph) return 0;
+    return static_cast<int>(static_cast<UGraphWrapper*>(graph)->edges.size());
+}
+
+// Edge map operations
+LEMON_API LemonEdgeMap lemon_create_edge_map_long(LemonUGraph graph) {
+    if (!graph) return nullptr;
+    return new EdgeMapWrapper(static_cast<UGraphWrapper*>(graph), MapType::LONG);
+}
+
+LEMON_API LemonEdgeMap lemon_create_edge_map_double(LemonUGraph graph) {
+    if (!graph) return nullptr;
+    return new EdgeMapWrapper(static_cast<UGraphWrapper*>(graph), MapType::DOUBLE);
+}
+
+LEMON_API void lemon_destroy_edge_map(LemonEdgeMap map) {
+    if (map) {
+        delete static_cast<EdgeMapWrapper*>(map);
+    }
+}
+
+LEMON_API void lemon_set_edge_value_long(LemonEdgeMap map, int edge, long long value) {
+    if (!map) return;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::LONG) return;
+    if (edge < 0 || edge >= static_cast<int>(wrapper->graph_wrapper->edges.size())) return;
+
+    (*(wrapper->long_map))[wrapper->graph_wrapper->edges[edge]] = static_cast<long>(value);
+}
+
+LEMON_API long long lemon_get_edge_value_long(LemonEdgeMap map, int edge) {
+    if (!map) return 0;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::LONG) return 0;
+    if (edge < 0 || edge >= static_cast<int>(wrapper->graph_wrapper->edges.size())) return 0;
+
+    return (*(wrapper->long_map))[wrapper->graph_wrapper->edges[edge]];
+}
+
+LEMON_API void lemon_set_edge_value_double(LemonEdgeMap map, int edge, double value) {
+    if (!map) return;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::DOUBLE) return;
+    if (edge < 0 || edge >= static_cast<int>(wrapper->graph_wrapper->edges.size())) return;
+
+    (*(wrapper->double_map))[wrapper->graph_wrapper->edges[edge]] = value;
+}
+
+LEMON_API double lemon_get_edge_value_double(LemonEdgeMap map, int edge) {
+    if (!map) return 0.0;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::DOUBLE) return 0.0;
+    if (edge < 0 || edge >= static_cast<int>(wrapper->graph_wrapper->edges.size())) return 0.0;
+
+    return (*(wrapper->double_map))[wrapper->graph_wrapper->edges[edge]];
+}
+
+LEMON_API int lemon_edge_map_read_long(LemonEdgeMap map, int first_edge, long long* values, int count) {
+    if (!map || !values) return -1;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::LONG) return -1;
+    if (first_edge < 0 || count < 0 ||
+        first_edge + count > static_cast<int>(wrapper->graph_wrapper->edges.size())) return -1;
+
+    const SmartGraph::EdgeMap<long>& m = *(wrapper->long_map);
+    for (int i = 0; i < count; ++i) {
+        values[i] = m[wrapper->graph_wrapper->edges[first_edge + i]];
+    }
+    return count;
+}
+
+LEMON_API int lemon_edge_map_write_long(LemonEdgeMap map, int first_edge, const long long* values, int count) {
+    if (!map || !values) return -1;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::LONG) return -1;
+    if (first_edge < 0 || count < 0 ||
+        first_edge + count > static_cast<int>(wrapper->graph_wrapper->edges.size())) return -1;
+
+    SmartGraph::EdgeMap<long>& m = *(wrapper->long_map);
+    for (int i = 0; i < count; ++i) {
+        m.set(wrapper->graph_wrapper->edges[first_edge + i], static_cast<long>(values[i]));
+    }
+    return count;
+}
+
+LEMON_API int lemon_edge_map_read_double(LemonEdgeMap map, int first_edge, double* values, int count) {
+    if (!map || !values) return -1;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::DOUBLE) return -1;
+    if (first_edge < 0 || count < 0 ||
+        first_edge + count > static_cast<int>(wrapper->graph_wrapper->edges.size())) return -1;
+
+    const SmartGraph::EdgeMap<double>& m = *(wrapper->double_map);
+    for (int i = 0; i < count; ++i) {
+        values[i] = m[wrapper->graph_wrapper->edges[first_edge + i]];
+    }
+    return count;
+}
+
+LEMON_API int lemon_edge_map_write_double(LemonEdgeMap map, int first_edge, const double* values, int count) {
+    if (!map || !values) return -1;
+
+    EdgeMapWrapper* wrapper = static_cast<EdgeMapWrapper*>(map);
+    if (wrapper->type != MapType::DOUBLE) return -1;
+    if (first_edge < 0 || count < 0 ||
+        first_edge + count > static_cast<int>(wrapper->graph_wrapper->edges.size())) return -1;
+
+    SmartGraph::EdgeMap<double>& m = *(wrapper->double_map);
+    for (int i = 0; i < count; ++i) {
+        m.set(wrapper->graph_wrapper->edges[first_edge + i], values[i]);
+    }
+    return count;
+}
+
+// Arc map operations - long values
+LEMON_API LemonArcMap lemon_create_arc_map_long(LemonGraph graph) {
+    if (!graph) return nullptr;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    return new ArcMapWrapper(wrapper, MapType::LONG);
+}
+
+// Arc map operations - double values
+LEMON_API LemonArcMap lemon_create_arc_map_double(LemonGraph graph) {
+    if (!graph) return nullptr;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    return new ArcMapWrapper(wrapper, MapType::DOUBLE);
+}
+
+LEMON_API void lemon_destroy_arc_map(LemonArcMap map) {
+    if (map) {
+        delete static_cast<ArcMapWrapper*>(map);
+    }
+}
+
+LEMON_API void lemon_set_arc_value_long(LemonArcMap map, int arc, long long value) {
+    if (!map) return;
+    
+    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
+    
+    if (wrapper->type != MapType::LONG) return;
+    
+    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
+        return;
+    }
+    
+    (*(wrapper->long_map))[wrapper->graph_wrapper->arcs[arc]] = value;
+}
+
+LEMON_API long long lemon_get_arc_value_long(LemonArcMap map, int arc) {
+    if (!map) return 0;
+    
+    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
+    
+    if (wrapper->type != MapType::LONG) return 0;
+    
+    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
+        return 0;
+    }
+    
+    return (*(wrapper->long_map))[wrapper->graph_wrapper->arcs[arc]];
+}
+
+LEMON_API void lemon_set_arc_value_double(LemonArcMap map, int arc, double value) {
+    if (!map) return;
+    
+    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
+    
+    if (wrapper->type != MapType::DOUBLE) return;
+    
+    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
+        return;
+    }
+    
+    (*(wrapper->double_map))[wrapper->graph_wrapper->arcs[arc]] = value;
+}
+
+LEMON_API double lemon_get_arc_value_double(LemonArcMap map, int arc) {
+    if (!map) return 0.0;
+    
+    ArcMapWrapper* wrapper = static_cast<ArcMapWrapper*>(map);
+    
+    if (wrapper->type != MapType::DOUBLE) return 0.0;
+    
+    if (arc < 0 || arc >= static_cast<int>(wrapper->graph_wrapper->arcs.size())) {
+        return 0.0;
+    }
+    
+    return (*(wrapper->double_map))[wrapper->graph_wrapper->arcs[arc]];
+}
+
+LEMON_API long long lemon_edmonds_karp(LemonGraph graph, LemonArcMap capacity_map,
+                                   int source, int target, 
+                                   FlowResult** flow_results, int* flow_count) {
+    return lemon_edmonds_karp_masked(graph, capacity_map, source, target, nullptr, nullptr,
+                                     flow_results, flow_count);
+}
+
+LEMON_API long long lemon_edmonds_karp_masked(LemonGraph graph, LemonArcMap capacity_map,
+                                              int source, int target,
+                                              const unsigned long long* arc_mask,
+                                              const unsigned long long* node_mask,
+                                              FlowResult** flow_results, int* flow_count) {
+    typedef EdmondsKarp<SmartDigraph, SmartDigraph::ArcMap<long>> EK;
+    typedef EdmondsKarp<MaskedDigraph, SmartDigraph::ArcMap<long>> MaskedEK;
+    return run_max_flow_algorithm<EK, MaskedEK>(graph, capacity_map, source, target,
+                                                arc_mask, node_mask, flow_results, flow_count);
+}
+
+LEMON_API void lemon_free_results(FlowResult* results) {
+    if (results) {
+        free(results);
+    }
+}
+
+LEMON_API long long lemon_preflow(LemonGraph graph, LemonArcMap capacity_map,
+                              int source, int target,
+                              FlowResult** flow_results, int* flow_count) {
+    return lemon_preflow_masked(graph, capacity_map, source, target, nullptr, nullptr,
+                                flow_results, flow_count);
+}
+
+LEMON_API long long lemon_preflow_masked(LemonGraph graph, LemonArcMap capacity_map,
+                                         int source, int target,
+                                         const unsigned long long* arc_mask,
+                                         const unsigned long long* node_mask,
+                                         FlowResult** flow_results, int* flow_count) {
+    typedef Preflow<SmartDigraph, SmartDigraph::ArcMap<long>> PF;
+    typedef Preflow<MaskedDigraph, SmartDigraph::ArcMap<long>> MaskedPF;
+    return run_max_flow_algorithm<PF, MaskedPF>(graph, capacity_map, source, target,
+                                                arc_mask, node_mask, flow_results, flow_count);
+}
+
+// Node map operations
+LEMON_API LemonNodeMap lemon_create_node_map_double(LemonGraph graph) {
+    if (!graph) return nullptr;
+    
+    GraphWrapper* wrapper = static_cast<GraphWrapper*>(graph);
+    return new NodeMapWrapper(wrapper);
+}
+
+LEMON_API void lemon_destroy_node_map(LemonNodeMap map) {
+    if (map) {
+        delete static_cast<NodeMapWrapper*>(map);
+    }
+}
+
+LEMON_API void lemon_set_node_value_double(LemonNodeMap map, int node, double value) {
+    if (!map) return;
+    
+    NodeMapWrapper* wrapper = static_cast<NodeMapWrapper*>(map);
     
     if (node < 0 || node >= static_cast<int>(wrapper->graph_wrapper->nodes.size())) {
         return;
     }
-    
-    (*(wrapper->map))[wrapper->graph_wrapper->nodes[node]] = value;
+    
+    (*(wrapper->map))[wrapper->graph_wrapper->nodes[node]] = value;
+}
+
+LEMON_API double lemon_get_node_value_double(LemonNodeMap map, int node) {
+    if (!map) return 0.0;
+    
+    NodeMapWrapper* wrapper = static_cast<NodeMapWrapper*>(map);
+    
+    if (node < 0 || node >= static_cast<int>(wrapper->graph_wrapper->nodes.size())) {
+        return 0.0;
+    }
+    
+    return (*(wrapper->map))[wrapper->graph_wrapper->nodes[node]];
+}
+
+// Shortest path algorithms
+LEMON_API ShortestPathResult* lemon_dijkstra(LemonGraph graph, LemonArcMap length_map,
+                                             int source, int target) {
+    return lemon_dijkstra_masked(graph, length_map, source, target, nullptr, nullptr);
+}
+
+LEMON_API ShortestPathResult* lemon_dijkstra_masked(LemonGraph graph, LemonArcMap length_map,
+                                                    int source, int target,
+                                                    const unsigned long long* arc_mask,
+                                                    const unsigned long long* node_mask) {
+    if (!graph || !length_map) return nullptr;
+    
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+    
+    if (length_wrapper->type != MapType::DOUBLE) return nullptr;
+    
+    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+        return nullptr;
+    }
+    
+    const SmartDigraph::ArcMap<double>& lengths = *(length_wrapper->double_map);
+    SmartDigraph::Node s = graph_wrapper->nodes[source];
+    SmartDigraph::Node t = graph_wrapper->nodes[target];
+    if (!arc_mask && !node_mask) {
+        return run_dijkstra(graph_wrapper->graph, lengths, s, t);
+    }
+    
+    // The view hides arcs into disabled nodes but not out of them
+    BitMaskMap<SmartDigraph::Node> node_filter(node_mask);
+    BitMaskMap<SmartDigraph::Arc> arc_filter(arc_mask);
+    if (!node_filter[s]) return create_unreached_result();
+    
+    MaskedDigraph masked(graph_wrapper->graph, node_filter, arc_filter);
+    return run_dijkstra(masked, lengths, s, t);
+}
+
+// Distance-bounded Dijkstra: LEMON's Dijkstra driven step by step, stopping
+// as soon as the closest node in the heap lies beyond the bound
+LEMON_API int lemon_dijkstra_bounded(LemonGraph graph, LemonArcMap length_map,
+                                     const int* sources, int source_count, double bound,
+                                     int* node_ids, double* dist, int* pred, int capacity) {
+    if (!graph || !length_map || source_count < 0 || (source_count > 0 && !sources)) return -2;
+    if (capacity < 0 || (capacity > 0 && (!node_ids || !dist || !pred)) || std::isnan(bound)) return -2;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+    if (length_wrapper->type != MapType::DOUBLE) return -2;
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    for (int i = 0; i < source_count; ++i) {
+        if (sources[i] < 0 || sources[i] >= node_count) return -2;
+    }
+
+    const SmartDigraph& g = graph_wrapper->graph;
+    const SmartDigraph::ArcMap<double>& lengths = *(length_wrapper->double_map);
+    typedef Dijkstra<SmartDigraph, SmartDigraph::ArcMap<double>> DijkstraAlg;
+    DijkstraAlg dijkstra(g, lengths);
+
+    dijkstra.init();
+    if (bound >= 0) {
+        for (int i = 0; i < source_count; ++i) {
+            dijkstra.addSource(graph_wrapper->nodes[sources[i]]);
+        }
+    }
+
+    int count = 0;
+    while (!dijkstra.emptyQueue()) {
+        SmartDigraph::Node node = dijkstra.nextNode();
+        double distance = dijkstra.currentDist(node);
+        if (distance > bound) break;
+
+        // Only the arcs leaving settled nodes are relaxed, so only they are
+        // checked and the search stays local to the bound
+        for (SmartDigraph::OutArcIt a(g, node); a != INVALID; ++a) {
+            if (!(lengths[a] >= 0.0)) return -2;  // negative or NaN
+        }
+        if (count == capacity) return -1;
+
+        dijkstra.processNextNode();
+        SmartDigraph::Arc arc = dijkstra.predArc(node);
+        node_ids[count] = g.id(node);
+        dist[count] = distance;
+        pred[count] = arc == INVALID ? -1 : g.id(arc);
+        ++count;
+    }
+    return count;
+}
+
+LEMON_API ShortestPathResult* lemon_bellman_ford(LemonGraph graph, LemonArcMap length_map,
+                                                 int source, int target) {
+    if (!graph || !length_map) return nullptr;
+    
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+    
+    if (length_wrapper->type != MapType::DOUBLE) return nullptr;
+    
+    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+        return nullptr;
+    }
+    
+    typedef BellmanFord<SmartDigraph, SmartDigraph::ArcMap<double>> BellmanFordAlg;
+    BellmanFordAlg bellman_ford(graph_wrapper->graph, *(length_wrapper->double_map));
+    
+    bellman_ford.init();
+    bellman_ford.addSource(graph_wrapper->nodes[source]);
+    bool has_negative_cycle = !bellman_ford.checkedStart();
+    
+    ShortestPathResult* result = static_cast<ShortestPathResult*>(malloc(sizeof(ShortestPathResult)));
+    if (!result) return nullptr;
+    
+    result->negative_cycle = has_negative_cycle ? 1 : 0;
+    result->reached = (!has_negative_cycle && bellman_ford.reached(graph_wrapper->nodes[target])) ? 1 : 0;
+    
+    if (result->reached && !has_negative_cycle) {
+        result->distance = bellman_ford.dist(graph_wrapper->nodes[target]);
+        result->path = create_path_result(bellman_ford.path(graph_wrapper->nodes[target]));
+    } else {
+        result->distance = std::numeric_limits<double>::infinity();
+        result->path = nullptr;
+    }
+    
+    return result;
+}
+
+LEMON_API ShortestPathResult* lemon_bellman_ford_ex(LemonGraph graph, LemonArcMap length_map,
+                                                   int source, int target, int mode,
+                                                   int thread_count,
+                                                   int* cycle_arcs, int cycle_capacity,
+                                                   int* cycle_length) {
+    return lemon_bellman_ford_masked(graph, length_map, source, target, mode, thread_count,
+                                     nullptr, nullptr, cycle_arcs, cycle_capacity, cycle_length);
+}
+
+LEMON_API ShortestPathResult* lemon_bellman_ford_masked(LemonGraph graph, LemonArcMap length_map,
+                                                        int source, int target, int mode,
+                                                        int thread_count,
+                                                        const unsigned long long* arc_mask,
+                                                        const unsigned long long* node_mask,
+                                                        int* cycle_arcs, int cycle_capacity,
+                                                        int* cycle_length) {
+    if (cycle_length) *cycle_length = 0;
+    if (!graph || !length_map || cycle_capacity < 0) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return nullptr;
+
+    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+        return nullptr;
+    }
+
+    if (mode != LEMON_BELLMAN_FORD_ROUNDS && mode != LEMON_BELLMAN_FORD_QUEUE &&
+        mode != LEMON_BELLMAN_FORD_EDGE_LIST) {
+        return nullptr;
+    }
+
+    const SmartDigraph& g = graph_wrapper->graph;
+    bool masked = arc_mask || node_mask;
+    BitMaskMap<SmartDigraph::Node> node_filter(node_mask);
+    BitMaskMap<SmartDigraph::Arc> arc_filter(arc_mask);
+
+    // Nothing is reachable from a disabled source, not even a negative cycle
+    if (!node_filter[graph_wrapper->nodes[source]]) return create_unreached_result();
+
+    ShortestPathResult* result = nullptr;
+    std::vector<int> cycle;
+
+    if (mode == LEMON_BELLMAN_FORD_ROUNDS) {
+        const SmartDigraph::ArcMap<double>& lengths = *(length_wrapper->double_map);
+        SmartDigraph::Node s = graph_wrapper->nodes[source];
+        SmartDigraph::Node t = graph_wrapper->nodes[target];
+        if (masked) {
+            MaskedDigraph view(g, node_filter, arc_filter);
+            result = run_bellman_ford_rounds(view, lengths, s, t, cycle);
+        } else {
+            result = run_bellman_ford_rounds(g, lengths, s, t, cycle);
+        }
+        if (!result) return nullptr;
+    } else {
+        // The flat variants see masked-out arcs, and arcs at disabled nodes,
+        // as infinitely long, so they are never relaxed
+        const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+        std::vector<double> lengths(graph_wrapper->arcs.size());
+        for (size_t a = 0; a < lengths.size(); ++a) {
+            SmartDigraph::Arc arc = graph_wrapper->arcs[a];
+            bool enabled = !masked || (arc_filter[arc] && node_filter[g.source(arc)] && node_filter[g.target(arc)]);
+            lengths[a] = enabled ? length_values[arc] : std::numeric_limits<double>::infinity();
+        }
+
+        result = create_unreached_result();
+        if (!result) return nullptr;
+
+        if (mode == LEMON_BELLMAN_FORD_QUEUE) {
+            QueueBellmanFord bellman_ford(get_csr(graph_wrapper), lengths);
+            bool has_negative_cycle = !bellman_ford.run(source);
+
+            result->negative_cycle = has_negative_cycle ? 1 : 0;
+            if (!has_negative_cycle && bellman_ford.reached(target)) {
+                result->reached = 1;
+                result->distance = bellman_ford.dist(target);
+                result->path = create_path_result(bellman_ford.path(target));
+            }
+
+            cycle = bellman_ford.cycle();
+        } else {
+            const CsrGraph& csr = get_csr(graph_wrapper, true);
+            // Threads only pay off once a round has enough arcs to split
+            int threads = thread_count > 0 ? thread_count
+                        : (csr.arc_count < 65536 ? 1 : resolve_thread_count(0));
+
+            EdgeListBellmanFord bellman_ford(csr, lengths, threads);
+            bool has_negative_cycle = !bellman_ford.run(source);
+
+            const std::vector<int>& pred_arc = bellman_ford.pred_arc();
+            std::vector<int> pred_node(csr.node_count, -1);
+            for (int v = 0; v < csr.node_count; ++v) {
+                if (pred_arc[v] >= 0) {
+                    pred_node[v] = SmartDigraph::id(graph_wrapper->graph.source(graph_wrapper->arcs[pred_arc[v]]));
+                }
+            }
+
+            result->negative_cycle = has_negative_cycle ? 1 : 0;
+            if (!has_negative_cycle && bellman_ford.dist()[target] < std::numeric_limits<double>::infinity()) {
+                std::vector<int> path_arcs;
+                for (int v = target; pred_arc[v] >= 0; v = pred_node[v]) {
+                    path_arcs.push_back(pred_arc[v]);
+                }
+                std::reverse(path_arcs.begin(), path_arcs.end());
+
+                result->reached = 1;
+                result->distance = bellman_ford.dist()[target];
+                result->path = create_path_result(path_arcs);
+            }
+
+            if (has_negative_cycle) {
+                double cycle_length_sum = 0.0;
+                if (find_predecessor_cycle(pred_node, pred_arc, cycle)) {
+                    for (size_t i = 0; i < cycle.size(); ++i) {
+                        cycle_length_sum += lengths[cycle[i]];
+                    }
+                }
+                if (cycle.empty() || !(cycle_length_sum < 0.0)) {
+                    // Round-synchronous predecessors need not close the cycle yet
+                    QueueBellmanFord fallback(get_csr(graph_wrapper), lengths);
+                    fallback.run(source);
+                    cycle = fallback.cycle();
+                }
+            }
+        }
+    }
+
+    copy_cycle(cycle, cycle_arcs, cycle_capacity, cycle_length);
+    return result;
+}
+
+// Integer-length shortest path algorithms
+LEMON_API ShortestPathResultLong* lemon_dijkstra_long(LemonGraph graph, LemonArcMap length_map,
+                                                      int source, int target, int heap_type) {
+    if (!graph || !length_map) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::LONG) return nullptr;
+
+    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+        return nullptr;
+    }
+
+    if (heap_type != LEMON_HEAP_RADIX && heap_type != LEMON_HEAP_BUCKET) return nullptr;
+
+    SmartDigraph::ArcMap<long>& lengths = *(length_wrapper->long_map);
+
+    // Dijkstra needs non-negative lengths, and both integer heaps keep
+    // int priorities, so make sure no distance can exceed INT_MAX.
+    long long max_length = 0;
+    for (SmartDigraph::ArcIt a(graph_wrapper->graph); a != INVALID; ++a) {
+        if (lengths[a] < 0) return nullptr;
+        if (lengths[a] > max_length) max_length = lengths[a];
+    }
+
+    long long node_count = static_cast<long long>(graph_wrapper->nodes.size());
+    bool fits_int = max_length == 0 || node_count <= 1 ||
+                    max_length <= INT_MAX / (node_count - 1);
+
+    if (!fits_int) {
+        return run_dijkstra_long<BinHeap<long, SmartDigraph::NodeMap<int> > >(
+            graph_wrapper, lengths, source, target);
+    }
+
+    if (heap_type == LEMON_HEAP_BUCKET) {
+        return run_dijkstra_long<BucketHeap<SmartDigraph::NodeMap<int> > >(
+            graph_wrapper, lengths, source, target);
+    }
+
+    return run_dijkstra_long<RadixHeap<SmartDigraph::NodeMap<int> > >(
+        graph_wrapper, lengths, source, target);
+}
+
+LEMON_API ShortestPathResultLong* lemon_bellman_ford_long(LemonGraph graph, LemonArcMap length_map,
+                                                          int source, int target) {
+    if (!graph || !length_map) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::LONG) return nullptr;
+
+    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
+        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+        return nullptr;
+    }
+
+    typedef BellmanFord<SmartDigraph, SmartDigraph::ArcMap<long> > BellmanFordAlg;
+    BellmanFordAlg bellman_ford(graph_wrapper->graph, *(length_wrapper->long_map));
+
+    bellman_ford.init();
+    bellman_ford.addSource(graph_wrapper->nodes[source]);
+    bool has_negative_cycle = !bellman_ford.checkedStart();
+
+    ShortestPathResultLong* result = static_cast<ShortestPathResultLong*>(malloc(sizeof(ShortestPathResultLong)));
+    if (!result) return nullptr;
+
+    SmartDigraph::Node t = graph_wrapper->nodes[target];
+    result->negative_cycle = has_negative_cycle ? 1 : 0;
+    result->reached = (!has_negative_cycle && bellman_ford.reached(t)) ? 1 : 0;
+
+    if (result->reached) {
+        result->distance = bellman_ford.dist(t);
+        result->path = create_path_result(bellman_ford.path(t));
+    } else {
+        result->distance = std::numeric_limits<long long>::max();
+        result->path = nullptr;
+    }
+
+    return result;
+}
+
+// Parallel delta-stepping single-source shortest paths
+LEMON_API int lemon_delta_stepping(LemonGraph graph, LemonArcMap length_map, int source,
+                                   double delta, int thread_count,
+                                   double* dist, int* pred) {
+    if (!graph || !length_map || !dist || !pred) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return -1;
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    int arc_count = static_cast<int>(graph_wrapper->arcs.size());
+
+    if (source < 0 || source >= node_count) return -1;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(arc_count);
+    double max_length = 0.0;
+
+    for (int a = 0; a < arc_count; ++a) {
+        double length = length_values[graph_wrapper->arcs[a]];
+        if (!(length >= 0.0)) return -1;  // negative or NaN
+        lengths[a] = length;
+        if (length > max_length) max_length = length;
+    }
+
+    // Auto-tune: delta ~ max length / average degree keeps the expected
+    // number of light-phase re-relaxations constant per node.
+    if (!(delta > 0.0)) {
+        double average_degree = node_count > 0 ? static_cast<double>(arc_count) / node_count : 1.0;
+        delta = max_length / (average_degree > 1.0 ? average_degree : 1.0);
+        if (!(delta > 0.0)) delta = 1.0;
+    }
+
+    const CsrGraph& csr = get_csr(graph_wrapper);
+    DeltaStepping engine(csr, lengths, delta, resolve_thread_count(thread_count));
+    engine.run(source, dist, pred);
+
+    int reached = 0;
+    for (int v = 0; v < node_count; ++v) {
+        if (pred[v] >= 0 || v == source) ++reached;
+    }
+    return reached;
+}
+
+// K shortest simple paths
+LEMON_API KShortestPathsResult* lemon_k_shortest_paths(LemonGraph graph, LemonArcMap length_map,
+                                                       int source, int target, int k) {
+    if (!graph || !length_map || k < 0) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return nullptr;
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count || target < 0 || target >= node_count) return nullptr;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(graph_wrapper->arcs.size());
+    for (size_t a = 0; a < lengths.size(); ++a) {
+        lengths[a] = length_values[graph_wrapper->arcs[a]];
+        if (!(lengths[a] >= 0.0)) return nullptr;  // negative or NaN
+    }
+
+    YenKShortestPaths yen(graph_wrapper->graph, length_values, lengths);
+    if (k > 0) yen.run(source, target, k);
+
+    const std::vector<std::vector<int> >& paths = yen.paths();
+    int path_count = static_cast<int>(paths.size());
+    int arc_total = 0;
+    for (int i = 0; i < path_count; ++i) arc_total += static_cast<int>(paths[i].size());
+
+    KShortestPathsResult* result = static_cast<KShortestPathsResult*>(malloc(sizeof(KShortestPathsResult)));
+    if (!result) return nullptr;
+
+    result->path_count = path_count;
+    result->costs = static_cast<double*>(malloc(sizeof(double) * (path_count > 0 ? path_count : 1)));
+    result->offsets = static_cast<int*>(malloc(sizeof(int) * (path_count + 1)));
+    result->arc_ids = static_cast<int*>(malloc(sizeof(int) * (arc_total > 0 ? arc_total : 1)));
+
+    if (!result->costs || !result->offsets || !result->arc_ids) {
+        lemon_free_k_shortest_paths_result(result);
+        return nullptr;
+    }
+
+    int offset = 0;
+    for (int i = 0; i < path_count; ++i) {
+        result->costs[i] = yen.costs()[i];
+        result->offsets[i] = offset;
+        for (size_t j = 0; j < paths[i].size(); ++j) {
+            result->arc_ids[offset++] = paths[i][j];
+        }
+    }
+    result->offsets[path_count] = offset;
+
+    return result;
+}
+
+// Suurballe disjoint paths
+LEMON_API LemonSuurballe lemon_create_suurballe(LemonGraph graph, LemonArcMap length_map, int disjoint) {
+    if (!graph || !length_map) return nullptr;
+    if (disjoint != LEMON_DISJOINT_ARCS && disjoint != LEMON_DISJOINT_NODES) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return nullptr;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    for (size_t a = 0; a < graph_wrapper->arcs.size(); ++a) {
+        if (!(length_values[graph_wrapper->arcs[a]] >= 0.0)) return nullptr;  // negative or NaN
+    }
+
+    return new SuurballeWrapper(graph_wrapper, length_values, disjoint);
+}
+
+LEMON_API void lemon_destroy_suurballe(LemonSuurballe suurballe) {
+    if (suurballe) {
+        delete static_cast<SuurballeWrapper*>(suurballe);
+    }
+}
+
+LEMON_API int lemon_suurballe_run(LemonSuurballe suurballe, int source, int target, int k,
+                                  double* total_length, int* path_offsets,
+                                  int* arc_ids, int arc_capacity) {
+    if (!suurballe || !total_length || !path_offsets || k < 0 || arc_capacity < 0) return -1;
+    if (arc_capacity > 0 && !arc_ids) return -1;
+
+    SuurballeWrapper* wrapper = static_cast<SuurballeWrapper*>(suurballe);
+
+    // The graph must not have changed since the handle was created
+    if (static_cast<int>(wrapper->graph_wrapper->nodes.size()) != wrapper->node_count ||
+        static_cast<int>(wrapper->graph_wrapper->arcs.size()) != wrapper->arc_count) {
+        return -1;
+    }
+
+    if (source < 0 || source >= wrapper->node_count ||
+        target < 0 || target >= wrapper->node_count || source == target) {
+        return -1;
+    }
+
+    return wrapper->run(source, target, k, total_length, path_offsets, arc_ids, arc_capacity);
+}
+
+LEMON_API int lemon_suurballe(LemonGraph graph, LemonArcMap length_map, int source, int target,
+                              int k, int disjoint, double* total_length, int* path_offsets,
+                              int* arc_ids, int arc_capacity) {
+    LemonSuurballe suurballe = lemon_create_suurballe(graph, length_map, disjoint);
+    if (!suurballe) return -1;
+
+    int path_count = lemon_suurballe_run(suurballe, source, target, k, total_length,
+                                         path_offsets, arc_ids, arc_capacity);
+    lemon_destroy_suurballe(suurballe);
+    return path_count;
+}
+
+// Gomory-Hu tree
+LEMON_API LemonGomoryHu lemon_gomory_hu_build(LemonGraph graph, LemonArcMap capacity_map, int thread_count) {
+    if (!graph || !capacity_map) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* capacity_wrapper = static_cast<ArcMapWrapper*>(capacity_map);
+
+    if (capacity_wrapper->type != MapType::LONG) return nullptr;
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    SmartGraph undirected;
+    SmartGraph::EdgeMap<long> capacity(undirected);
+    if (!build_undirected_network(graph_wrapper, capacity_wrapper, undirected, capacity)) return nullptr;
+
+    GomoryHuWrapper* tree = new GomoryHuWrapper(node_count);
+    tree->build(undirected, capacity, resolve_thread_count(thread_count));
+    return tree;
+}
+
+LEMON_API LemonGomoryHu lemon_gomory_hu_create(int node_count, const int* pred, const long long* weight) {
+    if (node_count < 0 || (node_count > 0 && (!pred || !weight))) return nullptr;
+
+    GomoryHuWrapper* tree = new GomoryHuWrapper(node_count);
+    for (int v = 0; v < node_count; ++v) {
+        if (pred[v] < -1 || pred[v] >= node_count || (pred[v] == -1) != (v == 0)) {
+            delete tree;
+            return nullptr;
+        }
+        tree->pred[v] = pred[v];
+        tree->weight[v] = weight[v];
+    }
+
+    // Every parent chain must end at the root
+    tree->computeOrder();
+    for (int v = 1; v < node_count; ++v) {
+        if (tree->order[tree->pred[v]] >= tree->order[v]) {
+            delete tree;
+            return nullptr;
+        }
+    }
+    return tree;
+}
+
+LEMON_API void lemon_destroy_gomory_hu(LemonGomoryHu tree) {
+    if (tree) {
+        delete static_cast<GomoryHuWrapper*>(tree);
+    }
+}
+
+LEMON_API int lemon_gomory_hu_tree(LemonGomoryHu tree, int* pred, long long* weight) {
+    if (!tree) return -1;
+
+    GomoryHuWrapper* wrapper = static_cast<GomoryHuWrapper*>(tree);
+    if (pred) std::copy(wrapper->pred.begin(), wrapper->pred.end(), pred);
+    if (weight) std::copy(wrapper->weight.begin(), wrapper->weight.end(), weight);
+    return wrapper->node_count;
+}
+
+LEMON_API long long lemon_gomory_hu_min_cut_value(LemonGomoryHu tree, int u, int v) {
+    if (!tree) return -1;
+
+    GomoryHuWrapper* wrapper = static_cast<GomoryHuWrapper*>(tree);
+    if (u < 0 || u >= wrapper->node_count || v < 0 || v >= wrapper->node_count || u == v) return -1;
+
+    int child;
+    return wrapper->minCutValue(u, v, &child);
+}
+
+LEMON_API long long lemon_gomory_hu_min_cut(LemonGomoryHu tree, int u, int v, unsigned char* u_side) {
+    if (!tree || !u_side) return -1;
+
+    GomoryHuWrapper* wrapper = static_cast<GomoryHuWrapper*>(tree);
+    if (u < 0 || u >= wrapper->node_count || v < 0 || v >= wrapper->node_count || u == v) return -1;
+
+    return wrapper->minCutSide(u, v, u_side);
+}
+
+LEMON_API int lemon_gomory_hu_min_cut_arcs(LemonGomoryHu tree, LemonGraph graph, int u, int v,
+                                           int* arc_ids, int arc_capacity) {
+    if (!tree || !graph || (arc_capacity > 0 && !arc_ids)) return -1;
+
+    GomoryHuWrapper* wrapper = static_cast<GomoryHuWrapper*>(tree);
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+
+    if (static_cast<int>(graph_wrapper->nodes.size()) != wrapper->node_count) return -1;
+    if (u < 0 || u >= wrapper->node_count || v < 0 || v >= wrapper->node_count || u == v) return -1;
+
+    std::vector<unsigned char> side(wrapper->node_count);
+    wrapper->minCutSide(u, v, &side[0]);
+
+    const SmartDigraph& g = graph_wrapper->graph;
+    int count = 0;
+    for (size_t a = 0; a < graph_wrapper->arcs.size(); ++a) {
+        SmartDigraph::Arc arc = graph_wrapper->arcs[a];
+        if (side[g.id(g.source(arc))] != side[g.id(g.target(arc))]) {
+            if (count >= arc_capacity) return -1;
+            arc_ids[count++] = static_cast<int>(a);
+        }
+    }
+    return count;
+}
+
+// Global minimum cut
+LEMON_API long long lemon_global_min_cut(LemonGraph graph, LemonArcMap capacity_map, int undirected,
+                                         unsigned char* source_side) {
+    if (!graph || !capacity_map) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* capacity_wrapper = static_cast<ArcMapWrapper*>(capacity_map);
+
+    if (capacity_wrapper->type != MapType::LONG) return -1;
+    if (graph_wrapper->nodes.size() < 2) return -1;
+
+    long long value;
+    if (undirected) {
+        SmartGraph g;
+        SmartGraph::EdgeMap<long> capacity(g);
+        if (!build_undirected_network(graph_wrapper, capacity_wrapper, g, capacity)) return -1;
+
+        value = run_nagamochi_ibaraki(g, capacity, source_side);
+    } else {
+        const SmartDigraph& g = graph_wrapper->graph;
+        const SmartDigraph::ArcMap<long>& capacity = *(capacity_wrapper->long_map);
+        for (SmartDigraph::ArcIt a(g); a != INVALID; ++a) {
+            if (capacity[a] < 0) return -1;
+        }
+
+        HaoOrlin<SmartDigraph, SmartDigraph::ArcMap<long>> ho(g, capacity);
+        ho.run();
+
+        SmartDigraph::NodeMap<bool> cut(g);
+        value = ho.minCutMap(cut);
+        if (source_side) {
+            for (SmartDigraph::NodeIt n(g); n != INVALID; ++n) {
+                source_side[g.id(n)] = cut[n] ? 1 : 0;
+            }
+        }
+    }
+
+    return value;
+}
+
+LEMON_API long long lemon_global_min_cut_ugraph(LemonUGraph graph, LemonEdgeMap capacity_map,
+                                                unsigned char* side) {
+    if (!graph || !capacity_map) return -1;
+
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    EdgeMapWrapper* capacity_wrapper = static_cast<EdgeMapWrapper*>(capacity_map);
+
+    if (capacity_wrapper->type != MapType::LONG) return -1;
+    if (graph_wrapper->nodes.size() < 2) return -1;
+
+    const SmartGraph::EdgeMap<long>& capacity = *(capacity_wrapper->long_map);
+    for (SmartGraph::EdgeIt e(graph_wrapper->graph); e != INVALID; ++e) {
+        if (capacity[e] < 0) return -1;
+    }
+
+    return run_nagamochi_ibaraki(graph_wrapper->graph, capacity, side);
+}
+
+// Maximum weighted matching
+LEMON_API LemonMatching lemon_create_matching(LemonUGraph graph, int perfect) {
+    if (!graph) return nullptr;
+    return new MatchingWrapper(static_cast<UGraphWrapper*>(graph), perfect != 0);
+}
+
+LEMON_API void lemon_destroy_matching(LemonMatching matching) {
+    if (matching) {
+        delete static_cast<MatchingWrapper*>(matching);
+    }
+}
+
+LEMON_API int lemon_matching_run(LemonMatching matching, LemonEdgeMap weight_map, int jumpstart,
+                                 long long* weight, int* mate) {
+    if (!matching || !weight_map) return -1;
+
+    MatchingWrapper* wrapper = static_cast<MatchingWrapper*>(matching);
+    EdgeMapWrapper* weight_wrapper = static_cast<EdgeMapWrapper*>(weight_map);
+
+    if (weight_wrapper->type != MapType::LONG) return -1;
+    if (weight_wrapper->graph_wrapper != wrapper->graph_wrapper) return -1;
+
+    return wrapper->run(*(weight_wrapper->long_map), jumpstart != 0, weight, mate);
+}
+
+// Linear assignment
+LEMON_API int lemon_assignment_dense(const double* cost, int n, int* col_for_row, double* total_cost) {
+    if (n < 0 || (n > 0 && (!cost || !col_for_row))) return -1;
+
+    size_t size = static_cast<size_t>(n) * n;
+    for (size_t k = 0; k < size; ++k) {
+        if (std::isnan(cost[k]) || cost[k] == -std::numeric_limits<double>::infinity()) return -1;
+    }
+
+    DenseAssignment assignment(cost, n);
+    if (!assignment.run()) return 0;
+
+    double total = 0.0;
+    const std::vector<int>& col4row = assignment.columnForRow();
+    for (int i = 0; i < n; ++i) {
+        col_for_row[i] = col4row[i];
+        total += cost[static_cast<size_t>(i) * n + col4row[i]];
+    }
+    if (total_cost) *total_cost = total;
+    return 1;
+}
+
+LEMON_API int lemon_assignment_sparse(int row_count, int col_count, const int* rows, const int* cols,
+                                      const double* costs, int entry_count,
+                                      int* col_for_row, double* total_cost) {
+    if (row_count < 0 || col_count < row_count || entry_count < 0) return -1;
+    if (entry_count > 0 && (!rows || !cols || !costs)) return -1;
+    if (row_count > 0 && !col_for_row) return -1;
+
+    for (int e = 0; e < entry_count; ++e) {
+        if (rows[e] < 0 || rows[e] >= row_count || cols[e] < 0 || cols[e] >= col_count) return -1;
+        if (!std::isfinite(costs[e])) return -1;
+    }
+
+    SparseAssignment assignment(row_count, col_count, rows, cols, costs, entry_count);
+    if (!assignment.run()) return 0;
+
+    double total = 0.0;
+    const std::vector<int>& col4row = assignment.columnForRow();
+    for (int i = 0; i < row_count; ++i) {
+        col_for_row[i] = col4row[i];
+        total += assignment.cost(i, col4row[i]);
+    }
+    if (total_cost) *total_cost = total;
+    return 1;
+}
+
+// Minimum spanning forest
+LEMON_API int lemon_spanning_forest(LemonGraph graph, LemonArcMap weight_map, int algorithm,
+                                    int thread_count, int* arc_ids, void* total_weight) {
+    if (!graph || !weight_map) return -1;
+    if (algorithm < SpanningForest::AUTO || algorithm > SpanningForest::BORUVKA) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* weight_wrapper = static_cast<ArcMapWrapper*>(weight_map);
+    const SmartDigraph& g = graph_wrapper->graph;
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (node_count > 1 && !arc_ids) return -1;
+
+    int arc_count = static_cast<int>(graph_wrapper->arcs.size());
+    std::vector<int> u(arc_count), v(arc_count);
+    for (int a = 0; a < arc_count; ++a) {
+        u[a] = g.id(g.source(graph_wrapper->arcs[a]));
+        v[a] = g.id(g.target(graph_wrapper->arcs[a]));
+    }
+
+    if (weight_wrapper->type == MapType::LONG) {
+        std::vector<long> weight(arc_count);
+        for (int a = 0; a < arc_count; ++a) weight[a] = (*weight_wrapper->long_map)[graph_wrapper->arcs[a]];
+        return spanning_forest(node_count, u, v, weight, algorithm, thread_count, arc_ids,
+                               static_cast<long long*>(total_weight));
+    }
+
+    std::vector<double> weight(arc_count);
+    for (int a = 0; a < arc_count; ++a) weight[a] = (*weight_wrapper->double_map)[graph_wrapper->arcs[a]];
+    return spanning_forest(node_count, u, v, weight, algorithm, thread_count, arc_ids,
+                           static_cast<double*>(total_weight));
+}
+
+LEMON_API int lemon_spanning_forest_ugraph(LemonUGraph graph, LemonEdgeMap weight_map, int algorithm,
+                                           int thread_count, int* edge_ids, void* total_weight) {
+    if (!graph || !weight_map) return -1;
+    if (algorithm < SpanningForest::AUTO || algorithm > SpanningForest::BORUVKA) return -1;
+
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    EdgeMapWrapper* weight_wrapper = static_cast<EdgeMapWrapper*>(weight_map);
+    if (weight_wrapper->graph_wrapper != graph_wrapper) return -1;
+    const SmartGraph& g = graph_wrapper->graph;
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (node_count > 1 && !edge_ids) return -1;
+
+    int edge_count = static_cast<int>(graph_wrapper->edges.size());
+    std::vector<int> u(edge_count), v(edge_count);
+    for (int e = 0; e < edge_count; ++e) {
+        u[e] = g.id(g.u(graph_wrapper->edges[e]));
+        v[e] = g.id(g.v(graph_wrapper->edges[e]));
+    }
+
+    if (weight_wrapper->type == MapType::LONG) {
+        std::vector<long> weight(edge_count);
+        for (int e = 0; e < edge_count; ++e) weight[e] = (*weight_wrapper->long_map)[graph_wrapper->edges[e]];
+        return spanning_forest(node_count, u, v, weight, algorithm, thread_count, edge_ids,
+                               static_cast<long long*>(total_weight));
+    }
+
+    std::vector<double> weight(edge_count);
+    for (int e = 0; e < edge_count; ++e) weight[e] = (*weight_wrapper->double_map)[graph_wrapper->edges[e]];
+    return spanning_forest(node_count, u, v, weight, algorithm, thread_count, edge_ids,
+                           static_cast<double*>(total_weight));
+}
+
+// Strongly connected components and topological order
+LEMON_API int lemon_strongly_connected_components(LemonGraph graph, int* component_of_node) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    if (!graph_wrapper->nodes.empty() && !component_of_node) return -1;
+
+    IdBufferMap<SmartDigraph, SmartDigraph::Node> component(graph_wrapper->graph, component_of_node);
+    return stronglyConnectedComponents(graph_wrapper->graph, component);
+}
+
+LEMON_API int lemon_topological_sort(LemonGraph graph, int* order) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (node_count > 0 && !order) return -1;
+
+    std::vector<int> position(node_count);
+    IdBufferMap<SmartDigraph, SmartDigraph::Node> position_map(graph_wrapper->graph, position.data());
+    if (!checkedTopologicalSort(graph_wrapper->graph, position_map)) return 0;
+
+    for (int i = 0; i < node_count; ++i) {
+        order[position[i]] = i;
+    }
+    return 1;
+}
+
+LEMON_API int lemon_is_dag(LemonGraph graph) {
+    if (!graph) return -1;
+    return dag(static_cast<GraphWrapper*>(graph)->graph) ? 1 : 0;
+}
+
+LEMON_API LemonGraph lemon_condensation(LemonGraph graph, int* component_of_node) {
+    if (!graph) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    if (!graph_wrapper->nodes.empty() && !component_of_node) return nullptr;
+
+    IdBufferMap<SmartDigraph, SmartDigraph::Node> component(graph_wrapper->graph, component_of_node);
+    int component_count = stronglyConnectedComponents(graph_wrapper->graph, component);
+    return build_condensation(graph_wrapper, component_of_node, component_count);
+}
+
+// Cut nodes, bridges and biconnected components
+LEMON_API int lemon_cut_nodes(LemonGraph graph, unsigned long long* cut_nodes) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (node_count > 0 && !cut_nodes) return -1;
+
+    Undirector<const SmartDigraph> undirected(graph_wrapper->graph);
+    return find_cut_nodes(undirected, node_count, cut_nodes);
+}
+
+LEMON_API int lemon_bridges(LemonGraph graph, unsigned long long* bridges) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int arc_count = static_cast<int>(graph_wrapper->arcs.size());
+    if (arc_count > 0 && !bridges) return -1;
+
+    Undirector<const SmartDigraph> undirected(graph_wrapper->graph);
+    return find_bridges(undirected, arc_count, bridges);
+}
+
+LEMON_API int lemon_biconnected_components(LemonGraph graph, int* block_of_arc) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int arc_count = static_cast<int>(graph_wrapper->arcs.size());
+    if (arc_count > 0 && !block_of_arc) return -1;
+
+    Undirector<const SmartDigraph> undirected(graph_wrapper->graph);
+    return find_blocks(undirected, arc_count, block_of_arc);
+}
+
+LEMON_API int lemon_cut_nodes_ugraph(LemonUGraph graph, unsigned long long* cut_nodes) {
+    if (!graph) return -1;
+
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (node_count > 0 && !cut_nodes) return -1;
+
+    return find_cut_nodes(graph_wrapper->graph, node_count, cut_nodes);
+}
+
+LEMON_API int lemon_bridges_ugraph(LemonUGraph graph, unsigned long long* bridges) {
+    if (!graph) return -1;
+
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    int edge_count = static_cast<int>(graph_wrapper->edges.size());
+    if (edge_count > 0 && !bridges) return -1;
+
+    return find_bridges(graph_wrapper->graph, edge_count, bridges);
+}
+
+LEMON_API int lemon_biconnected_components_ugraph(LemonUGraph graph, int* block_of_edge) {
+    if (!graph) return -1;
+
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    int edge_count = static_cast<int>(graph_wrapper->edges.size());
+    if (edge_count > 0 && !block_of_edge) return -1;
+
+    return find_blocks(graph_wrapper->graph, edge_count, block_of_edge);
+}
+
+// Breadth-first search
+LEMON_API int lemon_bfs(LemonGraph graph, int source, int* dist, int* pred) {
+    if (!graph || !dist || !pred) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count) return -1;
+
+    const SmartDigraph& g = graph_wrapper->graph;
+    Bfs<SmartDigraph> bfs(g);
+    bfs.run(graph_wrapper->nodes[source]);
+
+    int reached = 0;
+    for (int v = 0; v < node_count; ++v) {
+        SmartDigraph::Node node = graph_wrapper->nodes[v];
+        if (bfs.reached(node)) {
+            dist[v] = bfs.dist(node);
+            SmartDigraph::Arc arc = bfs.predArc(node);
+            pred[v] = arc == INVALID ? -1 : g.id(arc);
+            ++reached;
+        } else {
+            dist[v] = -1;
+            pred[v] = -1;
+        }
+    }
+    return reached;
 }
 
-LEMON_API double lemon_get_node_value_double(LemonNodeMap map, int node) {
-    if (!map) return 0.0;
-    
-    NodeMapWrapper* wrapper = static_cast<NodeMapWrapper*>(map);
-    
-    if (node < 0 || node >= static_cast<int>(wrapper->graph_wrapper->nodes.size())) {
-        return 0.0;
+LEMON_API int lemon_bfs_direction_optimizing(LemonGraph graph, int source, int alpha, int beta,
+                                             int* dist, int* pred) {
+    if (!graph || !dist || !pred) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count) return -1;
+
+    DirectionOptimizingBfs bfs(get_csr(graph_wrapper, true), alpha, beta);
+    return bfs.run(source, dist, pred);
+}
+
+// Bit-parallel multi-source breadth-first search
+LEMON_API long long lemon_multi_source_bfs(LemonGraph graph, const int* sources, int source_count,
+                                           int* dist, unsigned long long* reach) {
+    if (!graph || (source_count > 0 && !sources) || source_count < 0) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    for (int s = 0; s < source_count; ++s) {
+        if (sources[s] < 0 || sources[s] >= node_count) return -1;
     }
-    
-    return (*(wrapper->map))[wrapper->graph_wrapper->nodes[node]];
+
+    MultiSourceBfs bfs(get_csr(graph_wrapper, false));
+    return bfs.run(sources, source_count, dist, reach);
 }
 
-// Shortest path algorithms
-LEMON_API ShortestPathResult* lemon_dijkstra(LemonGraph graph, LemonArcMap length_map,
-                                             int source, int target) {
-    if (!graph || !length_map) return nullptr;
-    
+LEMON_API int lemon_parallel_bfs(LemonGraph graph, int source, int thread_count, int* dist, int* pred) {
+    if (!graph || !dist || !pred) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count) return -1;
+
+    const CsrGraph& csr = get_csr(graph_wrapper, false);
+    ParallelBfs bfs(csr, parallel_traversal_threads(thread_count, csr.arc_count));
+    return bfs.run(source, dist, pred);
+}
+
+// Connected components
+LEMON_API int lemon_connected_components(LemonGraph graph, int thread_count, int* component_of_node) {
+    if (!graph) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    if (!graph_wrapper->nodes.empty() && !component_of_node) return -1;
+
+    const CsrGraph& csr = get_csr(graph_wrapper, true);
+    ParallelComponents components(csr, parallel_traversal_threads(thread_count, csr.arc_count));
+    return components.run(component_of_node);
+}
+
+LEMON_API int lemon_connected_components_ugraph(LemonUGraph graph, int thread_count, int* component_of_node) {
+    if (!graph) return -1;
+
+    // Every edge is listed from both ends, so no in-adjacency is needed
+    UGraphWrapper* graph_wrapper = static_cast<UGraphWrapper*>(graph);
+    if (!graph_wrapper->nodes.empty() && !component_of_node) return -1;
+
+    const SmartGraph& g = graph_wrapper->graph;
+    int edge_count = static_cast<int>(graph_wrapper->edges.size());
+    std::vector<int> ends(2 * static_cast<size_t>(edge_count));
+    std::vector<int> others(ends.size());
+    for (int e = 0; e < edge_count; ++e) {
+        int u = g.id(g.u(graph_wrapper->edges[e]));
+        int v = g.id(g.v(graph_wrapper->edges[e]));
+        ends[2 * e] = others[2 * e + 1] = u;
+        ends[2 * e + 1] = others[2 * e] = v;
+    }
+
+    CsrGraph csr;
+    csr.node_count = static_cast<int>(graph_wrapper->nodes.size());
+    csr.arc_count = static_cast<int>(ends.size());
+    build_adjacency(csr.node_count, ends, others, csr.out_begin, csr.out_arc, csr.out_target);
+
+    ParallelComponents components(csr, parallel_traversal_threads(thread_count, csr.arc_count));
+    return components.run(component_of_node);
+}
+
+// Traversal event streams
+LEMON_API LemonTraversal lemon_traversal_create(LemonGraph graph, int kind, int capacity) {
+    if (!graph || capacity <= 0) return nullptr;
+    if (kind != LEMON_TRAVERSAL_BFS && kind != LEMON_TRAVERSAL_DFS) return nullptr;
+
+    return new TraversalStream(static_cast<GraphWrapper*>(graph), kind, capacity);
+}
+
+LEMON_API void lemon_traversal_destroy(LemonTraversal traversal) {
+    delete static_cast<TraversalStream*>(traversal);
+}
+
+LEMON_API int lemon_traversal_start(LemonTraversal traversal, const int* sources, int source_count,
+                                    int event_mask, int flush_threshold) {
+    if (!traversal || source_count < 0 || (source_count > 0 && !sources) || flush_threshold <= 0) return -1;
+
+    TraversalStream* stream = static_cast<TraversalStream*>(traversal);
+    for (int i = 0; i < source_count; ++i) {
+        if (sources[i] < 0 || sources[i] >= stream->node_count()) return -1;
+    }
+
+    stream->start(sources, source_count, event_mask, flush_threshold);
+    return 0;
+}
+
+LEMON_API int lemon_traversal_read(LemonTraversal traversal, LemonTraversalEvent* events, int max_events) {
+    if (!traversal || !events || max_events <= 0) return -1;
+
+    return static_cast<TraversalStream*>(traversal)->read(events, max_events);
+}
+
+// Nearest-facility labels
+LEMON_API LemonNearestFacility lemon_nearest_facility_create(LemonGraph graph, LemonArcMap length_map,
+                                                             const int* facilities, int facility_count) {
+    if (!graph || !length_map || facility_count < 0 || (facility_count > 0 && !facilities)) return nullptr;
+
     GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
     ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
-    
     if (length_wrapper->type != MapType::DOUBLE) return nullptr;
-    
-    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
-        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
-        return nullptr;
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    for (int i = 0; i < facility_count; ++i) {
+        if (facilities[i] < 0 || facilities[i] >= node_count) return nullptr;
     }
-    
-    typedef Dijkstra<SmartDigraph, SmartDigraph::ArcMap<double>> DijkstraAlg;
-    DijkstraAlg dijkstra(graph_wrapper->graph, *(length_wrapper->double_map));
-    
-    dijkstra.run(graph_wrapper->nodes[source], graph_wrapper->nodes[target]);
-    
-    ShortestPathResult* result = static_cast<ShortestPathResult*>(malloc(sizeof(ShortestPathResult)));
-    if (!result) return nullptr;
-    
-    result->reached = dijkstra.reached(graph_wrapper->nodes[target]) ? 1 : 0;
-    result->negative_cycle = 0;  // Dijkstra doesn't detect negative cycles
-    
-    if (result->reached) {
-        result->distance = dijkstra.dist(graph_wrapper->nodes[target]);
-        
-        // Build path
-        typedef Path<SmartDigraph> PathType;
-        PathType path = dijkstra.path(graph_wrapper->nodes[target]);
-        
-        std::vector<int> arc_ids;
-        for (PathType::ArcIt it(path); it != INVALID; ++it) {
-            SmartDigraph::Arc arc = it;
-            // Find the arc ID
-            for (size_t i = 0; i < graph_wrapper->arcs.size(); ++i) {
-                if (graph_wrapper->arcs[i] == arc) {
-                    arc_ids.push_back(static_cast<int>(i));
-                    break;
-                }
-            }
-        }
-        
-        if (arc_ids.empty()) {
-            // Return an empty path rather than null for 0-length paths
-            result->path = static_cast<PathResult*>(malloc(sizeof(PathResult)));
-            if (result->path) {
-                result->path->count = 0;
-                result->path->arc_ids = nullptr;
-            }
-        } else {
-            result->path = static_cast<PathResult*>(malloc(sizeof(PathResult)));
-            if (result->path) {
-                result->path->count = static_cast<int>(arc_ids.size());
-                result->path->arc_ids = static_cast<int*>(malloc(sizeof(int) * arc_ids.size()));
-                if (result->path->arc_ids) {
-                    memcpy(result->path->arc_ids, arc_ids.data(), sizeof(int) * arc_ids.size());
-                } else {
-                    free(result->path);
-                    result->path = nullptr;
-                }
-            }
-        }
-    } else {
-        result->distance = std::numeric_limits<double>::infinity();
-        result->path = nullptr;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(graph_wrapper->arcs.size());
+    for (size_t a = 0; a < lengths.size(); ++a) {
+        lengths[a] = length_values[graph_wrapper->arcs[a]];
+        if (!(lengths[a] >= 0.0)) return nullptr;  // negative or NaN
     }
-    
-    return result;
+
+    NearestFacilityLabels* labels = new NearestFacilityLabels(get_csr(graph_wrapper, true), lengths);
+    labels->build(facilities, facility_count);
+    return labels;
 }
 
-LEMON_API ShortestPathResult* lemon_bellman_ford(LemonGraph graph, LemonArcMap length_map,
-                                                 int source, int target) {
-    if (!graph || !length_map) return nullptr;
-    
+LEMON_API void lemon_nearest_facility_destroy(LemonNearestFacility labels) {
+    delete static_cast<NearestFacilityLabels*>(labels);
+}
+
+LEMON_API int lemon_nearest_facility_add(LemonNearestFacility labels, int node) {
+    if (!labels) return -1;
+
+    NearestFacilityLabels* wrapper = static_cast<NearestFacilityLabels*>(labels);
+    if (node < 0 || node >= wrapper->node_count()) return -1;
+    return wrapper->add(node);
+}
+
+LEMON_API int lemon_nearest_facility_remove(LemonNearestFacility labels, int node) {
+    if (!labels) return -1;
+
+    NearestFacilityLabels* wrapper = static_cast<NearestFacilityLabels*>(labels);
+    if (node < 0 || node >= wrapper->node_count()) return -1;
+    return wrapper->remove(node);
+}
+
+LEMON_API int lemon_nearest_facility_count(LemonNearestFacility labels) {
+    if (!labels) return -1;
+    return static_cast<NearestFacilityLabels*>(labels)->facility_count();
+}
+
+LEMON_API int lemon_nearest_facility_labels(LemonNearestFacility labels, int* nearest, double* dist, int* pred) {
+    if (!labels) return -1;
+
+    NearestFacilityLabels* wrapper = static_cast<NearestFacilityLabels*>(labels);
+    if (nearest) std::copy(wrapper->origin().begin(), wrapper->origin().end(), nearest);
+    if (dist) std::copy(wrapper->dist().begin(), wrapper->dist().end(), dist);
+    if (pred) std::copy(wrapper->pred().begin(), wrapper->pred().end(), pred);
+    return wrapper->node_count();
+}
+
+LEMON_API int lemon_nearest_facility_query(LemonNearestFacility labels, int node, double* dist) {
+    if (!labels) return -1;
+
+    NearestFacilityLabels* wrapper = static_cast<NearestFacilityLabels*>(labels);
+    if (node < 0 || node >= wrapper->node_count()) return -1;
+    if (dist) *dist = wrapper->dist()[node];
+    return wrapper->origin()[node];
+}
+
+// Dynamic shortest path tree
+LEMON_API LemonDynamicSssp lemon_dynamic_sssp_create(LemonGraph graph, LemonArcMap length_map, int source,
+                                                     const double* dist, const int* pred) {
+    if (!graph || !length_map || (dist == nullptr) != (pred == nullptr)) return nullptr;
+
     GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
     ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
-    
     if (length_wrapper->type != MapType::DOUBLE) return nullptr;
-    
-    if (source < 0 || source >= static_cast<int>(graph_wrapper->nodes.size()) ||
-        target < 0 || target >= static_cast<int>(graph_wrapper->nodes.size())) {
+
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count) return nullptr;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(graph_wrapper->arcs.size());
+    for (size_t a = 0; a < lengths.size(); ++a) {
+        lengths[a] = length_values[graph_wrapper->arcs[a]];
+        if (!(lengths[a] >= 0.0)) return nullptr;  // negative or NaN
+    }
+
+    DynamicShortestPathTree* tree = new DynamicShortestPathTree(get_csr(graph_wrapper, true), lengths, source);
+    if (!dist) {
+        tree->build();
+    } else if (!tree->load(dist, pred)) {
+        delete tree;
         return nullptr;
     }
-    
-    typedef BellmanFord<SmartDigraph, SmartDigraph::ArcMap<double>> BellmanFordAlg;
-    BellmanFordAlg bellman_ford(graph_wrapper->graph, *(length_wrapper->double_map));
-    
-    bellman_ford.init();
-    bellman_ford.addSource(graph_wrapper->nodes[source]);
-    bool has_negative_cycle = !bellman_ford.checkedStart();
-    
-    ShortestPathResult* result = static_cast<ShortestPathResult*>(malloc(sizeof(ShortestPathResult)));
-    if (!result) return nullptr;
-    
-    result->negative_cycle = has_negative_cycle ? 1 : 0;
-    result->reached = (!has_negative_cycle && bellman_ford.reached(graph_wrapper->nodes[target])) ? 1 : 0;
-    
-    if (result->reached && !has_negative_cycle) {
-        result->distance = bellman_ford.dist(graph_wrapper->nodes[target]);
-        
-        // Build path
-        typedef Path<SmartDigraph> PathType;
-        PathType path = bellman_ford.path(graph_wrapper->nodes[target]);
-        
-        std::vector<int> arc_ids;
-        for (PathType::ArcIt it(path); it != INVALID; ++it) {
-            SmartDigraph::Arc arc = it;
-            // Find the arc ID
-            for (size_t i = 0; i < graph_wrapper->arcs.size(); ++i) {
-                if (graph_wrapper->arcs[i] == arc) {
-                    arc_ids.push_back(static_cast<int>(i));
-                    break;
-                }
-            }
-        }
-        
-        if (arc_ids.empty()) {
-            // Return an empty path rather than null for 0-length paths
-            result->path = static_cast<PathResult*>(malloc(sizeof(PathResult)));
-            if (result->path) {
-                result->path->count = 0;
-                result->path->arc_ids = nullptr;
-            }
-        } else {
-            result->path = static_cast<PathResult*>(malloc(sizeof(PathResult)));
-            if (result->path) {
-                result->path->count = static_cast<int>(arc_ids.size());
-                result->path->arc_ids = static_cast<int*>(malloc(sizeof(int) * arc_ids.size()));
-                if (result->path->arc_ids) {
-                    memcpy(result->path->arc_ids, arc_ids.data(), sizeof(int) * arc_ids.size());
-                } else {
-                    free(result->path);
-                    result->path = nullptr;
-                }
+    return tree;
+}
+
+LEMON_API void lemon_dynamic_sssp_destroy(LemonDynamicSssp tree) {
+    delete static_cast<DynamicShortestPathTree*>(tree);
+}
+
+LEMON_API int lemon_dynamic_sssp_update(LemonDynamicSssp tree, const int* arcs, const double* lengths, int count,
+                                        int* changed_nodes) {
+    if (!tree || count < 0 || (count > 0 && (!arcs || !lengths))) return -1;
+
+    DynamicShortestPathTree* wrapper = static_cast<DynamicShortestPathTree*>(tree);
+    for (int i = 0; i < count; ++i) {
+        if (arcs[i] < 0 || arcs[i] >= wrapper->arc_count()) return -1;
+        if (!(lengths[i] >= 0.0)) return -1;  // negative or NaN
+    }
+    return wrapper->update(arcs, lengths, count, changed_nodes);
+}
+
+LEMON_API int lemon_dynamic_sssp_state(LemonDynamicSssp tree, double* dist, int* pred, double* lengths) {
+    if (!tree) return -1;
+
+    DynamicShortestPathTree* wrapper = static_cast<DynamicShortestPathTree*>(tree);
+    if (dist) std::copy(wrapper->dist().begin(), wrapper->dist().end(), dist);
+    if (pred) std::copy(wrapper->pred().begin(), wrapper->pred().end(), pred);
+    if (lengths) std::copy(wrapper->lengths().begin(), wrapper->lengths().end(), lengths);
+    return wrapper->node_count();
+}
+
+LEMON_API int lemon_dynamic_sssp_source(LemonDynamicSssp tree) {
+    if (!tree) return -1;
+    return static_cast<DynamicShortestPathTree*>(tree)->source();
+}
+
+// Reachability index
+LEMON_API LemonReachabilityIndex lemon_reachability_index_build(LemonGraph graph, int label_count,
+                                                                long long max_bitset_bytes, int thread_count) {
+    if (!graph || label_count < 1 || label_count > 64) return nullptr;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    std::vector<int> component(graph_wrapper->nodes.size());
+    IdBufferMap<SmartDigraph, SmartDigraph::Node> component_map(graph_wrapper->graph, component.data());
+    int component_count = stronglyConnectedComponents(graph_wrapper->graph, component_map);
+
+    ReachabilityIndex* index = new ReachabilityIndex();
+    index->build(get_csr(graph_wrapper, false), component, component_count, label_count, max_bitset_bytes,
+                 resolve_thread_count(thread_count));
+    return index;
+}
+
+LEMON_API LemonReachabilityIndex lemon_reachability_index_load(const unsigned char* data, long long size) {
+    if (!data || size < 0) return nullptr;
+
+    ReachabilityIndex* index = new ReachabilityIndex();
+    if (!index->deserialize(data, size)) {
+        delete index;
+        return nullptr;
+    }
+    return index;
+}
+
+LEMON_API long long lemon_reachability_index_save(LemonReachabilityIndex index, unsigned char* buffer,
+                                                  long long capacity) {
+    if (!index) return -1;
+
+    std::vector<unsigned char> data = static_cast<ReachabilityIndex*>(index)->serialize();
+    long long size = static_cast<long long>(data.size());
+    if (buffer && capacity >= size && size > 0) memcpy(buffer, data.data(), data.size());
+    return size;
+}
+
+LEMON_API void lemon_reachability_index_destroy(LemonReachabilityIndex index) {
+    delete static_cast<ReachabilityIndex*>(index);
+}
+
+LEMON_API int lemon_reachability_index_info(LemonReachabilityIndex index, int* node_count, int* arc_count,
+                                            int* component_count) {
+    if (!index) return -1;
+
+    ReachabilityIndex* wrapper = static_cast<ReachabilityIndex*>(index);
+    if (node_count) *node_count = wrapper->node_count();
+    if (arc_count) *arc_count = wrapper->arc_count();
+    if (component_count) *component_count = wrapper->component_count();
+    return wrapper->bitset_count();
+}
+
+LEMON_API long long lemon_reachability_index_query(LemonReachabilityIndex index, const int* sources,
+                                                   const int* targets, int count, int thread_count,
+                                                   unsigned char* result) {
+    if (!index || count < 0 || (count > 0 && (!sources || !targets || !result))) return -1;
+
+    ReachabilityIndex* wrapper = static_cast<ReachabilityIndex*>(index);
+    for (int i = 0; i < count; ++i) {
+        if (sources[i] < 0 || sources[i] >= wrapper->node_count() ||
+            targets[i] < 0 || targets[i] >= wrapper->node_count()) return -1;
+    }
+    return wrapper->query(sources, targets, count, resolve_thread_count(thread_count), result);
+}
+
+// Scenario sweeps
+LEMON_API int lemon_scenario_batch_run(LemonGraph graph, int algorithm, int source, int target,
+                                       const long long* values, int scenario_count, int thread_count,
+                                       long long* objectives, long long* arc_results) {
+    if (!graph || scenario_count < 0 || (scenario_count > 0 && !objectives)) return -1;
+    if (algorithm != LEMON_SCENARIO_PREFLOW && algorithm != LEMON_SCENARIO_EDMONDS_KARP &&
+        algorithm != LEMON_SCENARIO_DIJKSTRA) {
+        return -1;
+    }
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (source < 0 || source >= node_count || target < 0 || target >= node_count) return -1;
+    if (source == target && algorithm != LEMON_SCENARIO_DIJKSTRA) return -1;
+    if (!values && !graph_wrapper->arcs.empty() && scenario_count > 0) return -1;
+    if (scenario_count == 0) return 0;
+
+    ScenarioBatch batch(graph_wrapper->graph, algorithm, source, target, values, scenario_count);
+    return batch.run(thread_count, objectives, arc_results) ? scenario_count : -1;
+}
+
+// Johnson all-pairs shortest paths
+LEMON_API int lemon_johnson_potentials(LemonGraph graph, LemonArcMap length_map, double* potentials) {
+    if (!graph || !length_map) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return -1;
+    if (!potentials && !graph_wrapper->nodes.empty()) return -1;
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(graph_wrapper->arcs.size());
+    for (size_t a = 0; a < lengths.size(); ++a) {
+        lengths[a] = length_values[graph_wrapper->arcs[a]];
+    }
+
+    QueueBellmanFord bellman_ford(get_csr(graph_wrapper), lengths);
+    if (!bellman_ford.runFromAll()) return 0;
+
+    for (size_t v = 0; v < graph_wrapper->nodes.size(); ++v) {
+        potentials[v] = bellman_ford.dist(static_cast<int>(v));
+    }
+    return 1;
+}
+
+LEMON_API int lemon_johnson_rows(LemonGraph graph, LemonArcMap length_map,
+                                 const double* potentials, int potential_count,
+                                 const int* sources, int source_count, int thread_count,
+                                 double* rows) {
+    if (!graph || !length_map || source_count < 0) return -1;
+    if (source_count > 0 && !sources) return -1;
+
+    GraphWrapper* graph_wrapper = static_cast<GraphWrapper*>(graph);
+    ArcMapWrapper* length_wrapper = static_cast<ArcMapWrapper*>(length_map);
+
+    if (length_wrapper->type != MapType::DOUBLE) return -1;
+
+    // Potentials computed before nodes were added do not cover the graph
+    int node_count = static_cast<int>(graph_wrapper->nodes.size());
+    if (potential_count != node_count || (node_count > 0 && !potentials)) return -1;
+    if (source_count > 0 && node_count > 0 && !rows) return -1;
+    for (int i = 0; i < source_count; ++i) {
+        if (sources[i] < 0 || sources[i] >= node_count) return -1;
+    }
+
+    const SmartDigraph::ArcMap<double>& length_values = *(length_wrapper->double_map);
+    std::vector<double> lengths(graph_wrapper->arcs.size());
+    for (size_t a = 0; a < lengths.size(); ++a) {
+        lengths[a] = length_values[graph_wrapper->arcs[a]];
+    }
+
+    const SmartDigraph& g = graph_wrapper->graph;
+    ReducedLengthMap reduced(g, lengths, potentials);
+    int threads = std::max(1, std::min(resolve_thread_count(thread_count), source_count));
+    std::atomic<int> next_row(0);
+
+    // One Dijkstra instance per thread, reused for all of its rows
+    run_parallel(threads, [&](int) {
+        Dijkstra<SmartDigraph, ReducedLengthMap> dijkstra(g, reduced);
+
+        for (int i = next_row++; i < source_count; i = next_row++) {
+            int s = sources[i];
+            double* row = rows + static_cast<size_t>(i) * node_count;
+
+            dijkstra.run(graph_wrapper->nodes[s]);
+            for (int v = 0; v < node_count; ++v) {
+                SmartDigraph::Node node = graph_wrapper->nodes[v];
+                row[v] = dijkstra.reached(node)
+                    ? dijkstra.dist(node) - potentials[s] + potentials[v]
+                    : std::numeric_limits<double>::infinity();
             }
         }
-    } else {
-        result->distance = std::numeric_limits<double>::infinity();
-        result->path = nullptr;
-    }
-    
-    return result;
+    });
+
+    return source_count;
 }
 
 // Free functions for shortest path results
@@ -544,4 +5929,22 @@ LEMON_API void lemon_free_shortest_path_result(ShortestPathResult* result) {
     }
 }
 
+LEMON_API void lemon_free_shortest_path_result_long(ShortestPathResultLong* result) {
+    if (result) {
+        if (result->path) {
+            lemon_free_path_result(result->path);
+        }
+        free(result);
+    }
+}
+
+LEMON_API void lemon_free_k_shortest_paths_result(KShortestPathsResult* result) {
+    if (result) {
+        free(result->costs);
+        free(result->offsets);
+        free(result->arc_ids);
+        free(result);
+    }
+}
+
 } // extern "C"
\ No newline at end of file
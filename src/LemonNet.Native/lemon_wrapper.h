@@ -18,6 +18,15 @@ extern "C" {
 typedef void* LemonGraph;
 typedef void* LemonArcMap;
 typedef void* LemonNodeMap;
+typedef void* LemonSuurballe;
+typedef void* LemonGomoryHu;
+typedef void* LemonUGraph;
+typedef void* LemonEdgeMap;
+typedef void* LemonMatching;
+typedef void* LemonTraversal;
+typedef void* LemonNearestFacility;
+typedef void* LemonDynamicSssp;
+typedef void* LemonReachabilityIndex;
 
 typedef struct {
     int arc_id;      // The arc identifier
@@ -36,6 +45,42 @@ typedef struct {
     int negative_cycle;       // 1 if negative cycle detected (Bellman-Ford only)
 } ShortestPathResult;
 
+typedef struct {
+    long long distance;        // Exact integer distance from source to target
+    PathResult* path;          // Path from source to target (null if no path)
+    int reached;              // 1 if target was reached, 0 otherwise
+    int negative_cycle;       // 1 if negative cycle detected (Bellman-Ford only)
+} ShortestPathResultLong;
+
+typedef struct {
+    int path_count;            // Number of paths found (at most k)
+    double* costs;             // Total length of each path, non-decreasing
+    int* offsets;              // path_count + 1 entries; path i is arc_ids[offsets[i] .. offsets[i + 1])
+    int* arc_ids;              // Arcs of all paths, concatenated
+} KShortestPathsResult;
+
+typedef struct {
+    int kind;                  // One LEMON_TRAVERSAL_* event bit
+    int node;                  // Node of the event; for arc events the node the traversal moves to
+    int arc;                   // Arc of discover/examine/backtrack events, -1 otherwise
+} LemonTraversalEvent;
+
+// Priority queues for integer-length Dijkstra
+#define LEMON_HEAP_RADIX  0   // RadixHeap (monotone, logarithmic buckets)
+#define LEMON_HEAP_BUCKET 1   // BucketHeap (Dial's algorithm, one bucket per distance)
+
+// Traversal kinds and visitor event bits for the traversal event streams
+#define LEMON_TRAVERSAL_BFS 0
+#define LEMON_TRAVERSAL_DFS 1
+#define LEMON_TRAVERSAL_START     1    // A search tree starts at node
+#define LEMON_TRAVERSAL_REACH     2    // node is reached for the first time
+#define LEMON_TRAVERSAL_DISCOVER  4    // arc leads to an unreached node (a tree arc)
+#define LEMON_TRAVERSAL_EXAMINE   8    // arc leads to an already reached node
+#define LEMON_TRAVERSAL_PROCESS   16   // BFS takes node from the queue
+#define LEMON_TRAVERSAL_LEAVE     32   // DFS has explored all arcs of node
+#define LEMON_TRAVERSAL_BACKTRACK 64   // DFS returns along arc to its source
+#define LEMON_TRAVERSAL_STOP      128  // DFS search tree rooted at node is done
+
 // Graph operations
 LEMON_API LemonGraph lemon_create_graph();
 LEMON_API void lemon_destroy_graph(LemonGraph graph);
@@ -46,6 +91,33 @@ LEMON_API int lemon_arc_target(LemonGraph graph, int arc);
 LEMON_API int lemon_node_count(LemonGraph graph);
 LEMON_API int lemon_arc_count(LemonGraph graph);
 
+// Undirected graph operations (SmartGraph). Node and edge ids are consecutive
+// from zero. The bulk functions return the id of the first added node or edge,
+// or -1 on invalid input (then no edge is added).
+LEMON_API LemonUGraph lemon_create_ugraph();
+LEMON_API void lemon_destroy_ugraph(LemonUGraph graph);
+LEMON_API int lemon_ugraph_add_nodes(LemonUGraph graph, int count);
+LEMON_API int lemon_ugraph_add_edges(LemonUGraph graph, const int* u, const int* v, int count);
+LEMON_API int lemon_edge_u(LemonUGraph graph, int edge);
+LEMON_API int lemon_edge_v(LemonUGraph graph, int edge);
+LEMON_API int lemon_ugraph_node_count(LemonUGraph graph);
+LEMON_API int lemon_ugraph_edge_count(LemonUGraph graph);
+
+// Edge map operations. The read/write functions copy the values of count
+// consecutive edges starting at first_edge and return count, or -1 on
+// invalid input or a map of the other value type.
+LEMON_API LemonEdgeMap lemon_create_edge_map_long(LemonUGraph graph);
+LEMON_API LemonEdgeMap lemon_create_edge_map_double(LemonUGraph graph);
+LEMON_API void lemon_destroy_edge_map(LemonEdgeMap map);
+LEMON_API void lemon_set_edge_value_long(LemonEdgeMap map, int edge, long long value);
+LEMON_API long long lemon_get_edge_value_long(LemonEdgeMap map, int edge);
+LEMON_API void lemon_set_edge_value_double(LemonEdgeMap map, int edge, double value);
+LEMON_API double lemon_get_edge_value_double(LemonEdgeMap map, int edge);
+LEMON_API int lemon_edge_map_read_long(LemonEdgeMap map, int first_edge, long long* values, int count);
+LEMON_API int lemon_edge_map_write_long(LemonEdgeMap map, int first_edge, const long long* values, int count);
+LEMON_API int lemon_edge_map_read_double(LemonEdgeMap map, int first_edge, double* values, int count);
+LEMON_API int lemon_edge_map_write_double(LemonEdgeMap map, int first_edge, const double* values, int count);
+
 // Arc map operations - long values
 LEMON_API LemonArcMap lemon_create_arc_map_long(LemonGraph graph);
 LEMON_API void lemon_destroy_arc_map(LemonArcMap map);
@@ -73,18 +145,393 @@ LEMON_API long long lemon_preflow(LemonGraph graph, LemonArcMap capacity_map,
                               int source, int target,
                               FlowResult** flow_results, int* flow_count);
 
+// Max flow on the graph with some arcs and nodes switched off, e.g. to
+// simulate link or site failures without rebuilding the graph. Bit i of
+// arc_mask (node_mask) enables arc (node) i, in 64-bit words that cover all
+// arc (node) ids; a null mask enables everything. The flow is 0 if the source
+// or the target is disabled.
+LEMON_API long long lemon_edmonds_karp_masked(LemonGraph graph, LemonArcMap capacity_map,
+                                              int source, int target,
+                                              const unsigned long long* arc_mask,
+                                              const unsigned long long* node_mask,
+                                              FlowResult** flow_results, int* flow_count);
+LEMON_API long long lemon_preflow_masked(LemonGraph graph, LemonArcMap capacity_map,
+                                         int source, int target,
+                                         const unsigned long long* arc_mask,
+                                         const unsigned long long* node_mask,
+                                         FlowResult** flow_results, int* flow_count);
+
 LEMON_API void lemon_free_results(FlowResult* results);
 
 // Shortest path algorithms
 LEMON_API ShortestPathResult* lemon_dijkstra(LemonGraph graph, LemonArcMap length_map,
                                              int source, int target);
 
+// Dijkstra on the graph with the arcs and nodes of arc_mask/node_mask
+// enabled, masks as for lemon_preflow_masked
+LEMON_API ShortestPathResult* lemon_dijkstra_masked(LemonGraph graph, LemonArcMap length_map,
+                                                    int source, int target,
+                                                    const unsigned long long* arc_mask,
+                                                    const unsigned long long* node_mask);
+
+// Distance-bounded (multi-source) Dijkstra for service areas/isochrones with
+// non-negative double lengths. Settles only the nodes within bound of the
+// nearest source and writes them in order of distance: node id to node_ids,
+// distance to dist and incoming tree arc to pred (-1 for sources), each
+// holding capacity entries. Returns the number of settled nodes, -1 if
+// capacity is too small, or -2 on invalid input, including a negative or NaN
+// length on an arc leaving a node within the bound.
+LEMON_API int lemon_dijkstra_bounded(LemonGraph graph, LemonArcMap length_map,
+                                     const int* sources, int source_count, double bound,
+                                     int* node_ids, double* dist, int* pred, int capacity);
+
 LEMON_API ShortestPathResult* lemon_bellman_ford(LemonGraph graph, LemonArcMap length_map,
                                                  int source, int target);
 
+// Bellman-Ford variants for lemon_bellman_ford_ex
+#define LEMON_BELLMAN_FORD_ROUNDS 0   // LEMON BellmanFord, rounds over the active nodes
+#define LEMON_BELLMAN_FORD_QUEUE  1   // FIFO queue of active nodes (SPFA) with parent checking
+#define LEMON_BELLMAN_FORD_EDGE_LIST 2 // Parallel rounds over flat arc arrays (SIMD where available)
+
+// Bellman-Ford with a selectable variant. If a negative cycle is found, its arcs are
+// written in order to cycle_arcs (up to cycle_capacity entries) and the full cycle
+// length is stored in cycle_length (0 if there is no negative cycle).
+// thread_count is only used by LEMON_BELLMAN_FORD_EDGE_LIST (<= 0 chooses
+// automatically based on the graph size and hardware).
+LEMON_API ShortestPathResult* lemon_bellman_ford_ex(LemonGraph graph, LemonArcMap length_map,
+                                                   int source, int target, int mode,
+                                                   int thread_count,
+                                                   int* cycle_arcs, int cycle_capacity,
+                                                   int* cycle_length);
+
+// lemon_bellman_ford_ex on the graph with the arcs and nodes of
+// arc_mask/node_mask enabled, masks as for lemon_preflow_masked
+LEMON_API ShortestPathResult* lemon_bellman_ford_masked(LemonGraph graph, LemonArcMap length_map,
+                                                        int source, int target, int mode,
+                                                        int thread_count,
+                                                        const unsigned long long* arc_mask,
+                                                        const unsigned long long* node_mask,
+                                                        int* cycle_arcs, int cycle_capacity,
+                                                        int* cycle_length);
+
+// Integer-length shortest path algorithms (long arc maps)
+LEMON_API ShortestPathResultLong* lemon_dijkstra_long(LemonGraph graph, LemonArcMap length_map,
+                                                      int source, int target, int heap_type);
+
+LEMON_API ShortestPathResultLong* lemon_bellman_ford_long(LemonGraph graph, LemonArcMap length_map,
+                                                          int source, int target);
+
+// Parallel delta-stepping single-source shortest paths (non-negative double lengths).
+// Fills dist[node_count] (infinity if unreachable) and pred[node_count] (incoming
+// tree arc, -1 for the source and unreached nodes). delta <= 0 selects delta
+// automatically, thread_count <= 0 uses all hardware threads.
+// Returns the number of reached nodes, or -1 on invalid input.
+LEMON_API int lemon_delta_stepping(LemonGraph graph, LemonArcMap length_map, int source,
+                                   double delta, int thread_count,
+                                   double* dist, int* pred);
+
+// K shortest simple (loopless) paths from source to target by Yen's algorithm,
+// for non-negative double lengths. Returns up to k paths in order of length,
+// or nullptr on invalid input.
+LEMON_API KShortestPathsResult* lemon_k_shortest_paths(LemonGraph graph, LemonArcMap length_map,
+                                                       int source, int target, int k);
+
+// Disjointness of the paths found by Suurballe's algorithm
+#define LEMON_DISJOINT_ARCS  0    // Paths share no arc
+#define LEMON_DISJOINT_NODES 1    // Paths share no node other than source and target
+
+// Suurballe's algorithm: up to k disjoint source-target paths of minimum total
+// length (non-negative double lengths). Path i is written to
+// arc_ids[path_offsets[i] .. path_offsets[i + 1]), so path_offsets needs k + 1
+// entries; disjoint paths never use more than arc_count arcs in total.
+// Returns the number of paths found (less than k if no more disjoint paths
+// exist), or -1 on invalid input or if arc_capacity is too small.
+LEMON_API int lemon_suurballe(LemonGraph graph, LemonArcMap length_map, int source, int target,
+                              int k, int disjoint, double* total_length, int* path_offsets,
+                              int* arc_ids, int arc_capacity);
+
+// Persistent form for repeated queries. Lengths are copied on creation and the
+// graph must not change afterwards. Consecutive queries from the same source
+// reuse its initial shortest path tree.
+LEMON_API LemonSuurballe lemon_create_suurballe(LemonGraph graph, LemonArcMap length_map, int disjoint);
+LEMON_API void lemon_destroy_suurballe(LemonSuurballe suurballe);
+LEMON_API int lemon_suurballe_run(LemonSuurballe suurballe, int source, int target, int k,
+                                  double* total_length, int* path_offsets,
+                                  int* arc_ids, int arc_capacity);
+
+// Gomory-Hu cut tree of the undirected graph underlying a digraph: every arc
+// is an undirected edge with its (long, non-negative) capacity. Built with
+// n - 1 max flows spread over thread_count threads (<= 0 uses all hardware
+// threads). Returns nullptr on invalid input.
+LEMON_API LemonGomoryHu lemon_gomory_hu_build(LemonGraph graph, LemonArcMap capacity_map, int thread_count);
+
+// Recreates a tree from the arrays returned by lemon_gomory_hu_tree
+// (node 0 is the root with pred -1). Returns nullptr if they are not a tree.
+LEMON_API LemonGomoryHu lemon_gomory_hu_create(int node_count, const int* pred, const long long* weight);
+LEMON_API void lemon_destroy_gomory_hu(LemonGomoryHu tree);
+
+// Copies each node's tree parent and the cut value of that tree edge into
+// pred[node_count] and weight[node_count] (either may be null). Returns node_count.
+LEMON_API int lemon_gomory_hu_tree(LemonGomoryHu tree, int* pred, long long* weight);
+
+// Minimum u-v cut value, or -1 on invalid input
+LEMON_API long long lemon_gomory_hu_min_cut_value(LemonGomoryHu tree, int u, int v);
+
+// Minimum u-v cut value; u_side[node_count] receives 1 for the nodes on u's side
+LEMON_API long long lemon_gomory_hu_min_cut(LemonGomoryHu tree, int u, int v, unsigned char* u_side);
+
+// Writes the arcs of graph crossing the minimum u-v cut (in either direction)
+// to arc_ids. Returns their number, or -1 on invalid input or if arc_capacity is too small.
+LEMON_API int lemon_gomory_hu_min_cut_arcs(LemonGomoryHu tree, LemonGraph graph, int u, int v,
+                                           int* arc_ids, int arc_capacity);
+
+// Global minimum cut with long, non-negative capacities. With undirected == 0
+// the arcs are directed and Hao-Orlin finds a non-empty proper node set with
+// minimum outgoing capacity; otherwise every arc is an undirected edge and
+// Nagamochi-Ibaraki finds a minimum cut. source_side[node_count] (may be null)
+// receives 1 for the nodes of the set (one side for undirected cuts).
+// Returns the cut value, or -1 on invalid input or fewer than two nodes.
+LEMON_API long long lemon_global_min_cut(LemonGraph graph, LemonArcMap capacity_map, int undirected,
+                                         unsigned char* source_side);
+
+// Global minimum cut of an undirected graph (Nagamochi-Ibaraki); side[node_count]
+// receives 1 for the nodes of one side. Returns -1 on invalid input.
+LEMON_API long long lemon_global_min_cut_ugraph(LemonUGraph graph, LemonEdgeMap capacity_map,
+                                                unsigned char* side);
+
+// Maximum weighted matching of an undirected graph (long weights), or with
+// perfect != 0 a maximum weighted perfect matching. The handle keeps the
+// algorithm's structures between runs; each run reads the current values of
+// weight_map. jumpstart != 0 starts the blossom algorithm from a fractional
+// matching instead of the empty one. On success weight receives the matching
+// weight and mate[node_count] each node's mate (-1 if unmatched); either may be
+// null. Returns 1 on success, 0 if no perfect matching exists, -1 on invalid input.
+LEMON_API LemonMatching lemon_create_matching(LemonUGraph graph, int perfect);
+LEMON_API void lemon_destroy_matching(LemonMatching matching);
+LEMON_API int lemon_matching_run(LemonMatching matching, LemonEdgeMap weight_map, int jumpstart,
+                                 long long* weight, int* mate);
+
+// Linear assignment: a minimum cost perfect assignment of rows to columns.
+// lemon_assignment_dense takes a row-major n x n matrix (+inf forbids a pair,
+// NaN and -inf are invalid); lemon_assignment_sparse takes the allowed pairs
+// (rows[e], cols[e]) with finite costs[e] and needs row_count <= col_count.
+// col_for_row[row_count] receives each row's column and total_cost (may be
+// null) the total cost. Returns 1 on success, 0 if no complete assignment
+// exists, -1 on invalid input.
+LEMON_API int lemon_assignment_dense(const double* cost, int n, int* col_for_row, double* total_cost);
+LEMON_API int lemon_assignment_sparse(int row_count, int col_count, const int* rows, const int* cols,
+                                      const double* costs, int entry_count,
+                                      int* col_for_row, double* total_cost);
+
+// Minimum spanning forest. Arcs of a digraph are taken as undirected edges.
+// algorithm is 0 (auto), 1 (Kruskal on radix-sorted weights) or 2 (parallel
+// Boruvka; thread_count <= 0 uses all hardware threads). Ties are broken by
+// id, so every algorithm selects the same edges. The ids are written to
+// arc_ids/edge_ids, which must hold node_count - 1 entries (null with at most
+// one node); total_weight (may be null) receives a long long for long maps and
+// a double for double maps. Returns the number of selected edges or -1 on
+// invalid input, e.g. NaN weights or a weight map of another graph.
+LEMON_API int lemon_spanning_forest(LemonGraph graph, LemonArcMap weight_map, int algorithm,
+                                    int thread_count, int* arc_ids, void* total_weight);
+LEMON_API int lemon_spanning_forest_ugraph(LemonUGraph graph, LemonEdgeMap weight_map, int algorithm,
+                                           int thread_count, int* edge_ids, void* total_weight);
+
+// Strongly connected components, numbered so that no arc leads from a higher
+// to a lower component (a topological order of the components).
+// lemon_strongly_connected_components writes component_of_node[node_count]
+// and returns the number of components. lemon_topological_sort writes the
+// node ids in topological order to order[node_count] and returns 1, or 0 if
+// the graph has a cycle. lemon_is_dag returns 1 for an acyclic graph.
+// lemon_condensation also fills component_of_node and returns a new graph
+// (free with lemon_destroy_graph) whose node c is component c, with one arc
+// per pair of components joined by an arc; its node ids are a topological
+// order. The buffers may be null on a graph without nodes. All return -1
+// (nullptr) on invalid input.
+LEMON_API int lemon_strongly_connected_components(LemonGraph graph, int* component_of_node);
+LEMON_API int lemon_topological_sort(LemonGraph graph, int* order);
+LEMON_API int lemon_is_dag(LemonGraph graph);
+LEMON_API LemonGraph lemon_condensation(LemonGraph graph, int* component_of_node);
+
+// Cut nodes (articulation points), bridges and biconnected components of an
+// undirected graph in linear time. A digraph is viewed through an Undirector,
+// so arcs act as edges without copying the graph. cut_nodes and bridges are
+// bitsets of (count + 63) / 64 words, bit id % 64 of word id / 64 set for each
+// cut node or bridge; both functions return how many they found.
+// block_of_arc/block_of_edge[count] receives the biconnected component of
+// each edge (-1 for self-loops) and the number of components is returned.
+// A buffer may be null when it has no items, e.g. bridges on an arc-less
+// graph. All return -1 on invalid input.
+LEMON_API int lemon_cut_nodes(LemonGraph graph, unsigned long long* cut_nodes);
+LEMON_API int lemon_bridges(LemonGraph graph, unsigned long long* bridges);
+LEMON_API int lemon_biconnected_components(LemonGraph graph, int* block_of_arc);
+LEMON_API int lemon_cut_nodes_ugraph(LemonUGraph graph, unsigned long long* cut_nodes);
+LEMON_API int lemon_bridges_ugraph(LemonUGraph graph, unsigned long long* bridges);
+LEMON_API int lemon_biconnected_components_ugraph(LemonUGraph graph, int* block_of_edge);
+
+// Breadth-first search from source. Fills dist[node_count] with hop counts
+// (-1 if unreachable) and pred[node_count] with the incoming tree arc (-1 for
+// the source and unreached nodes) and returns the number of reached nodes,
+// or -1 on invalid input. lemon_bfs runs LEMON's Bfs.
+// lemon_bfs_direction_optimizing switches between top-down and bottom-up
+// steps over the CSR snapshot: bottom-up once the arcs leaving the frontier
+// exceed 1/alpha of the unexplored arcs, back to top-down once the frontier
+// holds fewer than node_count/beta nodes (alpha/beta <= 0 select 14 and 24).
+// Distances always match; the tree arcs may differ between equally short ones.
+LEMON_API int lemon_bfs(LemonGraph graph, int source, int* dist, int* pred);
+LEMON_API int lemon_bfs_direction_optimizing(LemonGraph graph, int source, int alpha, int beta,
+                                             int* dist, int* pred);
+
+// Level-synchronous parallel BFS with an atomic visited bitset: same outputs
+// as lemon_bfs, tree arcs may differ between equally short ones.
+// thread_count <= 0 uses all hardware threads on graphs of 65536 arcs or more
+// and one thread below that.
+LEMON_API int lemon_parallel_bfs(LemonGraph graph, int source, int thread_count, int* dist, int* pred);
+
+// Connected components with a parallel lock-free union-find (Afforest).
+// Arcs of a digraph count in both directions (weakly connected components).
+// Writes component_of_node[node_count], numbering components in the order of
+// their smallest node id, and returns the number of components, or -1 on
+// invalid input; the buffer may be null on a graph without nodes.
+// thread_count as for lemon_parallel_bfs.
+LEMON_API int lemon_connected_components(LemonGraph graph, int thread_count, int* component_of_node);
+LEMON_API int lemon_connected_components_ugraph(LemonUGraph graph, int thread_count, int* component_of_node);
+
+// Bit-parallel multi-source BFS (MS-BFS): up to 256 sources share one
+// traversal, each node carrying a source mask (four 64-bit lanes, AVX2 when
+// available); more sources run in batches. dist (may be null) receives
+// source_count rows of node_count hop counts, -1 if unreachable; reach (may
+// be null) receives source_count rows of (node_count + 63) / 64 bitset words.
+// Returns the number of reached (source, node) pairs, or -1 on invalid input.
+LEMON_API long long lemon_multi_source_bfs(LemonGraph graph, const int* sources, int source_count,
+                                           int* dist, unsigned long long* reach);
+
+// Traversal event streams: BfsVisit/DfsVisit runs that record visitor events
+// into a ring buffer of capacity events instead of calling back per event.
+// lemon_traversal_start resets the stream: event_mask selects the recorded
+// events, and each unreached source in turn roots a new search tree.
+// lemon_traversal_read advances the traversal until flush_threshold events
+// are buffered (or it ends) and moves up to max_events of them to events; it
+// returns the number moved, 0 once the traversal is finished, -1 on invalid
+// input. The buffer only grows beyond capacity if one step (a BFS node, or a
+// DFS arc with the backtracking it triggers) records more events than are
+// free. The graph must not change while a traversal runs.
+LEMON_API LemonTraversal lemon_traversal_create(LemonGraph graph, int kind, int capacity);
+LEMON_API void lemon_traversal_destroy(LemonTraversal traversal);
+LEMON_API int lemon_traversal_start(LemonTraversal traversal, const int* sources, int source_count,
+                                    int event_mask, int flush_threshold);
+LEMON_API int lemon_traversal_read(LemonTraversal traversal, LemonTraversalEvent* events, int max_events);
+
+// Nearest-facility (graph Voronoi) labels for non-negative double lengths:
+// one Dijkstra seeded with all facilities gives every node its closest
+// facility and the distance to it, ties going to the smaller facility id.
+// Lengths and adjacency are copied on creation, and the graph must not
+// change afterwards. Returns nullptr on invalid input (negative or NaN lengths).
+// lemon_nearest_facility_add/remove update only the cells that change and
+// return the number of nodes that changed facility (0 if the node already
+// was, or was not, a facility). lemon_nearest_facility_labels copies, per
+// node id, the facility to nearest (-1 if unreachable), the distance to dist
+// (infinity if unreachable) and the incoming tree arc to pred (-1 for
+// facilities and unreachable nodes); each may be null. It returns the node
+// count. lemon_nearest_facility_query returns one node's facility and stores
+// its distance. All return -1 on invalid input.
+LEMON_API LemonNearestFacility lemon_nearest_facility_create(LemonGraph graph, LemonArcMap length_map,
+                                                             const int* facilities, int facility_count);
+LEMON_API void lemon_nearest_facility_destroy(LemonNearestFacility labels);
+LEMON_API int lemon_nearest_facility_add(LemonNearestFacility labels, int node);
+LEMON_API int lemon_nearest_facility_remove(LemonNearestFacility labels, int node);
+LEMON_API int lemon_nearest_facility_count(LemonNearestFacility labels);
+LEMON_API int lemon_nearest_facility_labels(LemonNearestFacility labels, int* nearest, double* dist, int* pred);
+LEMON_API int lemon_nearest_facility_query(LemonNearestFacility labels, int node, double* dist);
+
+// Dynamic single-source shortest path tree for non-negative double lengths.
+// Keeps dist/pred of one source and repairs them after arc length changes,
+// touching only the nodes whose distance or tree arc can change. Lengths and
+// adjacency are copied on creation, and the graph must not change afterwards.
+// lemon_dynamic_sssp_create runs Dijkstra, or adopts the given dist/pred (both
+// or neither) after checking they form a shortest path tree of the current
+// lengths; returns nullptr on invalid input. lemon_dynamic_sssp_update sets
+// lengths[i] on arcs[i], repairs the tree, writes the nodes whose distance or
+// tree arc changed to changed_nodes (node_count entries; may be null) and
+// returns their number; negative or NaN lengths are rejected before anything
+// changes. lemon_dynamic_sssp_state copies the distances (infinity if
+// unreachable), tree arcs (-1 for the source and unreachable nodes) and
+// current arc lengths, each may be null, and returns the node count. All
+// return -1 on invalid input.
+LEMON_API LemonDynamicSssp lemon_dynamic_sssp_create(LemonGraph graph, LemonArcMap length_map, int source,
+                                                     const double* dist, const int* pred);
+LEMON_API void lemon_dynamic_sssp_destroy(LemonDynamicSssp tree);
+LEMON_API int lemon_dynamic_sssp_update(LemonDynamicSssp tree, const int* arcs, const double* lengths, int count,
+                                        int* changed_nodes);
+LEMON_API int lemon_dynamic_sssp_state(LemonDynamicSssp tree, double* dist, int* pred, double* lengths);
+LEMON_API int lemon_dynamic_sssp_source(LemonDynamicSssp tree);
+
+// Reachability index over the strongly connected component condensation:
+// components in topological order, descendant ranges, label_count (1..64)
+// GRAIL interval labels, and descendant bitsets over windowed ranges for as
+// many components as fit in max_bitset_bytes; queries that neither decides
+// run a DFS pruned by the labels. Built with thread_count threads (<= 0 uses
+// all hardware threads); returns nullptr on invalid input. The index is a
+// snapshot: the graph may change afterwards, but it keeps answering for the
+// graph it was built from.
+// lemon_reachability_index_save writes the index to buffer if capacity allows
+// and returns its size in bytes; lemon_reachability_index_load restores it and
+// returns nullptr if the data is malformed. lemon_reachability_index_info
+// stores the node, arc and component counts (each may be null) and returns
+// the number of components with a bitset (those without descendants do not
+// need one). lemon_reachability_index_query answers whether sources[i]
+// reaches targets[i] into result[i] (0 or 1) and returns the number of
+// reachable pairs. All return -1 on invalid input.
+LEMON_API LemonReachabilityIndex lemon_reachability_index_build(LemonGraph graph, int label_count,
+                                                                long long max_bitset_bytes, int thread_count);
+LEMON_API LemonReachabilityIndex lemon_reachability_index_load(const unsigned char* data, long long size);
+LEMON_API long long lemon_reachability_index_save(LemonReachabilityIndex index, unsigned char* buffer,
+                                                  long long capacity);
+LEMON_API void lemon_reachability_index_destroy(LemonReachabilityIndex index);
+LEMON_API int lemon_reachability_index_info(LemonReachabilityIndex index, int* node_count, int* arc_count,
+                                            int* component_count);
+LEMON_API long long lemon_reachability_index_query(LemonReachabilityIndex index, const int* sources,
+                                                   const int* targets, int count, int thread_count,
+                                                   unsigned char* result);
+
+// Algorithms for lemon_scenario_batch_run
+#define LEMON_SCENARIO_PREFLOW      0 // max flow; values are capacities, arc results are flows
+#define LEMON_SCENARIO_EDMONDS_KARP 1 // as LEMON_SCENARIO_PREFLOW
+#define LEMON_SCENARIO_DIJKSTRA     2 // shortest path; values are lengths, arc results mark the path
+
+// Solves one graph under scenario_count value vectors on thread_count
+// threads (<= 0 uses all hardware threads), one solver instance per thread.
+// values is column-major: scenario k's value for arc a is
+// values[k * arc_count + a]. objectives[k] receives the flow value, or the
+// distance (LLONG_MAX if target is unreachable); arc_results, if not null,
+// is laid out like values and receives the arc flows, or 1 for the arcs of
+// the shortest path and 0 elsewhere. Returns scenario_count, or -1 on
+// invalid input or if a scenario holds a negative value (its objective is
+// then -1).
+LEMON_API int lemon_scenario_batch_run(LemonGraph graph, int algorithm, int source, int target,
+                                       const long long* values, int scenario_count, int thread_count,
+                                       long long* objectives, long long* arc_results);
+
+// Johnson all-pairs shortest paths (double lengths, negative arcs allowed).
+// lemon_johnson_potentials runs Bellman-Ford from a virtual source joined to
+// every node and stores node potentials in potentials[node_count]. Returns 1 on
+// success, 0 if the graph contains a negative cycle, -1 on invalid input.
+LEMON_API int lemon_johnson_potentials(LemonGraph graph, LemonArcMap length_map, double* potentials);
+
+// Runs Dijkstra on the potential-reduced lengths from each of the sources in
+// parallel (thread_count <= 0 uses all hardware threads) and writes row i, the
+// distances from sources[i] indexed by node id (infinity if unreachable), to
+// rows + i * node_count. potential_count must equal the node count. Returns
+// source_count, or -1 on invalid input.
+LEMON_API int lemon_johnson_rows(LemonGraph graph, LemonArcMap length_map,
+                                 const double* potentials, int potential_count,
+                                 const int* sources, int source_count, int thread_count,
+                                 double* rows);
+
 // Free shortest path results
 LEMON_API void lemon_free_path_result(PathResult* path);
 LEMON_API void lemon_free_shortest_path_result(ShortestPathResult* result);
+LEMON_API void lemon_free_shortest_path_result_long(ShortestPathResultLong* result);
+LEMON_API void lemon_free_k_shortest_paths_result(KShortestPathsResult* result);
 
 #ifdef __cplusplus
 }
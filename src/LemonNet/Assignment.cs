@@ -0,0 +1,113 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Linear assignment: pairs every row with a distinct column at minimum total cost.
+/// </summary>
+/// <remarks>
+/// Dense problems are solved on the cost matrix directly with the Jonker-Volgenant shortest
+/// augmenting path method, whose inner row scan is vectorized where AVX2 is available.
+/// Sparse problems, where only some pairs are allowed, run the same method on a bipartite
+/// graph of the allowed pairs with a heap, so their cost grows with the number of pairs.
+/// </remarks>
+public static class Assignment
+{
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_assignment_dense(double* cost, int n, int* col_for_row, out double total_cost);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_assignment_sparse(int row_count, int col_count, int* rows, int* cols,
+                                                             double* costs, int entry_count,
+                                                             int* col_for_row, out double total_cost);
+
+    #endregion
+
+    /// <summary>
+    /// Solves a square assignment problem.
+    /// </summary>
+    /// <param name="costMatrix">The n x n costs in row-major order; positive infinity forbids a pair.</param>
+    /// <param name="n">The number of rows and columns.</param>
+    /// <returns>The optimal assignment, or null if the forbidden pairs leave no complete assignment.</returns>
+    public static AssignmentResult? Solve(ReadOnlySpan<double> costMatrix, int n)
+    {
+        var columnForRow = new int[Math.Max(n, 0)];
+        return TrySolve(costMatrix, n, columnForRow, out double totalCost)
+            ? new AssignmentResult(totalCost, columnForRow)
+            : null;
+    }
+
+    /// <summary>
+    /// Solves a square assignment problem into a caller-provided buffer.
+    /// </summary>
+    /// <param name="costMatrix">The n x n costs in row-major order; positive infinity forbids a pair.</param>
+    /// <param name="n">The number of rows and columns.</param>
+    /// <param name="columnForRow">Receives the column assigned to each row; must hold at least n entries.</param>
+    /// <param name="totalCost">The total cost of the assignment.</param>
+    /// <returns>True if a complete assignment exists.</returns>
+    public static unsafe bool TrySolve(ReadOnlySpan<double> costMatrix, int n, Span<int> columnForRow, out double totalCost)
+    {
+        if (n < 0)
+            throw new ArgumentOutOfRangeException(nameof(n), "n must be non-negative");
+        if (costMatrix.Length < (long)n * n)
+            throw new ArgumentException("The cost matrix must hold n * n entries", nameof(costMatrix));
+        if (columnForRow.Length < n)
+            throw new ArgumentException("Buffer must hold n entries", nameof(columnForRow));
+
+        int result;
+        fixed (double* costPtr = costMatrix)
+        fixed (int* columnPtr = columnForRow)
+        {
+            result = lemon_assignment_dense(costPtr, n, columnPtr, out totalCost);
+        }
+
+        if (result < 0)
+        {
+            throw new ArgumentException("Costs must not be NaN or negative infinity", nameof(costMatrix));
+        }
+        return result == 1;
+    }
+
+    /// <summary>
+    /// Solves an assignment problem in which only the listed pairs are allowed.
+    /// </summary>
+    /// <param name="rowCount">The number of rows, each of which must be assigned.</param>
+    /// <param name="columnCount">The number of columns; at least <paramref name="rowCount"/>.</param>
+    /// <param name="rows">The row of each allowed pair.</param>
+    /// <param name="columns">The column of each allowed pair.</param>
+    /// <param name="costs">The finite cost of each allowed pair.</param>
+    /// <returns>The optimal assignment, or null if some row cannot be given its own column.</returns>
+    public static unsafe AssignmentResult? SolveSparse(int rowCount, int columnCount, ReadOnlySpan<int> rows,
+                                                       ReadOnlySpan<int> columns, ReadOnlySpan<double> costs)
+    {
+        if (rowCount < 0)
+            throw new ArgumentOutOfRangeException(nameof(rowCount), "Row count must be non-negative");
+        if (columnCount < rowCount)
+            throw new ArgumentOutOfRangeException(nameof(columnCount), "There must be at least as many columns as rows");
+        if (columns.Length != rows.Length)
+            throw new ArgumentException("Row and column spans must have the same length", nameof(columns));
+        if (costs.Length != rows.Length)
+            throw new ArgumentException("Row and cost spans must have the same length", nameof(costs));
+
+        var columnForRow = new int[rowCount];
+        int result;
+        double totalCost;
+        fixed (int* rowPtr = rows)
+        fixed (int* columnPtr = columns)
+        fixed (double* costPtr = costs)
+        fixed (int* resultPtr = columnForRow)
+        {
+            result = lemon_assignment_sparse(rowCount, columnCount, rowPtr, columnPtr, costPtr, rows.Length,
+                                             resultPtr, out totalCost);
+        }
+
+        if (result < 0)
+        {
+            throw new ArgumentException("Pairs must reference valid rows and columns and have finite costs");
+        }
+        return result == 1 ? new AssignmentResult(totalCost, columnForRow) : null;
+    }
+}
@@ -0,0 +1,33 @@
+using System;
+using System.Collections.Generic;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a linear assignment: its total cost and the column chosen for every row.
+/// </summary>
+public class AssignmentResult
+{
+    private readonly int[] columnForRow;
+
+    /// <summary>
+    /// Gets the total cost of the assigned pairs.
+    /// </summary>
+    public double TotalCost { get; }
+
+    /// <summary>
+    /// Gets the column assigned to each row.
+    /// </summary>
+    public IReadOnlyList<int> ColumnForRow => columnForRow;
+
+    public AssignmentResult(double totalCost, int[] columnForRow)
+    {
+        TotalCost = totalCost;
+        this.columnForRow = columnForRow ?? Array.Empty<int>();
+    }
+
+    public override string ToString()
+    {
+        return $"Assignment: Total cost = {TotalCost}, Rows: {columnForRow.Length}";
+    }
+}
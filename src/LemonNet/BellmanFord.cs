@@ -4,6 +4,33 @@ using System.Runtime.InteropServices;
 
 namespace LemonNet;
 
+/// <summary>
+/// Selects how <see cref="BellmanFord"/> schedules its relaxations.
+/// </summary>
+public enum BellmanFordMode
+{
+    /// <summary>
+    /// LEMON's round-based algorithm: each round relaxes the out-arcs of the nodes
+    /// whose distance changed in the previous round.
+    /// </summary>
+    Rounds = 0,
+
+    /// <summary>
+    /// FIFO queue of active nodes (SPFA) with parent checking and periodic
+    /// negative cycle search. Usually finishes much earlier on graphs with few
+    /// improving paths.
+    /// </summary>
+    Queue = 1,
+
+    /// <summary>
+    /// Round-synchronous relaxation of all arcs from flat source/target/length
+    /// arrays. Rounds are split across threads by target node and candidate
+    /// distances are computed with SIMD gathers where the CPU supports them.
+    /// Suited to large dense graphs such as currency arbitrage networks.
+    /// </summary>
+    EdgeList = 2
+}
+
 /// <summary>
 /// Bellman-Ford shortest path algorithm implementation.
 /// Finds shortest paths from a source node to other nodes in a digraph.
@@ -34,7 +61,11 @@ public class BellmanFord : IDisposable
     }
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
-    private static extern IntPtr lemon_bellman_ford(IntPtr graph, IntPtr length_map, int source, int target);
+    private static extern unsafe IntPtr lemon_bellman_ford_masked(IntPtr graph, IntPtr length_map, int source, int target,
+                                                                  int mode, int thread_count,
+                                                                  ulong* arc_mask, ulong* node_mask,
+                                                                  int[] cycle_arcs, int cycle_capacity,
+                                                                  out int cycle_length);
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
     private static extern void lemon_free_shortest_path_result(IntPtr result);
@@ -52,13 +83,36 @@ public class BellmanFord : IDisposable
         this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
     }
 
+    /// <summary>
+    /// Gets or sets how relaxations are scheduled. Defaults to <see cref="BellmanFordMode.Rounds"/>.
+    /// </summary>
+    public BellmanFordMode Mode { get; set; } = BellmanFordMode.Rounds;
+
+    /// <summary>
+    /// Gets or sets the number of worker threads used by <see cref="BellmanFordMode.EdgeList"/>.
+    /// Zero or less chooses automatically: one thread for small graphs, otherwise
+    /// the hardware thread count.
+    /// </summary>
+    public int ThreadCount { get; set; } = 0;
+
     /// <summary>
     /// Runs the Bellman-Ford algorithm from the source to the target node.
     /// </summary>
     /// <param name="source">The source node.</param>
     /// <param name="target">The target node.</param>
     /// <returns>The shortest path result.</returns>
-    public ShortestPathResult Run(Node source, Node target)
+    public ShortestPathResult Run(Node source, Node target) => Run(source, target, null);
+
+    /// <summary>
+    /// Runs the Bellman-Ford algorithm on the graph without the arcs and nodes disabled in a mask,
+    /// e.g. to evaluate a failure scenario without rebuilding the graph. Negative cycles through
+    /// disabled arcs or nodes are not found.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <param name="mask">The enabled arcs and nodes, or null for the whole graph.</param>
+    /// <returns>The shortest path result; a disabled source or target is unreachable.</returns>
+    public unsafe ShortestPathResult Run(Node source, Node target, GraphMask? mask)
     {
         ThrowIfDisposed();
 
@@ -66,8 +120,19 @@ public class BellmanFord : IDisposable
             throw new ArgumentException("Invalid source node", nameof(source));
         if (!target.IsValid)
             throw new ArgumentException("Invalid target node", nameof(target));
+        mask?.Validate(graph, nameof(mask));
 
-        IntPtr resultPtr = lemon_bellman_ford(graph.Handle, lengthMap.Handle, source.Id, target.Id);
+        // A simple cycle has at most one arc per node
+        int[] cycleArcIds = new int[graph.NodeCount];
+        IntPtr resultPtr;
+        int cycleLength;
+        fixed (ulong* arcMask = mask?.ArcWords)
+        fixed (ulong* nodeMask = mask?.NodeWords)
+        {
+            resultPtr = lemon_bellman_ford_masked(graph.Handle, lengthMap.Handle, source.Id, target.Id,
+                                                  (int)Mode, ThreadCount, arcMask, nodeMask,
+                                                  cycleArcIds, cycleArcIds.Length, out cycleLength);
+        }
         
         if (resultPtr == IntPtr.Zero)
         {
@@ -84,7 +149,18 @@ public class BellmanFord : IDisposable
 
             if (hasNegativeCycle)
             {
-                return ShortestPathResult.NegativeCycle();
+                Path? cycle = null;
+                if (cycleLength > 0 && cycleLength <= cycleArcIds.Length)
+                {
+                    Arc[] cycleArcs = new Arc[cycleLength];
+                    for (int i = 0; i < cycleLength; i++)
+                    {
+                        cycleArcs[i] = new Arc(cycleArcIds[i]);
+                    }
+                    cycle = new Path(graph, cycleArcs);
+                }
+
+                return ShortestPathResult.NegativeCycle(cycle);
             }
 
             if (reached && nativeResult.path != IntPtr.Zero)
@@ -147,6 +223,17 @@ public class BellmanFord : IDisposable
         return result.Distance;
     }
 
+    /// <summary>
+    /// Finds a negative cycle reachable from the source node.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <returns>The arcs of a negative cycle in order, or null if there is none.</returns>
+    public Path? FindNegativeCycle(Node source)
+    {
+        var result = Run(source, source);
+        return result.Cycle;
+    }
+
     /// <summary>
     /// Checks if there is a negative cycle reachable from the source node.
     /// </summary>
@@ -0,0 +1,156 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Bellman-Ford shortest path algorithm over integer arc lengths.
+/// Supports negative arc lengths, detects negative cycles and returns exact integer distances.
+/// </summary>
+public class BellmanFordLong : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private readonly ArcMap lengthMap;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativePathResult
+    {
+        public IntPtr arc_ids;
+        public int count;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeShortestPathResultLong
+    {
+        public long distance;
+        public IntPtr path;
+        public int reached;
+        public int negative_cycle;
+    }
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_bellman_ford_long(IntPtr graph, IntPtr length_map, int source, int target);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_free_shortest_path_result_long(IntPtr result);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new instance of the Bellman-Ford algorithm for integer arc lengths.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing integer arc lengths (can be negative).</param>
+    public BellmanFordLong(LemonDigraph graph, ArcMap lengthMap)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
+
+        if (lengthMap.ParentGraph != graph)
+        {
+            throw new ArgumentException("Length map must belong to the same graph", nameof(lengthMap));
+        }
+    }
+
+    /// <summary>
+    /// Runs the Bellman-Ford algorithm from the source to the target node.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <returns>The shortest path result.</returns>
+    public ShortestPathResultLong Run(Node source, Node target)
+    {
+        ThrowIfDisposed();
+
+        if (!source.IsValid)
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (!target.IsValid)
+            throw new ArgumentException("Invalid target node", nameof(target));
+
+        IntPtr resultPtr = lemon_bellman_ford_long(graph.Handle, lengthMap.Handle, source.Id, target.Id);
+
+        if (resultPtr == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to compute shortest path");
+        }
+
+        try
+        {
+            NativeShortestPathResultLong nativeResult = Marshal.PtrToStructure<NativeShortestPathResultLong>(resultPtr);
+
+            if (nativeResult.negative_cycle != 0)
+            {
+                return ShortestPathResultLong.NegativeCycle();
+            }
+
+            if (nativeResult.reached == 0)
+            {
+                return ShortestPathResultLong.Unreachable();
+            }
+
+            Path path = new Path(graph);
+
+            if (nativeResult.path != IntPtr.Zero)
+            {
+                NativePathResult nativePath = Marshal.PtrToStructure<NativePathResult>(nativeResult.path);
+
+                if (nativePath.count > 0 && nativePath.arc_ids != IntPtr.Zero)
+                {
+                    int[] arcIds = new int[nativePath.count];
+                    Marshal.Copy(nativePath.arc_ids, arcIds, 0, nativePath.count);
+
+                    Arc[] arcs = new Arc[nativePath.count];
+                    for (int i = 0; i < nativePath.count; i++)
+                    {
+                        arcs[i] = new Arc(arcIds[i]);
+                    }
+
+                    path = new Path(graph, arcs);
+                }
+            }
+
+            return new ShortestPathResultLong(nativeResult.distance, path, true, false);
+        }
+        finally
+        {
+            lemon_free_shortest_path_result_long(resultPtr);
+        }
+    }
+
+    /// <summary>
+    /// Finds the shortest distance from source to target.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <returns>The shortest distance, or long.MaxValue if no path exists or a negative cycle is detected.</returns>
+    public long FindDistance(Node source, Node target)
+    {
+        var result = Run(source, target);
+        return result.Distance;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+}
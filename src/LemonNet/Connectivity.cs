@@ -0,0 +1,343 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Graph connectivity queries that fill whole arrays in one native call: parallel connected
+/// components, strongly connected components and topological order of digraphs, and cut nodes,
+/// bridges and biconnected components of undirected graphs.
+/// </summary>
+public static class Connectivity
+{
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_strongly_connected_components(IntPtr graph, int* component_of_node);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_topological_sort(IntPtr graph, int* order);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_is_dag(IntPtr graph);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe IntPtr lemon_condensation(IntPtr graph, int* component_of_node);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_cut_nodes(IntPtr graph, ulong* cut_nodes);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_bridges(IntPtr graph, ulong* bridges);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_biconnected_components(IntPtr graph, int* block_of_arc);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_cut_nodes_ugraph(IntPtr graph, ulong* cut_nodes);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_bridges_ugraph(IntPtr graph, ulong* bridges);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_biconnected_components_ugraph(IntPtr graph, int* block_of_edge);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_connected_components(IntPtr graph, int thread_count, int* component_of_node);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_connected_components_ugraph(IntPtr graph, int thread_count, int* component_of_node);
+
+    #endregion
+
+    /// <summary>
+    /// Finds the weakly connected components of a digraph, i.e. the connected components when
+    /// arcs are taken as undirected edges.
+    /// </summary>
+    /// <remarks>
+    /// Runs a parallel lock-free union-find (Afforest): a few neighbors of every node are linked
+    /// first, which merges most of a giant component, and the remaining arcs are only visited for
+    /// nodes outside it. Components are numbered in the order of their smallest node id.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="componentOfNode">Receives the component of each node by node id; must hold NodeCount entries.</param>
+    /// <param name="threadCount">Number of threads. Zero uses all hardware threads on graphs with at least 65536 arcs.</param>
+    /// <returns>The number of components.</returns>
+    public static unsafe int ConnectedComponents(LemonDigraph graph, Span<int> componentOfNode, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBuffer(graph.NodeCount, componentOfNode.Length, nameof(componentOfNode));
+
+        fixed (int* components = componentOfNode)
+        {
+            return lemon_connected_components(graph.Handle, threadCount, components);
+        }
+    }
+
+    /// <summary>
+    /// Finds the connected components of an undirected graph.
+    /// </summary>
+    /// <remarks>
+    /// Runs the same parallel union-find as <see cref="ConnectedComponents(LemonDigraph, Span{int}, int)"/>.
+    /// Components are numbered in the order of their smallest node id.
+    /// </remarks>
+    /// <param name="graph">The undirected graph.</param>
+    /// <param name="componentOfNode">Receives the component of each node by node id; must hold NodeCount entries.</param>
+    /// <param name="threadCount">Number of threads. Zero uses all hardware threads on graphs with at least 32768 edges.</param>
+    /// <returns>The number of components.</returns>
+    public static unsafe int ConnectedComponents(LemonGraph graph, Span<int> componentOfNode, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBuffer(graph.NodeCount, componentOfNode.Length, nameof(componentOfNode));
+
+        fixed (int* components = componentOfNode)
+        {
+            return lemon_connected_components_ugraph(graph.Handle, threadCount, components);
+        }
+    }
+
+    /// <summary>
+    /// Finds the strongly connected components of a digraph.
+    /// </summary>
+    /// <remarks>
+    /// Components are numbered so that no arc leads from a higher numbered component to a
+    /// lower one, i.e. the numbering is a topological order of the components.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="componentOfNode">Receives the component of each node by node id; must hold NodeCount entries.</param>
+    /// <returns>The number of components.</returns>
+    public static unsafe int StronglyConnectedComponents(LemonDigraph graph, Span<int> componentOfNode)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBuffer(graph.NodeCount, componentOfNode.Length, nameof(componentOfNode));
+
+        fixed (int* components = componentOfNode)
+        {
+            return lemon_strongly_connected_components(graph.Handle, components);
+        }
+    }
+
+    /// <summary>
+    /// Sorts the nodes of an acyclic digraph so that every arc leads forward.
+    /// </summary>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="order">Receives the nodes in topological order; must hold NodeCount entries.</param>
+    /// <returns>True if the graph is acyclic; false if it has a cycle and no order exists.</returns>
+    public static unsafe bool TopologicalSort(LemonDigraph graph, Span<Node> order)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBuffer(graph.NodeCount, order.Length, nameof(order));
+
+        fixed (int* ids = MemoryMarshal.Cast<Node, int>(order))
+        {
+            return lemon_topological_sort(graph.Handle, ids) == 1;
+        }
+    }
+
+    /// <summary>
+    /// Checks whether a digraph has no directed cycle.
+    /// </summary>
+    /// <param name="graph">The digraph.</param>
+    /// <returns>True if the graph is acyclic.</returns>
+    public static bool IsDag(LemonDigraph graph)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+
+        return lemon_is_dag(graph.Handle) == 1;
+    }
+
+    /// <summary>
+    /// Builds the condensation of a digraph: the acyclic graph of its strongly connected components.
+    /// </summary>
+    /// <remarks>
+    /// Node c of the result stands for component c, and there is a single arc for every pair
+    /// of components joined by at least one arc. Because components are numbered in
+    /// topological order, the node ids of the condensation are a topological order too.
+    /// The result is an ordinary <see cref="LemonDigraph"/> that any algorithm can run on.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="componentOfNode">Receives the component of each node by node id; must hold NodeCount entries.</param>
+    /// <returns>The condensed digraph, owned by the caller.</returns>
+    public static unsafe LemonDigraph Condense(LemonDigraph graph, Span<int> componentOfNode)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBuffer(graph.NodeCount, componentOfNode.Length, nameof(componentOfNode));
+
+        IntPtr handle;
+        fixed (int* components = componentOfNode)
+        {
+            handle = lemon_condensation(graph.Handle, components);
+        }
+
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to build condensation");
+        }
+        return new LemonDigraph(handle);
+    }
+
+    /// <summary>
+    /// Gets the number of 64-bit words of a bitset over <paramref name="count"/> items.
+    /// </summary>
+    public static int BitsetLength(int count) => (count + 63) / 64;
+
+    /// <summary>
+    /// Checks whether a node's bit is set in a bitset filled by <see cref="CutNodes(LemonDigraph, Span{ulong})"/>.
+    /// </summary>
+    public static bool IsSet(ReadOnlySpan<ulong> bitset, Node node) => IsSet(bitset, node.Id);
+
+    /// <summary>
+    /// Checks whether an arc's bit is set in a bitset filled by <see cref="Bridges(LemonDigraph, Span{ulong})"/>.
+    /// </summary>
+    public static bool IsSet(ReadOnlySpan<ulong> bitset, Arc arc) => IsSet(bitset, arc.Id);
+
+    /// <summary>
+    /// Checks whether an edge's bit is set in a bitset filled by <see cref="Bridges(LemonGraph, Span{ulong})"/>.
+    /// </summary>
+    public static bool IsSet(ReadOnlySpan<ulong> bitset, Edge edge) => IsSet(bitset, edge.Id);
+
+    /// <summary>
+    /// Finds the cut nodes (articulation points) of a digraph whose arcs are taken as undirected edges.
+    /// </summary>
+    /// <remarks>
+    /// A cut node is one whose removal disconnects its connected component. The digraph is
+    /// viewed as undirected without being copied, and the search runs in linear time.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="cutNodes">Receives a bitset over node ids; must hold <see cref="BitsetLength"/>(NodeCount) words.</param>
+    /// <returns>The number of cut nodes.</returns>
+    public static unsafe int CutNodes(LemonDigraph graph, Span<ulong> cutNodes)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBitset(graph.NodeCount, cutNodes.Length, nameof(cutNodes));
+
+        fixed (ulong* bits = cutNodes)
+        {
+            return lemon_cut_nodes(graph.Handle, bits);
+        }
+    }
+
+    /// <summary>
+    /// Finds the cut nodes (articulation points) of an undirected graph.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="cutNodes">Receives a bitset over node ids; must hold <see cref="BitsetLength"/>(NodeCount) words.</param>
+    /// <returns>The number of cut nodes.</returns>
+    public static unsafe int CutNodes(LemonGraph graph, Span<ulong> cutNodes)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBitset(graph.NodeCount, cutNodes.Length, nameof(cutNodes));
+
+        fixed (ulong* bits = cutNodes)
+        {
+            return lemon_cut_nodes_ugraph(graph.Handle, bits);
+        }
+    }
+
+    /// <summary>
+    /// Finds the bridges of a digraph whose arcs are taken as undirected edges.
+    /// </summary>
+    /// <remarks>
+    /// A bridge is an edge whose removal disconnects its connected component; of two parallel
+    /// arcs between the same nodes, neither is a bridge.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="bridges">Receives a bitset over arc ids; must hold <see cref="BitsetLength"/>(ArcCount) words.</param>
+    /// <returns>The number of bridges.</returns>
+    public static unsafe int Bridges(LemonDigraph graph, Span<ulong> bridges)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBitset(graph.ArcCount, bridges.Length, nameof(bridges));
+
+        fixed (ulong* bits = bridges)
+        {
+            return lemon_bridges(graph.Handle, bits);
+        }
+    }
+
+    /// <summary>
+    /// Finds the bridges of an undirected graph.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="bridges">Receives a bitset over edge ids; must hold <see cref="BitsetLength"/>(EdgeCount) words.</param>
+    /// <returns>The number of bridges.</returns>
+    public static unsafe int Bridges(LemonGraph graph, Span<ulong> bridges)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        ValidateBitset(graph.EdgeCount, bridges.Length, nameof(bridges));
+
+        fixed (ulong* bits = bridges)
+        {
+            return lemon_bridges_ugraph(graph.Handle, bits);
+        }
+    }
+
+    /// <summary>
+    /// Finds the biconnected components (blocks) of a digraph whose arcs are taken as undirected edges.
+    /// </summary>
+    /// <remarks>
+    /// Every arc belongs to exactly one block; two arcs share a block if they lie on a common
+    /// cycle. A bridge forms a block of its own. Self-loops belong to no block.
+    /// </remarks>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="blockOfArc">Receives the block of each arc by arc id, or -1; must hold ArcCount entries.</param>
+    /// <returns>The number of blocks.</returns>
+    public static unsafe int BiconnectedComponents(LemonDigraph graph, Span<int> blockOfArc)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (blockOfArc.Length < graph.ArcCount)
+            throw new ArgumentException("Buffer must hold ArcCount entries", nameof(blockOfArc));
+
+        fixed (int* blocks = blockOfArc)
+        {
+            return lemon_biconnected_components(graph.Handle, blocks);
+        }
+    }
+
+    /// <summary>
+    /// Finds the biconnected components (blocks) of an undirected graph.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="blockOfEdge">Receives the block of each edge by edge id, or -1; must hold EdgeCount entries.</param>
+    /// <returns>The number of blocks.</returns>
+    public static unsafe int BiconnectedComponents(LemonGraph graph, Span<int> blockOfEdge)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (blockOfEdge.Length < graph.EdgeCount)
+            throw new ArgumentException("Buffer must hold EdgeCount entries", nameof(blockOfEdge));
+
+        fixed (int* blocks = blockOfEdge)
+        {
+            return lemon_biconnected_components_ugraph(graph.Handle, blocks);
+        }
+    }
+
+    private static bool IsSet(ReadOnlySpan<ulong> bitset, int id)
+    {
+        return id >= 0 && (id >> 6) < bitset.Length && ((bitset[id >> 6] >> (id & 63)) & 1) != 0;
+    }
+
+    private static void ValidateBitset(int count, int length, string paramName)
+    {
+        if (length < BitsetLength(count))
+            throw new ArgumentException("Bitset must hold (count + 63) / 64 words", paramName);
+    }
+
+    private static void ValidateBuffer(int nodeCount, int length, string paramName)
+    {
+        if (length < nodeCount)
+            throw new ArgumentException("Buffer must hold NodeCount entries", paramName);
+    }
+}
@@ -0,0 +1,119 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Parallel delta-stepping single-source shortest path algorithm.
+/// Computes the full shortest path tree from a source over non-negative arc lengths,
+/// producing the same distances as <see cref="Dijkstra"/> but using multiple threads.
+/// </summary>
+public class DeltaStepping : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private readonly ArcMapDouble lengthMap;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_delta_stepping(IntPtr graph, IntPtr length_map, int source,
+                                                          double delta, int thread_count,
+                                                          double* dist, int* pred);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new delta-stepping instance.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing non-negative arc lengths.</param>
+    public DeltaStepping(LemonDigraph graph, ArcMapDouble lengthMap)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
+    }
+
+    /// <summary>
+    /// Gets or sets the bucket width. Arcs not longer than delta are relaxed
+    /// repeatedly within a bucket, longer arcs once per bucket.
+    /// Zero (the default) selects delta automatically from the length range and average degree.
+    /// </summary>
+    public double Delta { get; set; }
+
+    /// <summary>
+    /// Gets or sets the number of worker threads. Zero (the default) uses all hardware threads.
+    /// </summary>
+    public int ThreadCount { get; set; }
+
+    /// <summary>
+    /// Computes the shortest path tree from the source node.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <returns>The shortest path tree.</returns>
+    public ShortestPathTree Run(Node source)
+    {
+        var distances = new double[graph.NodeCount];
+        var predecessorArcIds = new int[graph.NodeCount];
+        int reached = Run(source, distances, predecessorArcIds);
+        return new ShortestPathTree(graph, source, distances, predecessorArcIds, reached);
+    }
+
+    /// <summary>
+    /// Computes the shortest path tree from the source node into caller-provided buffers.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="distances">Receives the distance of every node, indexed by node id.</param>
+    /// <param name="predecessorArcIds">Receives the incoming tree arc id of every node (-1 if none).</param>
+    /// <returns>The number of nodes reached from the source.</returns>
+    public unsafe int Run(Node source, Span<double> distances, Span<int> predecessorArcIds)
+    {
+        ThrowIfDisposed();
+
+        if (!graph.IsValid(source))
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (distances.Length < graph.NodeCount)
+            throw new ArgumentException("Buffer must hold one entry per node", nameof(distances));
+        if (predecessorArcIds.Length < graph.NodeCount)
+            throw new ArgumentException("Buffer must hold one entry per node", nameof(predecessorArcIds));
+        if (Delta < 0 || double.IsNaN(Delta))
+            throw new InvalidOperationException("Delta must be non-negative");
+
+        int reached;
+        fixed (double* dist = distances)
+        fixed (int* pred = predecessorArcIds)
+        {
+            reached = lemon_delta_stepping(graph.Handle, lengthMap.Handle, source.Id,
+                                           Delta, ThreadCount, dist, pred);
+        }
+
+        if (reached < 0)
+        {
+            throw new InvalidOperationException("Failed to compute shortest paths (arc lengths must be non-negative)");
+        }
+
+        return reached;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+}
@@ -33,11 +33,17 @@ public class Dijkstra : IDisposable
     }
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
-    private static extern IntPtr lemon_dijkstra(IntPtr graph, IntPtr length_map, int source, int target);
+    private static extern unsafe IntPtr lemon_dijkstra_masked(IntPtr graph, IntPtr length_map, int source, int target,
+                                                              ulong* arc_mask, ulong* node_mask);
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
     private static extern void lemon_free_shortest_path_result(IntPtr result);
 
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_dijkstra_bounded(IntPtr graph, IntPtr length_map,
+                                                            int* sources, int source_count, double bound,
+                                                            int* node_ids, double* dist, int* pred, int capacity);
+
     #endregion
 
     /// <summary>
@@ -57,7 +63,17 @@ public class Dijkstra : IDisposable
     /// <param name="source">The source node.</param>
     /// <param name="target">The target node.</param>
     /// <returns>The shortest path result.</returns>
-    public ShortestPathResult Run(Node source, Node target)
+    public ShortestPathResult Run(Node source, Node target) => Run(source, target, null);
+
+    /// <summary>
+    /// Runs Dijkstra's algorithm on the graph without the arcs and nodes disabled in a mask,
+    /// e.g. to evaluate a failure scenario without rebuilding the graph.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <param name="mask">The enabled arcs and nodes, or null for the whole graph.</param>
+    /// <returns>The shortest path result; a disabled source or target is unreachable.</returns>
+    public unsafe ShortestPathResult Run(Node source, Node target, GraphMask? mask)
     {
         ThrowIfDisposed();
 
@@ -65,8 +81,15 @@ public class Dijkstra : IDisposable
             throw new ArgumentException("Invalid source node", nameof(source));
         if (!target.IsValid)
             throw new ArgumentException("Invalid target node", nameof(target));
+        mask?.Validate(graph, nameof(mask));
 
-        IntPtr resultPtr = lemon_dijkstra(graph.Handle, lengthMap.Handle, source.Id, target.Id);
+        IntPtr resultPtr;
+        fixed (ulong* arcMask = mask?.ArcWords)
+        fixed (ulong* nodeMask = mask?.NodeWords)
+        {
+            resultPtr = lemon_dijkstra_masked(graph.Handle, lengthMap.Handle, source.Id, target.Id,
+                                              arcMask, nodeMask);
+        }
         
         if (resultPtr == IntPtr.Zero)
         {
@@ -140,6 +163,94 @@ public class Dijkstra : IDisposable
         return result.Distance;
     }
 
+    /// <summary>
+    /// Finds all nodes within a distance bound of a source, e.g. the service area around a depot.
+    /// </summary>
+    /// <remarks>
+    /// The search stops as soon as the closest unsettled node lies beyond the bound, so it only
+    /// touches the neighborhood of the source instead of computing a full shortest path tree.
+    /// </remarks>
+    /// <param name="source">The source node.</param>
+    /// <param name="bound">The largest distance to include.</param>
+    /// <returns>The nodes within the bound in order of distance.</returns>
+    public Isochrone RunBounded(Node source, double bound)
+    {
+        return RunBounded(stackalloc Node[] { source }, bound);
+    }
+
+    /// <summary>
+    /// Finds all nodes within a distance bound of the nearest of several sources.
+    /// </summary>
+    /// <param name="sources">The source nodes, all at distance zero.</param>
+    /// <param name="bound">The largest distance to include.</param>
+    /// <returns>The nodes within the bound in order of distance.</returns>
+    public Isochrone RunBounded(ReadOnlySpan<Node> sources, double bound)
+    {
+        int capacity = Math.Min(graph.NodeCount, Math.Max(sources.Length, 1024));
+        while (true)
+        {
+            var nodes = new Node[capacity];
+            var distances = new double[capacity];
+            var predecessorArcIds = new int[capacity];
+            if (TryRunBounded(sources, bound, nodes, distances, predecessorArcIds, out int count))
+            {
+                return new Isochrone(bound, nodes, distances, predecessorArcIds, count);
+            }
+            if (capacity == graph.NodeCount)
+            {
+                throw new InvalidOperationException("Failed to run bounded search");
+            }
+            capacity = (int)Math.Min(graph.NodeCount, 4L * capacity);
+        }
+    }
+
+    /// <summary>
+    /// Finds all nodes within a distance bound of the nearest source into caller-provided buffers.
+    /// </summary>
+    /// <param name="sources">The source nodes, all at distance zero.</param>
+    /// <param name="bound">The largest distance to include.</param>
+    /// <param name="nodes">Receives the nodes within the bound in order of distance.</param>
+    /// <param name="distances">Receives the distance of each of these nodes.</param>
+    /// <param name="predecessorArcIds">Receives the incoming tree arc id of each of these nodes (-1 for sources).</param>
+    /// <param name="count">The number of nodes written.</param>
+    /// <returns>False if more nodes lie within the bound than the buffers hold.</returns>
+    /// <exception cref="ArgumentException">An arc leaving a node within the bound has a negative or NaN length.</exception>
+    public unsafe bool TryRunBounded(ReadOnlySpan<Node> sources, double bound, Span<Node> nodes,
+                                     Span<double> distances, Span<int> predecessorArcIds, out int count)
+    {
+        ThrowIfDisposed();
+
+        foreach (var source in sources)
+        {
+            if (!graph.IsValid(source))
+                throw new ArgumentException("Invalid source node", nameof(sources));
+        }
+        if (double.IsNaN(bound))
+            throw new ArgumentException("Bound must be a number", nameof(bound));
+        if (distances.Length < nodes.Length)
+            throw new ArgumentException("Buffer must be as long as nodes", nameof(distances));
+        if (predecessorArcIds.Length < nodes.Length)
+            throw new ArgumentException("Buffer must be as long as nodes", nameof(predecessorArcIds));
+
+        fixed (int* sourceIds = MemoryMarshal.Cast<Node, int>(sources))
+        fixed (int* nodeIds = MemoryMarshal.Cast<Node, int>(nodes))
+        fixed (double* dist = distances)
+        fixed (int* pred = predecessorArcIds)
+        {
+            count = lemon_dijkstra_bounded(graph.Handle, lengthMap.Handle, sourceIds, sources.Length, bound,
+                                           nodeIds, dist, pred, nodes.Length);
+        }
+
+        if (count == -2)
+            throw new ArgumentException("Arc lengths within the bound must be non-negative numbers");
+        if (count < 0)
+        {
+            count = 0;
+            return false;
+        }
+        return true;
+    }
+
     private void ThrowIfDisposed()
     {
         if (disposed)
@@ -0,0 +1,190 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Priority queue used by <see cref="DijkstraLong"/>.
+/// </summary>
+public enum IntegerHeap
+{
+    /// <summary>
+    /// Radix heap with logarithmically growing buckets. Good default for any weight range.
+    /// </summary>
+    Radix = 0,
+
+    /// <summary>
+    /// Bucket heap with one bucket per distance value (Dial's algorithm).
+    /// Fastest when arc lengths are small integers.
+    /// </summary>
+    Bucket = 1
+}
+
+/// <summary>
+/// Dijkstra's shortest path algorithm over integer arc lengths.
+/// Uses a monotone integer priority queue instead of a comparison heap and
+/// returns exact integer distances.
+/// </summary>
+public class DijkstraLong : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private readonly ArcMap lengthMap;
+    private readonly IntegerHeap heap;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativePathResult
+    {
+        public IntPtr arc_ids;
+        public int count;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeShortestPathResultLong
+    {
+        public long distance;
+        public IntPtr path;
+        public int reached;
+        public int negative_cycle;
+    }
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_dijkstra_long(IntPtr graph, IntPtr length_map, int source, int target, int heap_type);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_free_shortest_path_result_long(IntPtr result);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new instance of Dijkstra's algorithm for integer arc lengths.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing non-negative integer arc lengths.</param>
+    /// <param name="heap">The integer priority queue to use.</param>
+    public DijkstraLong(LemonDigraph graph, ArcMap lengthMap, IntegerHeap heap = IntegerHeap.Radix)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
+        this.heap = heap;
+
+        if (lengthMap.ParentGraph != graph)
+        {
+            throw new ArgumentException("Length map must belong to the same graph", nameof(lengthMap));
+        }
+    }
+
+    /// <summary>
+    /// Gets the priority queue used by this instance.
+    /// </summary>
+    public IntegerHeap Heap => heap;
+
+    /// <summary>
+    /// Runs Dijkstra's algorithm from the source to the target node.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <returns>The shortest path result.</returns>
+    /// <exception cref="InvalidOperationException">If an arc length is negative.</exception>
+    public ShortestPathResultLong Run(Node source, Node target)
+    {
+        ThrowIfDisposed();
+
+        if (!source.IsValid)
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (!target.IsValid)
+            throw new ArgumentException("Invalid target node", nameof(target));
+
+        IntPtr resultPtr = lemon_dijkstra_long(graph.Handle, lengthMap.Handle, source.Id, target.Id, (int)heap);
+
+        if (resultPtr == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to compute shortest path (arc lengths must be non-negative)");
+        }
+
+        try
+        {
+            NativeShortestPathResultLong nativeResult = Marshal.PtrToStructure<NativeShortestPathResultLong>(resultPtr);
+
+            if (nativeResult.reached == 0)
+            {
+                return ShortestPathResultLong.Unreachable();
+            }
+
+            Path path = new Path(graph);
+
+            if (nativeResult.path != IntPtr.Zero)
+            {
+                NativePathResult nativePath = Marshal.PtrToStructure<NativePathResult>(nativeResult.path);
+
+                if (nativePath.count > 0 && nativePath.arc_ids != IntPtr.Zero)
+                {
+                    int[] arcIds = new int[nativePath.count];
+                    Marshal.Copy(nativePath.arc_ids, arcIds, 0, nativePath.count);
+
+                    Arc[] arcs = new Arc[nativePath.count];
+                    for (int i = 0; i < nativePath.count; i++)
+                    {
+                        arcs[i] = new Arc(arcIds[i]);
+                    }
+
+                    path = new Path(graph, arcs);
+                }
+            }
+
+            return new ShortestPathResultLong(nativeResult.distance, path, true, false);
+        }
+        finally
+        {
+            lemon_free_shortest_path_result_long(resultPtr);
+        }
+    }
+
+    /// <summary>
+    /// Finds the shortest path from source to target.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <returns>The shortest path, or null if no path exists.</returns>
+    public Path? FindPath(Node source, Node target)
+    {
+        var result = Run(source, target);
+        return result.Path;
+    }
+
+    /// <summary>
+    /// Finds the shortest distance from source to target.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <returns>The shortest distance, or long.MaxValue if no path exists.</returns>
+    public long FindDistance(Node source, Node target)
+    {
+        var result = Run(source, target);
+        return result.Distance;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+}
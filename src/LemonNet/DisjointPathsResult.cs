@@ -0,0 +1,31 @@
+using System;
+using System.Collections.Generic;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a set of disjoint paths between two nodes with minimum total length.
+/// </summary>
+public class DisjointPathsResult
+{
+    /// <summary>
+    /// Gets the total length of all paths.
+    /// </summary>
+    public double TotalLength { get; }
+
+    /// <summary>
+    /// Gets the paths. Fewer than requested if the graph has no more disjoint paths.
+    /// </summary>
+    public IReadOnlyList<Path> Paths { get; }
+
+    public DisjointPathsResult(double totalLength, Path[] paths)
+    {
+        TotalLength = totalLength;
+        Paths = paths ?? Array.Empty<Path>();
+    }
+
+    public override string ToString()
+    {
+        return $"Disjoint Paths: {Paths.Count}, Total length = {TotalLength}";
+    }
+}
@@ -0,0 +1,313 @@
+using System;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Single-source shortest path tree that is repaired incrementally after arc length changes
+/// (Ramalingam-Reps). Arc lengths must be non-negative.
+/// </summary>
+/// <remarks>
+/// An update applies a batch of new arc lengths. Tree arcs that got longer invalidate the
+/// subtree below them, which is re-attached from its in-arcs; arcs that got shorter offer their
+/// targets a better distance. One Dijkstra pass over the affected nodes then settles every
+/// change, so the cost depends on the part of the tree that changes rather than on the graph.
+/// Arc lengths and the adjacency are copied when the instance is created; later changes must
+/// go through <see cref="Update(ReadOnlySpan{Arc}, ReadOnlySpan{double}, Span{Node})"/>, and
+/// nodes or arcs added to the graph afterwards are not seen. The tree can be saved and loaded
+/// again without recomputing it.
+/// </remarks>
+public class DynamicShortestPathTree : IDisposable
+{
+    private const int FormatMagic = 0x31545344; // "DST1"
+
+    private readonly LemonDigraph graph;
+    private IntPtr treeHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe IntPtr lemon_dynamic_sssp_create(IntPtr graph, IntPtr length_map, int source,
+                                                                  double* dist, int* pred);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_dynamic_sssp_destroy(IntPtr tree);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_dynamic_sssp_update(IntPtr tree, int* arcs, double* lengths, int count,
+                                                               int* changed_nodes);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_dynamic_sssp_state(IntPtr tree, double* dist, int* pred, double* lengths);
+
+    #endregion
+
+    private DynamicShortestPathTree(LemonDigraph graph, Node source, int nodeCount, int arcCount, IntPtr treeHandle)
+    {
+        this.graph = graph;
+        this.treeHandle = treeHandle;
+        Source = source;
+        NodeCount = nodeCount;
+        ArcCount = arcCount;
+    }
+
+    /// <summary>
+    /// Computes the shortest path tree of a source with Dijkstra.
+    /// </summary>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="lengthMap">The arc map containing non-negative arc lengths.</param>
+    /// <param name="source">The source node.</param>
+    public unsafe DynamicShortestPathTree(LemonDigraph graph, ArcMapDouble lengthMap, Node source)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        if (lengthMap == null)
+            throw new ArgumentNullException(nameof(lengthMap));
+        if (!graph.IsValid(source))
+            throw new ArgumentException("Invalid source node", nameof(source));
+
+        Source = source;
+        NodeCount = graph.NodeCount;
+        ArcCount = graph.ArcCount;
+        treeHandle = lemon_dynamic_sssp_create(graph.Handle, lengthMap.Handle, source.Id, null, null);
+
+        if (treeHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to build shortest path tree (arc lengths must be non-negative)");
+        }
+    }
+
+    /// <summary>
+    /// Gets the source node of the tree.
+    /// </summary>
+    public Node Source { get; }
+
+    /// <summary>
+    /// Gets the number of nodes covered, i.e. the node count of the graph at creation.
+    /// </summary>
+    public int NodeCount { get; }
+
+    /// <summary>
+    /// Gets the number of arcs covered, i.e. the arc count of the graph at creation.
+    /// </summary>
+    public int ArcCount { get; }
+
+    /// <summary>
+    /// Applies new arc lengths and repairs the tree.
+    /// </summary>
+    /// <param name="arcs">The arcs whose length changes; an arc listed twice takes its last length.</param>
+    /// <param name="lengths">The new non-negative length of each arc.</param>
+    /// <returns>The nodes whose distance or incoming tree arc changed.</returns>
+    public Node[] Update(ReadOnlySpan<Arc> arcs, ReadOnlySpan<double> lengths)
+    {
+        var changed = new Node[NodeCount];
+        int count = Update(arcs, lengths, changed);
+        return changed.AsSpan(0, count).ToArray();
+    }
+
+    /// <summary>
+    /// Applies new arc lengths and repairs the tree, writing the changed nodes into a
+    /// caller-provided buffer.
+    /// </summary>
+    /// <param name="arcs">The arcs whose length changes; an arc listed twice takes its last length.</param>
+    /// <param name="lengths">The new non-negative length of each arc.</param>
+    /// <param name="changedNodes">
+    /// Receives the nodes whose distance or incoming tree arc changed; must hold NodeCount
+    /// entries, or be empty to only count them.
+    /// </param>
+    /// <returns>The number of changed nodes.</returns>
+    public unsafe int Update(ReadOnlySpan<Arc> arcs, ReadOnlySpan<double> lengths, Span<Node> changedNodes)
+    {
+        ThrowIfDisposed();
+
+        if (lengths.Length != arcs.Length)
+            throw new ArgumentException("Lengths must match the arcs one to one", nameof(lengths));
+        if (!changedNodes.IsEmpty && changedNodes.Length < NodeCount)
+            throw new ArgumentException("Buffer must be empty or hold NodeCount entries", nameof(changedNodes));
+        foreach (var arc in arcs)
+        {
+            if (!graph.IsValid(arc) || arc.Id >= ArcCount)
+                throw new ArgumentException("Invalid arc", nameof(arcs));
+        }
+
+        int result;
+        fixed (int* arcIds = MemoryMarshal.Cast<Arc, int>(arcs))
+        fixed (double* newLengths = lengths)
+        fixed (int* changed = MemoryMarshal.Cast<Node, int>(changedNodes))
+        {
+            result = lemon_dynamic_sssp_update(treeHandle, arcIds, newLengths, arcs.Length,
+                                               changedNodes.IsEmpty ? null : changed);
+        }
+
+        if (result < 0)
+        {
+            throw new ArgumentException("Arc lengths must be non-negative", nameof(lengths));
+        }
+
+        return result;
+    }
+
+    /// <summary>
+    /// Gets the current shortest path tree.
+    /// </summary>
+    /// <returns>A snapshot of the distances and tree arcs.</returns>
+    public unsafe ShortestPathTree GetTree()
+    {
+        ThrowIfDisposed();
+
+        var distances = new double[NodeCount];
+        var predArcIds = new int[NodeCount];
+        fixed (double* dist = distances)
+        fixed (int* pred = predArcIds)
+        {
+            lemon_dynamic_sssp_state(treeHandle, dist, pred, null);
+        }
+
+        int reachedCount = distances.Count(d => !double.IsPositiveInfinity(d));
+        return new ShortestPathTree(graph, Source, distances, predArcIds, reachedCount);
+    }
+
+    /// <summary>
+    /// Gets the current arc lengths, i.e. the lengths at creation with all updates applied.
+    /// </summary>
+    /// <param name="lengths">Receives the length of every arc by arc id; must hold ArcCount entries.</param>
+    public unsafe void GetLengths(Span<double> lengths)
+    {
+        ThrowIfDisposed();
+
+        if (lengths.Length < ArcCount)
+            throw new ArgumentException("Buffer must hold ArcCount entries", nameof(lengths));
+
+        fixed (double* values = lengths)
+        {
+            lemon_dynamic_sssp_state(treeHandle, null, null, values);
+        }
+    }
+
+    /// <summary>
+    /// Loads a tree written by <see cref="Save"/>.
+    /// </summary>
+    /// <param name="stream">The stream to read from.</param>
+    /// <param name="graph">The graph the tree was built for.</param>
+    /// <returns>The tree, with the arc lengths it was saved with.</returns>
+    public static unsafe DynamicShortestPathTree Load(Stream stream, LemonDigraph graph)
+    {
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+
+        using var reader = new BinaryReader(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        if (reader.ReadInt32() != FormatMagic)
+            throw new InvalidDataException("Not a dynamic shortest path tree");
+
+        int nodeCount = reader.ReadInt32();
+        int arcCount = reader.ReadInt32();
+        if (nodeCount != graph.NodeCount || arcCount != graph.ArcCount)
+            throw new InvalidDataException("The tree does not match the graph's node and arc counts");
+
+        int source = reader.ReadInt32();
+        if (source < 0 || source >= nodeCount)
+            throw new InvalidDataException("Invalid source node");
+
+        var distances = new double[nodeCount];
+        var predArcIds = new int[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            distances[i] = reader.ReadDouble();
+            predArcIds[i] = reader.ReadInt32();
+        }
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < arcCount; i++)
+        {
+            lengthMap[new Arc(i)] = reader.ReadDouble();
+        }
+
+        IntPtr handle;
+        fixed (double* dist = distances)
+        fixed (int* pred = predArcIds)
+        {
+            handle = lemon_dynamic_sssp_create(graph.Handle, lengthMap.Handle, source, dist, pred);
+        }
+
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidDataException("The stored tree is not a shortest path tree of the stored lengths");
+        }
+
+        return new DynamicShortestPathTree(graph, new Node(source), nodeCount, arcCount, handle);
+    }
+
+    /// <summary>
+    /// Writes the tree and the current arc lengths to a stream.
+    /// </summary>
+    /// <param name="stream">The stream to write to.</param>
+    public unsafe void Save(Stream stream)
+    {
+        ThrowIfDisposed();
+
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+
+        var distances = new double[NodeCount];
+        var predArcIds = new int[NodeCount];
+        var lengths = new double[ArcCount];
+        fixed (double* dist = distances)
+        fixed (int* pred = predArcIds)
+        fixed (double* values = lengths)
+        {
+            lemon_dynamic_sssp_state(treeHandle, dist, pred, values);
+        }
+
+        using var writer = new BinaryWriter(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        writer.Write(FormatMagic);
+        writer.Write(NodeCount);
+        writer.Write(ArcCount);
+        writer.Write(Source.Id);
+        for (int i = 0; i < NodeCount; i++)
+        {
+            writer.Write(distances[i]);
+            writer.Write(predArcIds[i]);
+        }
+        for (int i = 0; i < ArcCount; i++)
+        {
+            writer.Write(lengths[i]);
+        }
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (treeHandle != IntPtr.Zero)
+            {
+                lemon_dynamic_sssp_destroy(treeHandle);
+                treeHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~DynamicShortestPathTree()
+    {
+        Dispose(disposing: false);
+    }
+}
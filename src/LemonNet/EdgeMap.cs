@@ -0,0 +1,203 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a map that associates long values with edges in a LEMON graph.
+/// </summary>
+public class EdgeMap : IDisposable
+{
+    private IntPtr mapHandle;
+    private LemonGraph parentGraph;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_create_edge_map_long(IntPtr graph);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_destroy_edge_map(IntPtr map);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_set_edge_value_long(IntPtr map, int edge, long value);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern long lemon_get_edge_value_long(IntPtr map, int edge);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_edge_map_read_long(IntPtr map, int first_edge, long* values, int count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_edge_map_write_long(IntPtr map, int first_edge, long* values, int count);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new edge map for long values for the specified graph.
+    /// </summary>
+    /// <param name="graph">The graph this edge map is associated with.</param>
+    public EdgeMap(LemonGraph graph)
+    {
+        if (graph == null)
+        {
+            throw new ArgumentNullException(nameof(graph));
+        }
+
+        parentGraph = graph;
+        mapHandle = lemon_create_edge_map_long(graph.Handle);
+
+        if (mapHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to create edge map");
+        }
+    }
+
+    /// <summary>
+    /// Gets the handle to the underlying native edge map.
+    /// This is used internally by algorithm classes.
+    /// </summary>
+    internal IntPtr Handle
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return mapHandle;
+        }
+    }
+
+    /// <summary>
+    /// Gets the parent graph this edge map belongs to.
+    /// </summary>
+    public LemonGraph ParentGraph
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return parentGraph;
+        }
+    }
+
+    /// <summary>
+    /// Sets the value associated with an edge.
+    /// </summary>
+    /// <param name="edge">The edge to set the value for.</param>
+    /// <param name="value">The value to associate with the edge.</param>
+    public void SetValue(Edge edge, long value)
+    {
+        ThrowIfDisposed();
+
+        if (!parentGraph.IsValid(edge))
+        {
+            throw new ArgumentException("Invalid edge for this graph", nameof(edge));
+        }
+
+        lemon_set_edge_value_long(mapHandle, edge.Id, value);
+    }
+
+    /// <summary>
+    /// Gets the value associated with an edge.
+    /// </summary>
+    /// <param name="edge">The edge to get the value for.</param>
+    /// <returns>The value associated with the edge.</returns>
+    public long GetValue(Edge edge)
+    {
+        ThrowIfDisposed();
+
+        if (!parentGraph.IsValid(edge))
+        {
+            throw new ArgumentException("Invalid edge for this graph", nameof(edge));
+        }
+
+        return lemon_get_edge_value_long(mapHandle, edge.Id);
+    }
+
+    /// <summary>
+    /// Indexer for convenient access to edge values.
+    /// </summary>
+    /// <param name="edge">The edge to access.</param>
+    /// <returns>The value associated with the edge.</returns>
+    public long this[Edge edge]
+    {
+        get => GetValue(edge);
+        set => SetValue(edge, value);
+    }
+
+    /// <summary>
+    /// Copies the values of consecutive edges, in edge id order, into a span.
+    /// </summary>
+    /// <param name="values">Receives one value per edge.</param>
+    /// <param name="firstEdge">The first edge to copy; defaults to the first edge of the graph.</param>
+    public unsafe void CopyTo(Span<long> values, Edge firstEdge = default)
+    {
+        ThrowIfDisposed();
+        ValidateRange(firstEdge, values.Length);
+
+        fixed (long* ptr = values)
+        {
+            lemon_edge_map_read_long(mapHandle, firstEdge.Id, ptr, values.Length);
+        }
+    }
+
+    /// <summary>
+    /// Sets the values of consecutive edges, in edge id order, from a span.
+    /// </summary>
+    /// <param name="values">One value per edge.</param>
+    /// <param name="firstEdge">The first edge to set; defaults to the first edge of the graph.</param>
+    public unsafe void SetValues(ReadOnlySpan<long> values, Edge firstEdge = default)
+    {
+        ThrowIfDisposed();
+        ValidateRange(firstEdge, values.Length);
+
+        fixed (long* ptr = values)
+        {
+            lemon_edge_map_write_long(mapHandle, firstEdge.Id, ptr, values.Length);
+        }
+    }
+
+    private void ValidateRange(Edge firstEdge, int count)
+    {
+        if (firstEdge.Id < 0 || firstEdge.Id > parentGraph.EdgeCount)
+        {
+            throw new ArgumentException("Invalid edge for this graph", nameof(firstEdge));
+        }
+
+        if (count > parentGraph.EdgeCount - firstEdge.Id)
+        {
+            throw new ArgumentException("The span extends past the last edge of the graph");
+        }
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(nameof(EdgeMap));
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (mapHandle != IntPtr.Zero)
+            {
+                lemon_destroy_edge_map(mapHandle);
+                mapHandle = IntPtr.Zero;
+            }
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~EdgeMap()
+    {
+        Dispose(false);
+    }
+}
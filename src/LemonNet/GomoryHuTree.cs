@@ -0,0 +1,248 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Gomory-Hu cut tree: answers the minimum cut between any two nodes of an undirected
+/// network after only n - 1 max flow computations.
+/// </summary>
+/// <remarks>
+/// Arc directions are ignored: every arc is treated as an undirected edge with its capacity.
+/// A query walks the tree path between the two nodes, so it never runs a flow. The tree can be
+/// saved with the graph and loaded again without recomputing the flows.
+/// </remarks>
+public class GomoryHuTree : IDisposable
+{
+    private const int FormatMagic = 0x31544847; // "GHT1"
+
+    private readonly LemonDigraph graph;
+    private IntPtr treeHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_gomory_hu_build(IntPtr graph, IntPtr capacity_map, int thread_count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_gomory_hu_create(int node_count, int[] pred, long[] weight);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_destroy_gomory_hu(IntPtr tree);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_gomory_hu_tree(IntPtr tree, int[] pred, long[] weight);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern long lemon_gomory_hu_min_cut_value(IntPtr tree, int u, int v);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern long lemon_gomory_hu_min_cut(IntPtr tree, int u, int v, byte[] u_side);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_gomory_hu_min_cut_arcs(IntPtr tree, IntPtr graph, int u, int v,
+                                                           int[] arc_ids, int arc_capacity);
+
+    #endregion
+
+    private GomoryHuTree(LemonDigraph graph, IntPtr treeHandle)
+    {
+        this.graph = graph;
+        this.treeHandle = treeHandle;
+    }
+
+    /// <summary>
+    /// Builds the Gomory-Hu tree of a graph.
+    /// </summary>
+    /// <param name="graph">The graph; arcs are treated as undirected edges.</param>
+    /// <param name="capacityMap">The arc map containing non-negative capacities.</param>
+    /// <param name="threadCount">Number of threads computing the max flows. Zero uses all hardware threads.</param>
+    /// <returns>The cut tree.</returns>
+    public static GomoryHuTree Build(LemonDigraph graph, ArcMap capacityMap, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (capacityMap == null)
+            throw new ArgumentNullException(nameof(capacityMap));
+
+        IntPtr handle = lemon_gomory_hu_build(graph.Handle, capacityMap.Handle, threadCount);
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to build Gomory-Hu tree (capacities must be non-negative)");
+        }
+
+        return new GomoryHuTree(graph, handle);
+    }
+
+    /// <summary>
+    /// Loads a tree written by <see cref="Save"/>.
+    /// </summary>
+    /// <param name="stream">The stream to read from.</param>
+    /// <param name="graph">The graph the tree was built for.</param>
+    /// <returns>The cut tree.</returns>
+    public static GomoryHuTree Load(Stream stream, LemonDigraph graph)
+    {
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+
+        using var reader = new BinaryReader(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        if (reader.ReadInt32() != FormatMagic)
+            throw new InvalidDataException("Not a Gomory-Hu tree");
+
+        int nodeCount = reader.ReadInt32();
+        if (nodeCount != graph.NodeCount)
+            throw new InvalidDataException("The tree does not match the graph's node count");
+
+        var pred = new int[nodeCount];
+        var weight = new long[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            pred[i] = reader.ReadInt32();
+            weight[i] = reader.ReadInt64();
+        }
+
+        IntPtr handle = lemon_gomory_hu_create(nodeCount, pred, weight);
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidDataException("The stored predecessors do not form a tree");
+        }
+
+        return new GomoryHuTree(graph, handle);
+    }
+
+    /// <summary>
+    /// Writes the tree to a stream.
+    /// </summary>
+    /// <param name="stream">The stream to write to.</param>
+    public void Save(Stream stream)
+    {
+        ThrowIfDisposed();
+
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+
+        int nodeCount = lemon_gomory_hu_tree(treeHandle, null!, null!);
+        var pred = new int[nodeCount];
+        var weight = new long[nodeCount];
+        lemon_gomory_hu_tree(treeHandle, pred, weight);
+
+        using var writer = new BinaryWriter(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        writer.Write(FormatMagic);
+        writer.Write(nodeCount);
+        for (int i = 0; i < nodeCount; i++)
+        {
+            writer.Write(pred[i]);
+            writer.Write(weight[i]);
+        }
+    }
+
+    /// <summary>
+    /// Gets the minimum cut value between two nodes.
+    /// </summary>
+    /// <param name="u">The first node.</param>
+    /// <param name="v">The second node.</param>
+    /// <returns>The total capacity of a minimum u-v cut.</returns>
+    public long MinCutValue(Node u, Node v)
+    {
+        ThrowIfDisposed();
+        ValidatePair(u, v);
+
+        return lemon_gomory_hu_min_cut_value(treeHandle, u.Id, v.Id);
+    }
+
+    /// <summary>
+    /// Gets the side of a minimum cut between two nodes that contains <paramref name="u"/>.
+    /// </summary>
+    /// <param name="u">The first node.</param>
+    /// <param name="v">The second node.</param>
+    /// <returns>For each node id, whether the node is on u's side of the cut.</returns>
+    public bool[] MinCutNodes(Node u, Node v)
+    {
+        ThrowIfDisposed();
+        ValidatePair(u, v);
+
+        var side = new byte[graph.NodeCount];
+        lemon_gomory_hu_min_cut(treeHandle, u.Id, v.Id, side);
+
+        var result = new bool[side.Length];
+        for (int i = 0; i < side.Length; i++)
+        {
+            result[i] = side[i] != 0;
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// Gets the arcs of a minimum cut between two nodes, in either direction.
+    /// </summary>
+    /// <param name="u">The first node.</param>
+    /// <param name="v">The second node.</param>
+    /// <returns>The arcs with one end on each side of the cut.</returns>
+    public IReadOnlyList<Arc> MinCutEdges(Node u, Node v)
+    {
+        ThrowIfDisposed();
+        ValidatePair(u, v);
+
+        var arcIds = new int[graph.ArcCount];
+        int count = lemon_gomory_hu_min_cut_arcs(treeHandle, graph.Handle, u.Id, v.Id, arcIds, arcIds.Length);
+        if (count < 0)
+        {
+            throw new InvalidOperationException("Failed to compute cut arcs (the graph changed since the tree was built)");
+        }
+
+        var arcs = new Arc[count];
+        for (int i = 0; i < count; i++)
+        {
+            arcs[i] = new Arc(arcIds[i]);
+        }
+        return arcs;
+    }
+
+    private void ValidatePair(Node u, Node v)
+    {
+        if (!graph.IsValid(u))
+            throw new ArgumentException("Invalid node", nameof(u));
+        if (!graph.IsValid(v))
+            throw new ArgumentException("Invalid node", nameof(v));
+        if (u == v)
+            throw new ArgumentException("Nodes must differ", nameof(v));
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (treeHandle != IntPtr.Zero)
+            {
+                lemon_destroy_gomory_hu(treeHandle);
+                treeHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~GomoryHuTree()
+    {
+        Dispose(disposing: false);
+    }
+}
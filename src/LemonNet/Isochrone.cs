@@ -0,0 +1,51 @@
+using System;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents the result of a distance-bounded search: the nodes within the bound of the
+/// nearest source, in order of distance, with their distances and incoming tree arcs.
+/// </summary>
+public class Isochrone
+{
+    private readonly Node[] nodes;
+    private readonly double[] distances;
+    private readonly int[] predecessorArcIds;
+
+    /// <summary>
+    /// Creates a new isochrone from buffers whose first count entries are filled.
+    /// </summary>
+    internal Isochrone(double bound, Node[] nodes, double[] distances, int[] predecessorArcIds, int count)
+    {
+        Bound = bound;
+        Count = count;
+        this.nodes = nodes;
+        this.distances = distances;
+        this.predecessorArcIds = predecessorArcIds;
+    }
+
+    /// <summary>
+    /// Gets the distance bound of the search.
+    /// </summary>
+    public double Bound { get; }
+
+    /// <summary>
+    /// Gets the number of nodes within the bound, sources included.
+    /// </summary>
+    public int Count { get; }
+
+    /// <summary>
+    /// Gets the nodes within the bound in order of non-decreasing distance.
+    /// </summary>
+    public ReadOnlySpan<Node> Nodes => nodes.AsSpan(0, Count);
+
+    /// <summary>
+    /// Gets the distance of each node in <see cref="Nodes"/> from its nearest source.
+    /// </summary>
+    public ReadOnlySpan<double> Distances => distances.AsSpan(0, Count);
+
+    /// <summary>
+    /// Gets the incoming tree arc id of each node in <see cref="Nodes"/> (-1 for sources).
+    /// </summary>
+    public ReadOnlySpan<int> PredecessorArcIds => predecessorArcIds.AsSpan(0, Count);
+}
@@ -0,0 +1,261 @@
+using System;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Johnson's all-pairs shortest path algorithm.
+/// Runs Bellman-Ford once from a virtual source to obtain node potentials, then
+/// Dijkstra from every source on the potential-reduced (non-negative) lengths,
+/// spread over several threads. Supports negative arc lengths.
+/// </summary>
+/// <remarks>
+/// Distance rows are written directly into caller-provided memory or a memory-mapped
+/// file, so the n x n matrix never has to live on the managed heap. Row i holds the
+/// distances from the i-th source, indexed by node id (PositiveInfinity if unreachable).
+/// Potentials are computed on first use and again after nodes or arcs are added;
+/// create a new instance after changing the lengths.
+/// </remarks>
+public class Johnson : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private readonly ArcMapDouble lengthMap;
+    private double[]? potentials;
+    private int potentialNodeCount;
+    private int potentialArcCount;
+    private bool hasNegativeCycle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_johnson_potentials(IntPtr graph, IntPtr length_map, double[] potentials);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_johnson_rows(IntPtr graph, IntPtr length_map,
+                                                        double[] potentials, int potential_count,
+                                                        int* sources, int source_count, int thread_count,
+                                                        double* rows);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new instance of Johnson's algorithm.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing arc lengths (can be negative).</param>
+    public Johnson(LemonDigraph graph, ArcMapDouble lengthMap)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
+    }
+
+    /// <summary>
+    /// Gets or sets the number of worker threads. Zero (the default) uses all hardware threads.
+    /// </summary>
+    public int ThreadCount { get; set; }
+
+    /// <summary>
+    /// Gets whether the graph contains a negative cycle, in which case no distances can be computed.
+    /// </summary>
+    public bool HasNegativeCycle
+    {
+        get
+        {
+            EnsurePotentials();
+            return hasNegativeCycle;
+        }
+    }
+
+    /// <summary>
+    /// Gets the node potentials used for reweighting, indexed by node id.
+    /// Every arc satisfies length + potential[source] - potential[target] >= 0.
+    /// </summary>
+    /// <exception cref="InvalidOperationException">The graph contains a negative cycle.</exception>
+    public ReadOnlySpan<double> Potentials => GetPotentials();
+
+    /// <summary>
+    /// Computes the distances from every node into a row-major node count x node count matrix.
+    /// </summary>
+    /// <param name="matrix">Receives the distance matrix, row i holding the distances from node i.</param>
+    /// <exception cref="InvalidOperationException">The graph contains a negative cycle.</exception>
+    public void Run(Span<double> matrix)
+    {
+        ThrowIfDisposed();
+
+        int nodeCount = graph.NodeCount;
+        if ((long)matrix.Length < (long)nodeCount * nodeCount)
+            throw new ArgumentException("Matrix must hold node count x node count entries", nameof(matrix));
+
+        var sources = new Node[nodeCount];
+        for (int i = 0; i < nodeCount; i++)
+        {
+            sources[i] = new Node(i);
+        }
+
+        Run(sources, matrix);
+    }
+
+    /// <summary>
+    /// Computes the distance rows of the given sources. Use this to stream the matrix
+    /// in batches of rows through a smaller buffer.
+    /// </summary>
+    /// <param name="sources">The source nodes, one row each.</param>
+    /// <param name="rows">Receives sources.Length rows of node count distances each.</param>
+    /// <exception cref="InvalidOperationException">The graph contains a negative cycle.</exception>
+    public unsafe void Run(ReadOnlySpan<Node> sources, Span<double> rows)
+    {
+        ThrowIfDisposed();
+
+        if ((long)rows.Length < (long)sources.Length * graph.NodeCount)
+            throw new ArgumentException("Buffer must hold one row per source", nameof(rows));
+
+        fixed (double* rowPtr = rows)
+        {
+            RunRows(sources, rowPtr);
+        }
+    }
+
+    /// <summary>
+    /// Computes the distances from every node into a memory-mapped file. The file holds
+    /// the row-major node count x node count matrix as raw little-endian doubles, without a header,
+    /// and may be larger than the available memory.
+    /// </summary>
+    /// <param name="path">The output file, created or overwritten.</param>
+    /// <param name="rowsPerBatch">Number of rows computed per parallel batch.</param>
+    /// <exception cref="InvalidOperationException">The graph contains a negative cycle.</exception>
+    public unsafe void RunToFile(string path, int rowsPerBatch = 1024)
+    {
+        ThrowIfDisposed();
+
+        if (path == null)
+            throw new ArgumentNullException(nameof(path));
+        if (rowsPerBatch <= 0)
+            throw new ArgumentOutOfRangeException(nameof(rowsPerBatch));
+
+        // Fail before creating the file
+        GetPotentials();
+
+        int nodeCount = graph.NodeCount;
+        long capacity = (long)nodeCount * nodeCount * sizeof(double);
+
+        if (capacity == 0)
+        {
+            File.WriteAllBytes(path, Array.Empty<byte>());
+            return;
+        }
+
+        using var file = MemoryMappedFile.CreateFromFile(path, FileMode.Create, null, capacity);
+        using var accessor = file.CreateViewAccessor(0, capacity);
+
+        byte* basePtr = null;
+        accessor.SafeMemoryMappedViewHandle.AcquirePointer(ref basePtr);
+        try
+        {
+            double* matrix = (double*)(basePtr + accessor.PointerOffset);
+            var sources = new Node[Math.Min(rowsPerBatch, nodeCount)];
+
+            for (int first = 0; first < nodeCount; first += sources.Length)
+            {
+                int count = Math.Min(sources.Length, nodeCount - first);
+                for (int i = 0; i < count; i++)
+                {
+                    sources[i] = new Node(first + i);
+                }
+
+                RunRows(sources.AsSpan(0, count), matrix + (long)first * nodeCount);
+            }
+
+            accessor.Flush();
+        }
+        finally
+        {
+            accessor.SafeMemoryMappedViewHandle.ReleasePointer();
+        }
+    }
+
+    private unsafe void RunRows(ReadOnlySpan<Node> sources, double* rows)
+    {
+        var sourceIds = new int[sources.Length];
+        for (int i = 0; i < sources.Length; i++)
+        {
+            if (!graph.IsValid(sources[i]))
+                throw new ArgumentException("Invalid source node", nameof(sources));
+            sourceIds[i] = sources[i].Id;
+        }
+
+        double[] nodePotentials = GetPotentials();
+
+        int written;
+        fixed (int* sourcePtr = sourceIds)
+        {
+            written = lemon_johnson_rows(graph.Handle, lengthMap.Handle, nodePotentials, nodePotentials.Length,
+                                         sourcePtr, sourceIds.Length, ThreadCount, rows);
+        }
+
+        if (written < 0)
+        {
+            throw new InvalidOperationException("Failed to compute shortest paths");
+        }
+    }
+
+    private double[] GetPotentials()
+    {
+        EnsurePotentials();
+
+        if (hasNegativeCycle)
+        {
+            throw new InvalidOperationException("The graph contains a negative cycle");
+        }
+
+        return potentials!;
+    }
+
+    private void EnsurePotentials()
+    {
+        ThrowIfDisposed();
+
+        // Potentials from before nodes or arcs were added do not cover the graph
+        int nodeCount = graph.NodeCount;
+        int arcCount = graph.ArcCount;
+        if (potentials != null && potentialNodeCount == nodeCount && potentialArcCount == arcCount)
+            return;
+
+        var values = new double[nodeCount];
+        int status = lemon_johnson_potentials(graph.Handle, lengthMap.Handle, values);
+
+        if (status < 0)
+        {
+            throw new InvalidOperationException("Failed to compute node potentials");
+        }
+
+        hasNegativeCycle = status == 0;
+        potentials = values;
+        potentialNodeCount = nodeCount;
+        potentialArcCount = arcCount;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+}
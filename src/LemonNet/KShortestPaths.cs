@@ -0,0 +1,128 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// K shortest simple (loopless) paths between two nodes, using Yen's algorithm.
+/// All spur searches run natively on one masked view of the graph with a single
+/// reused Dijkstra instance, guided by the shortest path distances to the target.
+/// Arc lengths must be non-negative.
+/// </summary>
+public class KShortestPaths : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private readonly ArcMapDouble lengthMap;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeKShortestPathsResult
+    {
+        public int path_count;
+        public IntPtr costs;
+        public IntPtr offsets;
+        public IntPtr arc_ids;
+    }
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_k_shortest_paths(IntPtr graph, IntPtr length_map, int source, int target, int k);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_free_k_shortest_paths_result(IntPtr result);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new K shortest paths instance.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing non-negative arc lengths.</param>
+    public KShortestPaths(LemonDigraph graph, ArcMapDouble lengthMap)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.lengthMap = lengthMap ?? throw new ArgumentNullException(nameof(lengthMap));
+    }
+
+    /// <summary>
+    /// Finds up to k shortest simple paths from source to target.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <param name="k">The maximum number of paths to return.</param>
+    /// <returns>The paths in order of non-decreasing length; fewer than k if the graph has fewer simple paths.</returns>
+    public IReadOnlyList<ShortestPathResult> Run(Node source, Node target, int k)
+    {
+        ThrowIfDisposed();
+
+        if (!graph.IsValid(source))
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (!graph.IsValid(target))
+            throw new ArgumentException("Invalid target node", nameof(target));
+        if (k < 0)
+            throw new ArgumentOutOfRangeException(nameof(k), "k must be non-negative");
+
+        IntPtr resultPtr = lemon_k_shortest_paths(graph.Handle, lengthMap.Handle, source.Id, target.Id, k);
+
+        if (resultPtr == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to compute shortest paths (arc lengths must be non-negative)");
+        }
+
+        try
+        {
+            NativeKShortestPathsResult nativeResult = Marshal.PtrToStructure<NativeKShortestPathsResult>(resultPtr);
+            int pathCount = nativeResult.path_count;
+
+            var costs = new double[pathCount];
+            var offsets = new int[pathCount + 1];
+            Marshal.Copy(nativeResult.costs, costs, 0, pathCount);
+            Marshal.Copy(nativeResult.offsets, offsets, 0, pathCount + 1);
+
+            var arcIds = new int[offsets[pathCount]];
+            Marshal.Copy(nativeResult.arc_ids, arcIds, 0, arcIds.Length);
+
+            var results = new List<ShortestPathResult>(pathCount);
+            for (int i = 0; i < pathCount; i++)
+            {
+                var arcs = new Arc[offsets[i + 1] - offsets[i]];
+                for (int j = 0; j < arcs.Length; j++)
+                {
+                    arcs[j] = new Arc(arcIds[offsets[i] + j]);
+                }
+
+                results.Add(new ShortestPathResult(costs[i], new Path(graph, arcs), true));
+            }
+
+            return results;
+        }
+        finally
+        {
+            lemon_free_k_shortest_paths_result(resultPtr);
+        }
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+}
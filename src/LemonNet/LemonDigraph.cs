@@ -111,6 +111,16 @@ public class LemonDigraph : IDisposable
         }
     }
 
+    /// <summary>
+    /// Takes ownership of a graph built natively, e.g. a condensation.
+    /// </summary>
+    internal LemonDigraph(IntPtr handle)
+    {
+        graphHandle = handle;
+        nodeCount = lemon_node_count(handle);
+        arcCount = lemon_arc_count(handle);
+    }
+
     /// <summary>
     /// Gets the handle to the underlying native graph.
     /// This is used internally by algorithm classes.
@@ -0,0 +1,313 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents an edge (undirected) in a LEMON graph.
+/// This is a lightweight value type containing just an ID.
+/// </summary>
+public struct Edge : IEquatable<Edge>
+{
+    internal readonly int Id;
+
+    internal Edge(int id) => Id = id;
+
+    /// <summary>
+    /// Represents an invalid edge.
+    /// </summary>
+    public static readonly Edge Invalid = new Edge(-1);
+
+    /// <summary>
+    /// Checks if this edge is valid.
+    /// </summary>
+    public bool IsValid => Id >= 0;
+
+    public bool Equals(Edge other) => Id == other.Id;
+    public override bool Equals(object obj) => obj is Edge edge && Equals(edge);
+    public override int GetHashCode() => Id;
+    public override string ToString() => $"Edge({Id})";
+
+    public static bool operator ==(Edge left, Edge right) => left.Equals(right);
+    public static bool operator !=(Edge left, Edge right) => !left.Equals(right);
+}
+
+/// <summary>
+/// Represents an undirected graph using the LEMON library (SmartGraph).
+/// </summary>
+/// <remarks>
+/// Each edge is stored once, so an undirected topology takes half the memory of a
+/// <see cref="LemonDigraph"/> with two opposite arcs per edge, and the undirected
+/// algorithms run on it directly. Node and edge ids are consecutive from zero in
+/// the order they were added; edge maps expose their values in that order.
+/// </remarks>
+public class LemonGraph : IDisposable
+{
+    private IntPtr graphHandle;
+    private bool disposed = false;
+    private int nodeCount = 0;
+    private int edgeCount = 0;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_create_ugraph();
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_destroy_ugraph(IntPtr graph);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_ugraph_add_nodes(IntPtr graph, int count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_ugraph_add_edges(IntPtr graph, int* u, int* v, int count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_edge_u(IntPtr graph, int edge);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_edge_v(IntPtr graph, int edge);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new LEMON undirected graph.
+    /// </summary>
+    public LemonGraph()
+    {
+        graphHandle = lemon_create_ugraph();
+        if (graphHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to create LEMON graph");
+        }
+    }
+
+    /// <summary>
+    /// Gets the handle to the underlying native graph.
+    /// This is used internally by algorithm classes.
+    /// </summary>
+    internal IntPtr Handle
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return graphHandle;
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of nodes in the graph.
+    /// </summary>
+    public int NodeCount
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return nodeCount;
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of edges in the graph.
+    /// </summary>
+    public int EdgeCount
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return edgeCount;
+        }
+    }
+
+    /// <summary>
+    /// Adds a new node to the graph.
+    /// </summary>
+    /// <returns>The newly created node.</returns>
+    public Node AddNode()
+    {
+        ThrowIfDisposed();
+
+        int nodeId = lemon_ugraph_add_nodes(graphHandle, 1);
+        if (nodeId < 0)
+        {
+            throw new InvalidOperationException("Failed to add node to graph");
+        }
+
+        nodeCount++;
+        return new Node(nodeId);
+    }
+
+    /// <summary>
+    /// Adds one node for each element of <paramref name="nodes"/> and stores the new nodes there.
+    /// </summary>
+    /// <param name="nodes">Receives the newly created nodes.</param>
+    public void AddNodes(Span<Node> nodes)
+    {
+        ThrowIfDisposed();
+
+        int first = lemon_ugraph_add_nodes(graphHandle, nodes.Length);
+        if (first < 0)
+        {
+            throw new InvalidOperationException("Failed to add nodes to graph");
+        }
+
+        for (int i = 0; i < nodes.Length; i++)
+        {
+            nodes[i] = new Node(first + i);
+        }
+        nodeCount += nodes.Length;
+    }
+
+    /// <summary>
+    /// Adds a new edge to the graph.
+    /// </summary>
+    /// <param name="u">The first end node of the edge.</param>
+    /// <param name="v">The second end node of the edge.</param>
+    /// <returns>The newly created edge.</returns>
+    public Edge AddEdge(Node u, Node v)
+    {
+        if (!IsValid(u))
+        {
+            throw new ArgumentException("Invalid node", nameof(u));
+        }
+
+        if (!IsValid(v))
+        {
+            throw new ArgumentException("Invalid node", nameof(v));
+        }
+
+        Span<Edge> edge = stackalloc Edge[1];
+        AddEdges(stackalloc[] { u }, stackalloc[] { v }, edge);
+        return edge[0];
+    }
+
+    /// <summary>
+    /// Adds the edges (u[i], v[i]) in a single native call.
+    /// </summary>
+    /// <param name="u">The first end nodes.</param>
+    /// <param name="v">The second end nodes, the same number as <paramref name="u"/>.</param>
+    public void AddEdges(ReadOnlySpan<Node> u, ReadOnlySpan<Node> v)
+    {
+        AddEdges(u, v, Span<Edge>.Empty);
+    }
+
+    /// <summary>
+    /// Adds the edges (u[i], v[i]) in a single native call. Either all edges are added or none.
+    /// </summary>
+    /// <param name="u">The first end nodes.</param>
+    /// <param name="v">The second end nodes, the same number as <paramref name="u"/>.</param>
+    /// <param name="edges">Receives the newly created edges; may be empty, otherwise the same length as <paramref name="u"/>.</param>
+    public unsafe void AddEdges(ReadOnlySpan<Node> u, ReadOnlySpan<Node> v, Span<Edge> edges)
+    {
+        ThrowIfDisposed();
+
+        if (u.Length != v.Length)
+            throw new ArgumentException("Both end node spans must have the same length", nameof(v));
+        if (!edges.IsEmpty && edges.Length != u.Length)
+            throw new ArgumentException("The edge span must be empty or match the node spans", nameof(edges));
+
+        int first;
+        fixed (int* uIds = MemoryMarshal.Cast<Node, int>(u))
+        fixed (int* vIds = MemoryMarshal.Cast<Node, int>(v))
+        {
+            first = lemon_ugraph_add_edges(graphHandle, uIds, vIds, u.Length);
+        }
+
+        if (first < 0)
+        {
+            throw new ArgumentException("Invalid node in edge list", nameof(u));
+        }
+
+        for (int i = 0; i < edges.Length; i++)
+        {
+            edges[i] = new Edge(first + i);
+        }
+        edgeCount += u.Length;
+    }
+
+    /// <summary>
+    /// Gets the first end node of an edge.
+    /// </summary>
+    /// <param name="edge">The edge to query.</param>
+    /// <returns>The node the edge was added with as <c>u</c>.</returns>
+    public Node U(Edge edge)
+    {
+        ThrowIfDisposed();
+
+        if (!IsValid(edge))
+        {
+            throw new ArgumentException("Invalid edge", nameof(edge));
+        }
+
+        return new Node(lemon_edge_u(graphHandle, edge.Id));
+    }
+
+    /// <summary>
+    /// Gets the second end node of an edge.
+    /// </summary>
+    /// <param name="edge">The edge to query.</param>
+    /// <returns>The node the edge was added with as <c>v</c>.</returns>
+    public Node V(Edge edge)
+    {
+        ThrowIfDisposed();
+
+        if (!IsValid(edge))
+        {
+            throw new ArgumentException("Invalid edge", nameof(edge));
+        }
+
+        return new Node(lemon_edge_v(graphHandle, edge.Id));
+    }
+
+    /// <summary>
+    /// Checks if a node is valid for this graph.
+    /// </summary>
+    /// <param name="node">The node to validate.</param>
+    /// <returns>True if the node is valid, false otherwise.</returns>
+    public bool IsValid(Node node)
+    {
+        return node.Id >= 0 && node.Id < nodeCount;
+    }
+
+    /// <summary>
+    /// Checks if an edge is valid for this graph.
+    /// </summary>
+    /// <param name="edge">The edge to validate.</param>
+    /// <returns>True if the edge is valid, false otherwise.</returns>
+    public bool IsValid(Edge edge)
+    {
+        return edge.Id >= 0 && edge.Id < edgeCount;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(nameof(LemonGraph));
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (graphHandle != IntPtr.Zero)
+            {
+                lemon_destroy_ugraph(graphHandle);
+                graphHandle = IntPtr.Zero;
+            }
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~LemonGraph()
+    {
+        Dispose(false);
+    }
+}
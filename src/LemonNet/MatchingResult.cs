@@ -0,0 +1,50 @@
+using System;
+using System.Collections.Generic;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a matching: its total weight and the mate of every node.
+/// </summary>
+public class MatchingResult
+{
+    private readonly Node[] mates;
+
+    /// <summary>
+    /// Gets the total weight of the matched edges.
+    /// </summary>
+    public long Weight { get; }
+
+    /// <summary>
+    /// Gets the mate of each node by node id, or <see cref="Node.Invalid"/> if the node is unmatched.
+    /// </summary>
+    public IReadOnlyList<Node> Mates => mates;
+
+    public MatchingResult(long weight, Node[] mates)
+    {
+        Weight = weight;
+        this.mates = mates ?? Array.Empty<Node>();
+    }
+
+    /// <summary>
+    /// Gets the mate of a node.
+    /// </summary>
+    /// <param name="node">The node to query.</param>
+    /// <returns>The node matched with it, or <see cref="Node.Invalid"/> if it is unmatched.</returns>
+    public Node Mate(Node node)
+    {
+        if (node.Id < 0 || node.Id >= mates.Length)
+            throw new ArgumentException("Invalid node", nameof(node));
+        return mates[node.Id];
+    }
+
+    public override string ToString()
+    {
+        int matched = 0;
+        foreach (var mate in mates)
+        {
+            if (mate.IsValid) matched++;
+        }
+        return $"Matching: Weight = {Weight}, Matched edges: {matched / 2}";
+    }
+}
@@ -0,0 +1,130 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Maximum weighted matching of an undirected graph, using Edmonds' blossom algorithm.
+/// Edges with negative weight are never part of the matching.
+/// </summary>
+/// <remarks>
+/// The instance keeps the algorithm's native structures between runs and reads the current
+/// weights on every run, so it can be re-solved cheaply after the weights change.
+/// </remarks>
+public class MaxWeightedMatching : IDisposable
+{
+    private readonly LemonGraph graph;
+    private readonly EdgeMap weightMap;
+    private IntPtr matchingHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_create_matching(IntPtr graph, int perfect);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_destroy_matching(IntPtr matching);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_matching_run(IntPtr matching, IntPtr weight_map, int jumpstart,
+                                                        out long weight, int* mate);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new maximum weighted matching instance.
+    /// </summary>
+    /// <param name="graph">The undirected graph to operate on.</param>
+    /// <param name="weightMap">The edge map containing the edge weights.</param>
+    public MaxWeightedMatching(LemonGraph graph, EdgeMap weightMap)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        this.weightMap = weightMap ?? throw new ArgumentNullException(nameof(weightMap));
+        if (weightMap.ParentGraph != graph)
+            throw new ArgumentException("The weight map belongs to another graph", nameof(weightMap));
+
+        matchingHandle = lemon_create_matching(graph.Handle, 0);
+        if (matchingHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to create matching instance");
+        }
+    }
+
+    /// <summary>
+    /// Gets or sets whether the blossom algorithm starts from a fractional matching (the
+    /// jumpstart heuristic) instead of the empty matching. Defaults to true, which is
+    /// usually faster on large sparse graphs.
+    /// </summary>
+    public bool Jumpstart { get; set; } = true;
+
+    /// <summary>
+    /// Finds a maximum weighted matching.
+    /// </summary>
+    /// <returns>The matching weight and the mate of each node.</returns>
+    public MatchingResult Run()
+    {
+        var mates = new Node[graph.NodeCount];
+        long weight = Run(mates);
+        return new MatchingResult(weight, mates);
+    }
+
+    /// <summary>
+    /// Finds a maximum weighted matching and writes each node's mate into a caller buffer.
+    /// </summary>
+    /// <param name="mates">Receives the mate of each node by node id, or <see cref="Node.Invalid"/>; must hold NodeCount entries.</param>
+    /// <returns>The total weight of the matching.</returns>
+    public unsafe long Run(Span<Node> mates)
+    {
+        ThrowIfDisposed();
+
+        if (mates.Length < graph.NodeCount)
+            throw new ArgumentException("The mate buffer must hold one entry per node", nameof(mates));
+
+        int status;
+        long weight;
+        fixed (int* mate = MemoryMarshal.Cast<Node, int>(mates))
+        {
+            status = lemon_matching_run(matchingHandle, weightMap.Handle, Jumpstart ? 1 : 0, out weight, mate);
+        }
+
+        if (status < 0)
+        {
+            throw new InvalidOperationException("Failed to compute matching");
+        }
+        return weight;
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (matchingHandle != IntPtr.Zero)
+            {
+                lemon_destroy_matching(matchingHandle);
+                matchingHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~MaxWeightedMatching()
+    {
+        Dispose(disposing: false);
+    }
+}
@@ -0,0 +1,43 @@
+using System;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a minimum cut: its value and the nodes on its source side.
+/// </summary>
+public class MinCutResult
+{
+    /// <summary>
+    /// Gets the total capacity of the cut.
+    /// </summary>
+    public long Value { get; }
+
+    /// <summary>
+    /// Gets, for each node id, whether the node is on the source side of the cut.
+    /// </summary>
+    public bool[] SourceSide { get; }
+
+    public MinCutResult(long value, bool[] sourceSide)
+    {
+        Value = value;
+        SourceSide = sourceSide ?? Array.Empty<bool>();
+    }
+
+    /// <summary>
+    /// Checks whether a node is on the source side of the cut.
+    /// </summary>
+    public bool IsOnSourceSide(Node node)
+    {
+        return node.Id >= 0 && node.Id < SourceSide.Length && SourceSide[node.Id];
+    }
+
+    public override string ToString()
+    {
+        int count = 0;
+        foreach (bool inside in SourceSide)
+        {
+            if (inside) count++;
+        }
+        return $"Min Cut: {Value}, Source side nodes: {count}";
+    }
+}
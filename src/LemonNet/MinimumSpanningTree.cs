@@ -0,0 +1,187 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Algorithm used by <see cref="MinimumSpanningTree"/>.
+/// </summary>
+public enum SpanningTreeAlgorithm
+{
+    /// <summary>
+    /// Borůvka for large graphs when more than one thread is available, Kruskal otherwise.
+    /// </summary>
+    Auto = 0,
+
+    /// <summary>
+    /// Kruskal's algorithm on edges radix sorted by weight. Single-threaded.
+    /// </summary>
+    Kruskal = 1,
+
+    /// <summary>
+    /// Borůvka's algorithm, which scans the edges of each round in parallel.
+    /// </summary>
+    Boruvka = 2
+}
+
+/// <summary>
+/// Minimum spanning tree, or a minimum spanning forest with one tree per connected component.
+/// </summary>
+/// <remarks>
+/// Equal weights are ordered by edge id, so every algorithm selects the same edges.
+/// Results are written into a caller-provided span that must hold NodeCount - 1 entries;
+/// arcs of a <see cref="LemonDigraph"/> are treated as undirected edges.
+/// </remarks>
+public static class MinimumSpanningTree
+{
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_spanning_forest(IntPtr graph, IntPtr weight_map, int algorithm,
+                                                           int thread_count, int* arc_ids, void* total_weight);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_spanning_forest_ugraph(IntPtr graph, IntPtr weight_map, int algorithm,
+                                                                  int thread_count, int* edge_ids, void* total_weight);
+
+    #endregion
+
+    /// <summary>
+    /// Finds a minimum spanning forest of an undirected graph.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="weightMap">The edge map containing the weights.</param>
+    /// <param name="forest">Receives the selected edges; must hold NodeCount - 1 entries.</param>
+    /// <param name="totalWeight">The total weight of the selected edges.</param>
+    /// <param name="algorithm">The algorithm to use.</param>
+    /// <param name="threadCount">Number of threads for Borůvka. Zero uses all hardware threads.</param>
+    /// <returns>The number of edges written to <paramref name="forest"/>.</returns>
+    public static unsafe int Run(LemonGraph graph, EdgeMap weightMap, Span<Edge> forest, out long totalWeight,
+                                 SpanningTreeAlgorithm algorithm = SpanningTreeAlgorithm.Auto, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (weightMap == null)
+            throw new ArgumentNullException(nameof(weightMap));
+        ValidateBuffer(graph.NodeCount, forest.Length, nameof(forest));
+
+        long total = 0;
+        int count;
+        fixed (int* ids = MemoryMarshal.Cast<Edge, int>(forest))
+        {
+            count = lemon_spanning_forest_ugraph(graph.Handle, weightMap.Handle, (int)algorithm, threadCount,
+                                                 ids, &total);
+        }
+
+        totalWeight = total;
+        return CheckResult(count);
+    }
+
+    /// <summary>
+    /// Finds a minimum spanning forest of an undirected graph.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="weightMap">The edge map containing the weights; NaN is not allowed.</param>
+    /// <param name="forest">Receives the selected edges; must hold NodeCount - 1 entries.</param>
+    /// <param name="totalWeight">The total weight of the selected edges.</param>
+    /// <param name="algorithm">The algorithm to use.</param>
+    /// <param name="threadCount">Number of threads for Borůvka. Zero uses all hardware threads.</param>
+    /// <returns>The number of edges written to <paramref name="forest"/>.</returns>
+    public static unsafe int Run(LemonGraph graph, EdgeMapDouble weightMap, Span<Edge> forest, out double totalWeight,
+                                 SpanningTreeAlgorithm algorithm = SpanningTreeAlgorithm.Auto, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (weightMap == null)
+            throw new ArgumentNullException(nameof(weightMap));
+        ValidateBuffer(graph.NodeCount, forest.Length, nameof(forest));
+
+        double total = 0;
+        int count;
+        fixed (int* ids = MemoryMarshal.Cast<Edge, int>(forest))
+        {
+            count = lemon_spanning_forest_ugraph(graph.Handle, weightMap.Handle, (int)algorithm, threadCount,
+                                                 ids, &total);
+        }
+
+        totalWeight = total;
+        return CheckResult(count);
+    }
+
+    /// <summary>
+    /// Finds a minimum spanning forest of a digraph whose arcs are taken as undirected edges.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="weightMap">The arc map containing the weights.</param>
+    /// <param name="forest">Receives the selected arcs; must hold NodeCount - 1 entries.</param>
+    /// <param name="totalWeight">The total weight of the selected arcs.</param>
+    /// <param name="algorithm">The algorithm to use.</param>
+    /// <param name="threadCount">Number of threads for Borůvka. Zero uses all hardware threads.</param>
+    /// <returns>The number of arcs written to <paramref name="forest"/>.</returns>
+    public static unsafe int Run(LemonDigraph graph, ArcMap weightMap, Span<Arc> forest, out long totalWeight,
+                                 SpanningTreeAlgorithm algorithm = SpanningTreeAlgorithm.Auto, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (weightMap == null)
+            throw new ArgumentNullException(nameof(weightMap));
+        ValidateBuffer(graph.NodeCount, forest.Length, nameof(forest));
+
+        long total = 0;
+        int count;
+        fixed (int* ids = MemoryMarshal.Cast<Arc, int>(forest))
+        {
+            count = lemon_spanning_forest(graph.Handle, weightMap.Handle, (int)algorithm, threadCount,
+                                          ids, &total);
+        }
+
+        totalWeight = total;
+        return CheckResult(count);
+    }
+
+    /// <summary>
+    /// Finds a minimum spanning forest of a digraph whose arcs are taken as undirected edges.
+    /// </summary>
+    /// <param name="graph">The graph.</param>
+    /// <param name="weightMap">The arc map containing the weights; NaN is not allowed.</param>
+    /// <param name="forest">Receives the selected arcs; must hold NodeCount - 1 entries.</param>
+    /// <param name="totalWeight">The total weight of the selected arcs.</param>
+    /// <param name="algorithm">The algorithm to use.</param>
+    /// <param name="threadCount">Number of threads for Borůvka. Zero uses all hardware threads.</param>
+    /// <returns>The number of arcs written to <paramref name="forest"/>.</returns>
+    public static unsafe int Run(LemonDigraph graph, ArcMapDouble weightMap, Span<Arc> forest, out double totalWeight,
+                                 SpanningTreeAlgorithm algorithm = SpanningTreeAlgorithm.Auto, int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (weightMap == null)
+            throw new ArgumentNullException(nameof(weightMap));
+        ValidateBuffer(graph.NodeCount, forest.Length, nameof(forest));
+
+        double total = 0;
+        int count;
+        fixed (int* ids = MemoryMarshal.Cast<Arc, int>(forest))
+        {
+            count = lemon_spanning_forest(graph.Handle, weightMap.Handle, (int)algorithm, threadCount,
+                                          ids, &total);
+        }
+
+        totalWeight = total;
+        return CheckResult(count);
+    }
+
+    private static void ValidateBuffer(int nodeCount, int length, string paramName)
+    {
+        if (length < nodeCount - 1)
+            throw new ArgumentException("Buffer must hold NodeCount - 1 entries", paramName);
+    }
+
+    private static int CheckResult(int count)
+    {
+        if (count < 0)
+        {
+            throw new InvalidOperationException("Failed to compute spanning forest (invalid weight map or NaN weights)");
+        }
+        return count;
+    }
+}
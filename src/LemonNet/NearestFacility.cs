@@ -0,0 +1,211 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Nearest-facility (graph Voronoi) labeling: for every node, the closest of a set of facilities
+/// and the shortest distance to it. Arc lengths must be non-negative.
+/// </summary>
+/// <remarks>
+/// The labels come from one Dijkstra search seeded with all facilities at once, which carries
+/// the facility of origin along the tree. Ties go to the facility with the smaller node id, so
+/// the labels are unique. Adding or removing a facility afterwards repairs only the cells that
+/// change. Arc lengths and the adjacency are copied when the instance is created; create a new
+/// instance after changing the graph or the lengths.
+/// </remarks>
+public class NearestFacility : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private IntPtr labelsHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe IntPtr lemon_nearest_facility_create(IntPtr graph, IntPtr length_map,
+                                                                     int* facilities, int facility_count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_nearest_facility_destroy(IntPtr labels);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_nearest_facility_add(IntPtr labels, int node);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_nearest_facility_remove(IntPtr labels, int node);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_nearest_facility_count(IntPtr labels);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_nearest_facility_labels(IntPtr labels, int* nearest, double* dist, int* pred);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_nearest_facility_query(IntPtr labels, int node, out double dist);
+
+    #endregion
+
+    /// <summary>
+    /// Labels every node with its nearest facility.
+    /// </summary>
+    /// <param name="graph">The digraph; distances run along arc directions from the facilities.</param>
+    /// <param name="lengthMap">The arc map containing non-negative arc lengths.</param>
+    /// <param name="facilities">The facility nodes; duplicates are ignored.</param>
+    public unsafe NearestFacility(LemonDigraph graph, ArcMapDouble lengthMap, ReadOnlySpan<Node> facilities)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        if (lengthMap == null)
+            throw new ArgumentNullException(nameof(lengthMap));
+        foreach (var facility in facilities)
+        {
+            if (!graph.IsValid(facility))
+                throw new ArgumentException("Invalid facility node", nameof(facilities));
+        }
+
+        NodeCount = graph.NodeCount;
+        fixed (int* ids = MemoryMarshal.Cast<Node, int>(facilities))
+        {
+            labelsHandle = lemon_nearest_facility_create(graph.Handle, lengthMap.Handle, ids, facilities.Length);
+        }
+
+        if (labelsHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to label nearest facilities (arc lengths must be non-negative)");
+        }
+    }
+
+    /// <summary>
+    /// Gets the number of nodes labeled, i.e. the node count of the graph at creation.
+    /// </summary>
+    public int NodeCount { get; }
+
+    /// <summary>
+    /// Gets the current number of facilities.
+    /// </summary>
+    public int FacilityCount
+    {
+        get
+        {
+            ThrowIfDisposed();
+            return lemon_nearest_facility_count(labelsHandle);
+        }
+    }
+
+    /// <summary>
+    /// Makes a node a facility and relabels the nodes that are now closest to it.
+    /// </summary>
+    /// <param name="node">The new facility.</param>
+    /// <returns>The number of nodes whose nearest facility changed; zero if the node already was a facility.</returns>
+    public int AddFacility(Node node)
+    {
+        ThrowIfDisposed();
+        ValidateNode(node);
+
+        return lemon_nearest_facility_add(labelsHandle, node.Id);
+    }
+
+    /// <summary>
+    /// Removes a facility and relabels the nodes that were closest to it.
+    /// </summary>
+    /// <param name="node">The facility to remove.</param>
+    /// <returns>The number of nodes whose nearest facility changed; zero if the node was not a facility.</returns>
+    public int RemoveFacility(Node node)
+    {
+        ThrowIfDisposed();
+        ValidateNode(node);
+
+        return lemon_nearest_facility_remove(labelsHandle, node.Id);
+    }
+
+    /// <summary>
+    /// Gets the nearest facility of a node and the distance to it.
+    /// </summary>
+    /// <param name="node">The node to query.</param>
+    /// <param name="distance">The distance from the facility, or double.PositiveInfinity if no facility reaches the node.</param>
+    /// <returns>The nearest facility, or Node.Invalid if no facility reaches the node.</returns>
+    public Node Nearest(Node node, out double distance)
+    {
+        ThrowIfDisposed();
+        ValidateNode(node);
+
+        return new Node(lemon_nearest_facility_query(labelsHandle, node.Id, out distance));
+    }
+
+    /// <summary>
+    /// Copies the labels of all nodes into caller-provided buffers.
+    /// </summary>
+    /// <param name="nearest">Receives the nearest facility of every node by node id (Node.Invalid if unreachable).</param>
+    /// <param name="distances">Receives the distance to it (double.PositiveInfinity if unreachable).</param>
+    public void GetLabels(Span<Node> nearest, Span<double> distances)
+    {
+        GetLabels(nearest, distances, Span<int>.Empty);
+    }
+
+    /// <summary>
+    /// Copies the labels and the shortest path forest of all nodes into caller-provided buffers.
+    /// </summary>
+    /// <param name="nearest">Receives the nearest facility of every node by node id (Node.Invalid if unreachable).</param>
+    /// <param name="distances">Receives the distance to it (double.PositiveInfinity if unreachable).</param>
+    /// <param name="predecessorArcIds">
+    /// Receives the incoming tree arc id of every node on its path from the facility (-1 for
+    /// facilities and unreachable nodes); may be empty to skip.
+    /// </param>
+    public unsafe void GetLabels(Span<Node> nearest, Span<double> distances, Span<int> predecessorArcIds)
+    {
+        ThrowIfDisposed();
+
+        if (nearest.Length < NodeCount)
+            throw new ArgumentException("Buffer must hold NodeCount entries", nameof(nearest));
+        if (distances.Length < NodeCount)
+            throw new ArgumentException("Buffer must hold NodeCount entries", nameof(distances));
+        if (!predecessorArcIds.IsEmpty && predecessorArcIds.Length < NodeCount)
+            throw new ArgumentException("Buffer must be empty or hold NodeCount entries", nameof(predecessorArcIds));
+
+        fixed (int* facilityIds = MemoryMarshal.Cast<Node, int>(nearest))
+        fixed (double* dist = distances)
+        fixed (int* pred = predecessorArcIds)
+        {
+            lemon_nearest_facility_labels(labelsHandle, facilityIds, dist, predecessorArcIds.IsEmpty ? null : pred);
+        }
+    }
+
+    private void ValidateNode(Node node)
+    {
+        if (!graph.IsValid(node) || node.Id >= NodeCount)
+            throw new ArgumentException("Invalid node", nameof(node));
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (labelsHandle != IntPtr.Zero)
+            {
+                lemon_nearest_facility_destroy(labelsHandle);
+                labelsHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~NearestFacility()
+    {
+        Dispose(disposing: false);
+    }
+}
@@ -17,9 +17,10 @@ public class Preflow : IDisposable
     #region P/Invoke declarations
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
-    private static extern long lemon_preflow(IntPtr graph, IntPtr capacity_map,
-                                              int source, int target,
-                                              out IntPtr flow_results, out int flow_count);
+    private static extern unsafe long lemon_preflow_masked(IntPtr graph, IntPtr capacity_map,
+                                                           int source, int target,
+                                                           ulong* arc_mask, ulong* node_mask,
+                                                           out IntPtr flow_results, out int flow_count);
 
     [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
     private static extern void lemon_free_results(IntPtr results);
@@ -88,7 +89,17 @@ public class Preflow : IDisposable
     /// <param name="source">The source node.</param>
     /// <param name="target">The target node.</param>
     /// <returns>The maximum flow result.</returns>
-    public MaxFlowResult Run(Node source, Node target)
+    public MaxFlowResult Run(Node source, Node target) => Run(source, target, null);
+
+    /// <summary>
+    /// Runs the Preflow algorithm on the graph without the arcs and nodes disabled in a mask,
+    /// e.g. to evaluate a failure scenario without rebuilding the graph.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <param name="mask">The enabled arcs and nodes, or null for the whole graph.</param>
+    /// <returns>The maximum flow result; the flow is zero if the source or target is disabled.</returns>
+    public unsafe MaxFlowResult Run(Node source, Node target, GraphMask? mask)
     {
         ThrowIfDisposed();
 
@@ -107,17 +118,27 @@ public class Preflow : IDisposable
             throw new ArgumentException("Source and target must be different nodes");
         }
 
+        mask?.Validate(graph, nameof(mask));
+
         IntPtr flowResultsPtr = IntPtr.Zero;
         
         try
         {
-            long maxFlowValue = lemon_preflow(
-                graph.Handle,
-                capacityMap.Handle,
-                source.Id,
-                target.Id,
-                out flowResultsPtr,
-                out int flowCount);
+            long maxFlowValue;
+            int flowCount;
+            fixed (ulong* arcMask = mask?.ArcWords)
+            fixed (ulong* nodeMask = mask?.NodeWords)
+            {
+                maxFlowValue = lemon_preflow_masked(
+                    graph.Handle,
+                    capacityMap.Handle,
+                    source.Id,
+                    target.Id,
+                    arcMask,
+                    nodeMask,
+                    out flowResultsPtr,
+                    out flowCount);
+            }
 
             // Validate the flow value
             MarshalHelper.ValidateFlowValue(maxFlowValue);
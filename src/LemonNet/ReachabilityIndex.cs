@@ -0,0 +1,301 @@
+using System;
+using System.IO;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Precomputed index that answers "can u reach v" queries without a search per query.
+/// </summary>
+/// <remarks>
+/// The index works on the condensation of the graph's strongly connected components (nodes in
+/// one component reach each other), numbered in topological order. Every component keeps the
+/// range of its descendants and several GRAIL interval labels from randomized DFS traversals,
+/// which rule out most unreachable pairs in constant time. Components whose descendant range is
+/// small enough for the byte budget also keep their descendants as a bitset over that range,
+/// which settles the remaining queries exactly; queries that reach components without one run
+/// a DFS over the condensation, pruned by the same tests. The labels are built in parallel.
+/// The index is a snapshot of the graph at build time: it does not see later changes, and
+/// can be saved and loaded with the graph it was built from.
+/// </remarks>
+public class ReachabilityIndex : IDisposable
+{
+    private const int FormatMagic = 0x31495852; // "RXI1"
+
+    private readonly LemonDigraph graph;
+    private IntPtr indexHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_reachability_index_build(IntPtr graph, int label_count,
+                                                                long max_bitset_bytes, int thread_count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe IntPtr lemon_reachability_index_load(byte* data, long size);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe long lemon_reachability_index_save(IntPtr index, byte* buffer, long capacity);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_reachability_index_destroy(IntPtr index);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_reachability_index_info(IntPtr index, out int node_count, out int arc_count,
+                                                            out int component_count);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe long lemon_reachability_index_query(IntPtr index, int* sources, int* targets,
+                                                                     int count, int thread_count, byte* result);
+
+    #endregion
+
+    private ReachabilityIndex(LemonDigraph graph, IntPtr indexHandle)
+    {
+        this.graph = graph;
+        this.indexHandle = indexHandle;
+        BitsetComponentCount = lemon_reachability_index_info(indexHandle, out int nodeCount, out int arcCount,
+                                                             out int componentCount);
+        NodeCount = nodeCount;
+        ArcCount = arcCount;
+        ComponentCount = componentCount;
+    }
+
+    /// <summary>
+    /// Builds the reachability index of a graph.
+    /// </summary>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="labelCount">
+    /// Number of GRAIL interval labels per component (1 to 64). More labels rule out more
+    /// unreachable pairs up front but take more memory.
+    /// </param>
+    /// <param name="maxBitsetBytes">
+    /// Memory budget for the descendant bitsets. Zero builds none; a budget that holds the
+    /// whole transitive closure makes every query a constant-time lookup.
+    /// </param>
+    /// <param name="threadCount">Number of threads building the index. Zero uses all hardware threads.</param>
+    /// <returns>The index.</returns>
+    public static ReachabilityIndex Build(LemonDigraph graph, int labelCount = 3, long maxBitsetBytes = 256L << 20,
+                                          int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (labelCount < 1 || labelCount > 64)
+            throw new ArgumentOutOfRangeException(nameof(labelCount), "Label count must be between 1 and 64");
+        if (maxBitsetBytes < 0)
+            throw new ArgumentOutOfRangeException(nameof(maxBitsetBytes), "Bitset budget must be non-negative");
+
+        IntPtr handle = lemon_reachability_index_build(graph.Handle, labelCount, maxBitsetBytes, threadCount);
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to build reachability index");
+        }
+
+        return new ReachabilityIndex(graph, handle);
+    }
+
+    /// <summary>
+    /// Loads an index written by <see cref="Save"/>.
+    /// </summary>
+    /// <param name="stream">The stream to read from.</param>
+    /// <param name="graph">The graph the index was built for.</param>
+    /// <returns>The index.</returns>
+    public static unsafe ReachabilityIndex Load(Stream stream, LemonDigraph graph)
+    {
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+
+        using var reader = new BinaryReader(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        if (reader.ReadInt32() != FormatMagic)
+            throw new InvalidDataException("Not a reachability index");
+
+        int size = reader.ReadInt32();
+        var data = reader.ReadBytes(size);
+        if (data.Length != size)
+            throw new EndOfStreamException();
+
+        IntPtr handle;
+        fixed (byte* bytes = data)
+        {
+            handle = lemon_reachability_index_load(bytes, size);
+        }
+
+        if (handle == IntPtr.Zero)
+        {
+            throw new InvalidDataException("The stored reachability index is malformed");
+        }
+
+        var index = new ReachabilityIndex(graph, handle);
+        if (index.NodeCount != graph.NodeCount || index.ArcCount != graph.ArcCount)
+        {
+            index.Dispose();
+            throw new InvalidDataException("The index does not match the graph's node and arc counts");
+        }
+
+        return index;
+    }
+
+    /// <summary>
+    /// Writes the index to a stream.
+    /// </summary>
+    /// <param name="stream">The stream to write to.</param>
+    public unsafe void Save(Stream stream)
+    {
+        ThrowIfDisposed();
+
+        if (stream == null)
+            throw new ArgumentNullException(nameof(stream));
+
+        long size = lemon_reachability_index_save(indexHandle, null, 0);
+        if (size > int.MaxValue)
+            throw new InvalidOperationException("The index is too large to save");
+
+        var data = new byte[size];
+        fixed (byte* bytes = data)
+        {
+            lemon_reachability_index_save(indexHandle, bytes, size);
+        }
+
+        using var writer = new BinaryWriter(stream, System.Text.Encoding.UTF8, leaveOpen: true);
+        writer.Write(FormatMagic);
+        writer.Write(data.Length);
+        writer.Write(data);
+    }
+
+    /// <summary>
+    /// Gets the number of nodes indexed, i.e. the node count of the graph at build time.
+    /// </summary>
+    public int NodeCount { get; }
+
+    /// <summary>
+    /// Gets the number of arcs of the graph at build time.
+    /// </summary>
+    public int ArcCount { get; }
+
+    /// <summary>
+    /// Gets the number of strongly connected components.
+    /// </summary>
+    public int ComponentCount { get; }
+
+    /// <summary>
+    /// Gets the number of components with a descendant bitset; components without descendants
+    /// are not counted, as they need none.
+    /// </summary>
+    public int BitsetComponentCount { get; }
+
+    /// <summary>
+    /// Checks whether a directed path leads from one node to another.
+    /// </summary>
+    /// <param name="from">The start node.</param>
+    /// <param name="to">The end node.</param>
+    /// <returns>True if <paramref name="to"/> is reachable from <paramref name="from"/>; every node reaches itself.</returns>
+    public unsafe bool CanReach(Node from, Node to)
+    {
+        ThrowIfDisposed();
+        ValidateNode(from, nameof(from));
+        ValidateNode(to, nameof(to));
+
+        int source = from.Id;
+        int target = to.Id;
+        byte result;
+        lemon_reachability_index_query(indexHandle, &source, &target, 1, 1, &result);
+        return result != 0;
+    }
+
+    /// <summary>
+    /// Answers a batch of reachability queries.
+    /// </summary>
+    /// <param name="pairs">The (from, to) node pairs.</param>
+    /// <param name="results">Receives whether each pair is reachable; must hold one entry per pair.</param>
+    /// <param name="threadCount">Number of threads answering large batches. Zero uses all hardware threads.</param>
+    /// <returns>The number of reachable pairs.</returns>
+    public int CanReach(ReadOnlySpan<(Node From, Node To)> pairs, Span<bool> results, int threadCount = 0)
+    {
+        var sources = new Node[pairs.Length];
+        var targets = new Node[pairs.Length];
+        for (int i = 0; i < pairs.Length; i++)
+        {
+            sources[i] = pairs[i].From;
+            targets[i] = pairs[i].To;
+        }
+
+        return CanReach(sources, targets, results, threadCount);
+    }
+
+    /// <summary>
+    /// Answers a batch of reachability queries given as parallel spans.
+    /// </summary>
+    /// <param name="sources">The start node of each query.</param>
+    /// <param name="targets">The end node of each query.</param>
+    /// <param name="results">Receives whether each target is reachable from its source; must hold one entry per query.</param>
+    /// <param name="threadCount">Number of threads answering large batches. Zero uses all hardware threads.</param>
+    /// <returns>The number of reachable pairs.</returns>
+    public unsafe int CanReach(ReadOnlySpan<Node> sources, ReadOnlySpan<Node> targets, Span<bool> results,
+                               int threadCount = 0)
+    {
+        ThrowIfDisposed();
+
+        if (targets.Length != sources.Length)
+            throw new ArgumentException("Targets must match the sources one to one", nameof(targets));
+        if (results.Length < sources.Length)
+            throw new ArgumentException("Buffer must hold one entry per query", nameof(results));
+        foreach (var node in sources)
+        {
+            ValidateNode(node, nameof(sources));
+        }
+        foreach (var node in targets)
+        {
+            ValidateNode(node, nameof(targets));
+        }
+
+        fixed (int* sourceIds = MemoryMarshal.Cast<Node, int>(sources))
+        fixed (int* targetIds = MemoryMarshal.Cast<Node, int>(targets))
+        fixed (bool* reachable = results)
+        {
+            return (int)lemon_reachability_index_query(indexHandle, sourceIds, targetIds, sources.Length,
+                                                       threadCount, (byte*)reachable);
+        }
+    }
+
+    private void ValidateNode(Node node, string paramName)
+    {
+        if (!graph.IsValid(node) || node.Id >= NodeCount)
+            throw new ArgumentException("Invalid node", paramName);
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (indexHandle != IntPtr.Zero)
+            {
+                lemon_reachability_index_destroy(indexHandle);
+                indexHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~ReachabilityIndex()
+    {
+        Dispose(disposing: false);
+    }
+}
@@ -0,0 +1,106 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Solver run by <see cref="ScenarioBatch"/> for each scenario.
+/// </summary>
+public enum ScenarioAlgorithm
+{
+    /// <summary>
+    /// Maximum flow with <see cref="LemonNet.Preflow"/>. The values are arc capacities, the
+    /// objective is the flow value and the arc results are the arc flows.
+    /// </summary>
+    Preflow = 0,
+
+    /// <summary>
+    /// Maximum flow with <see cref="LemonNet.EdmondsKarp"/>, with the same values and results as
+    /// <see cref="Preflow"/>.
+    /// </summary>
+    EdmondsKarp = 1,
+
+    /// <summary>
+    /// Shortest path with Dijkstra's algorithm. The values are arc lengths, the objective is the
+    /// distance (long.MaxValue if the target is unreachable) and the arc results are 1 for the
+    /// arcs of the shortest path and 0 elsewhere.
+    /// </summary>
+    Dijkstra = 2
+}
+
+/// <summary>
+/// Solves one graph under many capacity or length vectors, e.g. for sensitivity analysis.
+/// </summary>
+/// <remarks>
+/// The scenarios are passed as one column-major block: the values of scenario k for all arcs
+/// are stored contiguously, the value of arc a at index <c>k * ArcCount + a</c>. No arc map is
+/// built per scenario. The solves run in parallel, one solver instance per thread over the
+/// shared graph, and each scenario is solved exactly as the corresponding algorithm class
+/// solves it.
+/// </remarks>
+public static class ScenarioBatch
+{
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_scenario_batch_run(IntPtr graph, int algorithm, int source, int target,
+                                                              long* values, int scenario_count, int thread_count,
+                                                              long* objectives, long* arc_results);
+
+    #endregion
+
+    /// <summary>
+    /// Solves every scenario of a value block.
+    /// </summary>
+    /// <param name="graph">The digraph.</param>
+    /// <param name="algorithm">The solver to run.</param>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node.</param>
+    /// <param name="values">
+    /// Non-negative arc capacities or lengths, one column of <c>graph.ArcCount</c> values per scenario.
+    /// </param>
+    /// <param name="objectives">Receives the objective of each scenario; its length is the number of scenarios.</param>
+    /// <param name="arcResults">
+    /// Receives the per-arc results of each scenario, laid out like <paramref name="values"/>, or empty
+    /// to skip them. Max flow only needs its first phase when they are skipped.
+    /// </param>
+    /// <param name="threadCount">Number of threads. Zero uses all hardware threads.</param>
+    public static unsafe void Run(LemonDigraph graph, ScenarioAlgorithm algorithm, Node source, Node target,
+                                  ReadOnlySpan<long> values, Span<long> objectives, Span<long> arcResults = default,
+                                  int threadCount = 0)
+    {
+        if (graph == null)
+            throw new ArgumentNullException(nameof(graph));
+        if (algorithm < ScenarioAlgorithm.Preflow || algorithm > ScenarioAlgorithm.Dijkstra)
+            throw new ArgumentOutOfRangeException(nameof(algorithm));
+        if (!graph.IsValid(source))
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (!graph.IsValid(target))
+            throw new ArgumentException("Invalid target node", nameof(target));
+        if (source == target && algorithm != ScenarioAlgorithm.Dijkstra)
+            throw new ArgumentException("Source and target must be different nodes");
+
+        long valueCount = (long)objectives.Length * graph.ArcCount;
+        if (values.Length != valueCount)
+            throw new ArgumentException("Values must hold ArcCount entries per scenario", nameof(values));
+        if (!arcResults.IsEmpty && arcResults.Length < valueCount)
+            throw new ArgumentException("Buffer must hold ArcCount entries per scenario", nameof(arcResults));
+
+        int result;
+        fixed (long* valuePtr = values)
+        fixed (long* objectivePtr = objectives)
+        fixed (long* arcResultPtr = arcResults)
+        {
+            result = lemon_scenario_batch_run(graph.Handle, (int)algorithm, source.Id, target.Id, valuePtr,
+                                              objectives.Length, threadCount, objectivePtr, arcResultPtr);
+        }
+
+        if (result < 0)
+        {
+            int scenario = objectives.IndexOf(-1);
+            if (scenario >= 0)
+                throw new ArgumentException($"Scenario {scenario} has a negative value", nameof(values));
+            throw new InvalidOperationException("Failed to solve the scenarios");
+        }
+    }
+}
@@ -29,6 +29,12 @@ public class ShortestPathResult
     /// </summary>
     public bool HasNegativeCycle { get; }
 
+    /// <summary>
+    /// Gets the arcs of the detected negative cycle, in order (Bellman-Ford only).
+    /// Returns null if no negative cycle was detected or it could not be extracted.
+    /// </summary>
+    public Path? Cycle { get; }
+
     /// <summary>
     /// Creates a new shortest path result.
     /// </summary>
@@ -36,12 +42,14 @@ public class ShortestPathResult
     /// <param name="path">The path from source to target.</param>
     /// <param name="targetReached">Whether the target was reached.</param>
     /// <param name="hasNegativeCycle">Whether a negative cycle was detected.</param>
-    public ShortestPathResult(double distance, Path? path, bool targetReached, bool hasNegativeCycle = false)
+    /// <param name="cycle">The detected negative cycle, if any.</param>
+    public ShortestPathResult(double distance, Path? path, bool targetReached, bool hasNegativeCycle = false, Path? cycle = null)
     {
         Distance = distance;
         Path = path;
         TargetReached = targetReached;
         HasNegativeCycle = hasNegativeCycle;
+        Cycle = cycle;
     }
 
     /// <summary>
@@ -55,9 +63,10 @@ public class ShortestPathResult
     /// <summary>
     /// Creates a result for a negative cycle detection.
     /// </summary>
-    public static ShortestPathResult NegativeCycle()
+    /// <param name="cycle">The detected negative cycle, if it was extracted.</param>
+    public static ShortestPathResult NegativeCycle(Path? cycle = null)
     {
-        return new ShortestPathResult(double.PositiveInfinity, null, false, true);
+        return new ShortestPathResult(double.PositiveInfinity, null, false, true, cycle);
     }
 
     public override string ToString()
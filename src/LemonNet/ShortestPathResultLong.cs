@@ -0,0 +1,73 @@
+using System;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents the result of a shortest path computation over integer arc lengths.
+/// </summary>
+public class ShortestPathResultLong
+{
+    /// <summary>
+    /// Gets the exact distance from source to target.
+    /// Returns long.MaxValue if the target is not reachable.
+    /// </summary>
+    public long Distance { get; }
+
+    /// <summary>
+    /// Gets the path from source to target.
+    /// Returns null if no path exists.
+    /// </summary>
+    public Path? Path { get; }
+
+    /// <summary>
+    /// Gets whether the target was reached from the source.
+    /// </summary>
+    public bool TargetReached { get; }
+
+    /// <summary>
+    /// Gets whether a negative cycle was detected (Bellman-Ford only).
+    /// </summary>
+    public bool HasNegativeCycle { get; }
+
+    /// <summary>
+    /// Creates a new integer shortest path result.
+    /// </summary>
+    /// <param name="distance">The distance from source to target.</param>
+    /// <param name="path">The path from source to target.</param>
+    /// <param name="targetReached">Whether the target was reached.</param>
+    /// <param name="hasNegativeCycle">Whether a negative cycle was detected.</param>
+    public ShortestPathResultLong(long distance, Path? path, bool targetReached, bool hasNegativeCycle = false)
+    {
+        Distance = distance;
+        Path = path;
+        TargetReached = targetReached;
+        HasNegativeCycle = hasNegativeCycle;
+    }
+
+    /// <summary>
+    /// Creates a result for an unreachable target.
+    /// </summary>
+    public static ShortestPathResultLong Unreachable()
+    {
+        return new ShortestPathResultLong(long.MaxValue, null, false, false);
+    }
+
+    /// <summary>
+    /// Creates a result for a negative cycle detection.
+    /// </summary>
+    public static ShortestPathResultLong NegativeCycle()
+    {
+        return new ShortestPathResultLong(long.MaxValue, null, false, true);
+    }
+
+    public override string ToString()
+    {
+        if (HasNegativeCycle)
+            return "Shortest Path: Negative cycle detected";
+
+        if (!TargetReached)
+            return "Shortest Path: Target unreachable";
+
+        return $"Shortest Path: Distance = {Distance}, Path length = {Path?.Length ?? 0}";
+    }
+}
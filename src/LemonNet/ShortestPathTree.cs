@@ -0,0 +1,113 @@
+using System;
+using System.Collections.Generic;
+
+namespace LemonNet;
+
+/// <summary>
+/// Represents a single-source shortest path tree: the distance of every node
+/// from the source and the arc through which each node was reached.
+/// </summary>
+public class ShortestPathTree
+{
+    private readonly LemonDigraph graph;
+    private readonly double[] distances;
+    private readonly int[] predecessorArcIds;
+
+    /// <summary>
+    /// Creates a new shortest path tree.
+    /// </summary>
+    /// <param name="graph">The graph the tree was computed on.</param>
+    /// <param name="source">The source node of the tree.</param>
+    /// <param name="distances">Distance of every node, indexed by node id (PositiveInfinity if unreachable).</param>
+    /// <param name="predecessorArcIds">Incoming tree arc of every node, indexed by node id (-1 if none).</param>
+    /// <param name="reachedCount">The number of nodes reached from the source.</param>
+    internal ShortestPathTree(LemonDigraph graph, Node source, double[] distances, int[] predecessorArcIds, int reachedCount)
+    {
+        this.graph = graph;
+        this.distances = distances;
+        this.predecessorArcIds = predecessorArcIds;
+        Source = source;
+        ReachedCount = reachedCount;
+    }
+
+    /// <summary>
+    /// Gets the source node of the tree.
+    /// </summary>
+    public Node Source { get; }
+
+    /// <summary>
+    /// Gets the number of nodes reached from the source (including the source).
+    /// </summary>
+    public int ReachedCount { get; }
+
+    /// <summary>
+    /// Gets the distances of all nodes, indexed by node id.
+    /// Unreachable nodes have distance double.PositiveInfinity.
+    /// </summary>
+    public ReadOnlySpan<double> Distances => distances;
+
+    /// <summary>
+    /// Gets the incoming tree arc ids of all nodes, indexed by node id.
+    /// The source and unreachable nodes have -1.
+    /// </summary>
+    public ReadOnlySpan<int> PredecessorArcIds => predecessorArcIds;
+
+    /// <summary>
+    /// Gets whether a node was reached from the source.
+    /// </summary>
+    /// <param name="node">The node to query.</param>
+    public bool Reached(Node node) => !double.IsPositiveInfinity(Distance(node));
+
+    /// <summary>
+    /// Gets the shortest distance from the source to a node.
+    /// </summary>
+    /// <param name="node">The node to query.</param>
+    /// <returns>The distance, or double.PositiveInfinity if the node is unreachable.</returns>
+    public double Distance(Node node)
+    {
+        if (!graph.IsValid(node) || node.Id >= distances.Length)
+            throw new ArgumentException("Invalid node", nameof(node));
+
+        return distances[node.Id];
+    }
+
+    /// <summary>
+    /// Gets the arc through which a node is reached in the tree.
+    /// </summary>
+    /// <param name="node">The node to query.</param>
+    /// <returns>The incoming tree arc, or Arc.Invalid for the source and unreachable nodes.</returns>
+    public Arc PredecessorArc(Node node)
+    {
+        if (!graph.IsValid(node) || node.Id >= predecessorArcIds.Length)
+            throw new ArgumentException("Invalid node", nameof(node));
+
+        int arcId = predecessorArcIds[node.Id];
+        return arcId >= 0 ? new Arc(arcId) : Arc.Invalid;
+    }
+
+    /// <summary>
+    /// Builds the tree path from the source to a node.
+    /// </summary>
+    /// <param name="target">The target node.</param>
+    /// <returns>The path, or null if the target is unreachable.</returns>
+    public Path? PathTo(Node target)
+    {
+        if (!Reached(target))
+            return null;
+
+        var arcs = new List<Arc>();
+        Node current = target;
+        while (current != Source)
+        {
+            Arc arc = PredecessorArc(current);
+            if (!arc.IsValid)
+                break;
+
+            arcs.Add(arc);
+            current = graph.Source(arc);
+        }
+
+        arcs.Reverse();
+        return new Path(graph, arcs);
+    }
+}
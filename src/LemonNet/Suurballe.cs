@@ -0,0 +1,155 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Selects what the paths found by <see cref="Suurballe"/> must not share.
+/// </summary>
+public enum Disjointness
+{
+    /// <summary>
+    /// The paths share no arc.
+    /// </summary>
+    Arcs = 0,
+
+    /// <summary>
+    /// The paths share no node other than the source and the target.
+    /// </summary>
+    Nodes = 1
+}
+
+/// <summary>
+/// Suurballe's algorithm for k disjoint paths of minimum total length between two nodes,
+/// e.g. a working and a protection route. Arc lengths must be non-negative.
+/// </summary>
+/// <remarks>
+/// The instance keeps its native state between queries: arc lengths are copied when it is
+/// created, and consecutive queries from the same source reuse the initial shortest path tree.
+/// Create a new instance after changing the graph or the lengths.
+/// </remarks>
+public class Suurballe : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private IntPtr suurballeHandle;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_create_suurballe(IntPtr graph, IntPtr length_map, int disjoint);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_destroy_suurballe(IntPtr suurballe);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern int lemon_suurballe_run(IntPtr suurballe, int source, int target, int k,
+                                                  out double total_length, int[] path_offsets,
+                                                  int[] arc_ids, int arc_capacity);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new instance of Suurballe's algorithm.
+    /// </summary>
+    /// <param name="graph">The digraph to operate on.</param>
+    /// <param name="lengthMap">The arc map containing non-negative arc lengths.</param>
+    /// <param name="disjointness">Whether the paths must be arc-disjoint or node-disjoint.</param>
+    public Suurballe(LemonDigraph graph, ArcMapDouble lengthMap, Disjointness disjointness = Disjointness.Arcs)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        if (lengthMap == null)
+            throw new ArgumentNullException(nameof(lengthMap));
+
+        Disjointness = disjointness;
+        suurballeHandle = lemon_create_suurballe(graph.Handle, lengthMap.Handle, (int)disjointness);
+
+        if (suurballeHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to create Suurballe instance (arc lengths must be non-negative)");
+        }
+    }
+
+    /// <summary>
+    /// Gets whether the paths are arc-disjoint or node-disjoint.
+    /// </summary>
+    public Disjointness Disjointness { get; }
+
+    /// <summary>
+    /// Finds up to k disjoint paths from source to target with minimum total length.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    /// <param name="target">The target node, different from the source.</param>
+    /// <param name="k">The number of paths to find.</param>
+    /// <returns>The paths found, fewer than k if the graph has no more disjoint paths.</returns>
+    public DisjointPathsResult Run(Node source, Node target, int k = 2)
+    {
+        ThrowIfDisposed();
+
+        if (!graph.IsValid(source))
+            throw new ArgumentException("Invalid source node", nameof(source));
+        if (!graph.IsValid(target))
+            throw new ArgumentException("Invalid target node", nameof(target));
+        if (source == target)
+            throw new ArgumentException("Source and target must differ", nameof(target));
+        if (k < 0)
+            throw new ArgumentOutOfRangeException(nameof(k), "k must be non-negative");
+
+        // Disjoint paths use every arc at most once
+        var pathOffsets = new int[k + 1];
+        var arcIds = new int[graph.ArcCount];
+        int pathCount = lemon_suurballe_run(suurballeHandle, source.Id, target.Id, k,
+                                            out double totalLength, pathOffsets, arcIds, arcIds.Length);
+
+        if (pathCount < 0)
+        {
+            throw new InvalidOperationException("Failed to compute disjoint paths (the graph changed since this instance was created)");
+        }
+
+        var paths = new Path[pathCount];
+        for (int i = 0; i < pathCount; i++)
+        {
+            var arcs = new Arc[pathOffsets[i + 1] - pathOffsets[i]];
+            for (int j = 0; j < arcs.Length; j++)
+            {
+                arcs[j] = new Arc(arcIds[pathOffsets[i] + j]);
+            }
+            paths[i] = new Path(graph, arcs);
+        }
+
+        return new DisjointPathsResult(totalLength, paths);
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (suurballeHandle != IntPtr.Zero)
+            {
+                lemon_destroy_suurballe(suurballeHandle);
+                suurballeHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~Suurballe()
+    {
+        Dispose(disposing: false);
+    }
+}
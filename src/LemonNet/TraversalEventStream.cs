@@ -0,0 +1,281 @@
+using System;
+using System.Runtime.InteropServices;
+
+namespace LemonNet;
+
+/// <summary>
+/// Selects the search order of a <see cref="TraversalEventStream"/>.
+/// </summary>
+public enum TraversalKind
+{
+    /// <summary>
+    /// Breadth-first search (LEMON's <c>BfsVisit</c>).
+    /// </summary>
+    BreadthFirst = 0,
+
+    /// <summary>
+    /// Depth-first search (LEMON's <c>DfsVisit</c>).
+    /// </summary>
+    DepthFirst = 1
+}
+
+/// <summary>
+/// Visitor events of a traversal; combine them to filter the recorded events.
+/// </summary>
+[Flags]
+public enum TraversalEventKind
+{
+    /// <summary>
+    /// No event.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// A search tree starts at the node.
+    /// </summary>
+    Start = 1,
+
+    /// <summary>
+    /// The node is reached for the first time.
+    /// </summary>
+    Reach = 2,
+
+    /// <summary>
+    /// The arc leads to an unreached node and becomes a tree arc.
+    /// </summary>
+    Discover = 4,
+
+    /// <summary>
+    /// The arc leads to a node that was already reached.
+    /// </summary>
+    Examine = 8,
+
+    /// <summary>
+    /// Breadth-first search takes the node from its queue and scans its out-arcs.
+    /// </summary>
+    Process = 16,
+
+    /// <summary>
+    /// Depth-first search has explored all out-arcs of the node.
+    /// </summary>
+    Leave = 32,
+
+    /// <summary>
+    /// Depth-first search returns along the tree arc to its source.
+    /// </summary>
+    Backtrack = 64,
+
+    /// <summary>
+    /// Depth-first search finished the search tree rooted at the node.
+    /// </summary>
+    Stop = 128,
+
+    /// <summary>
+    /// All events.
+    /// </summary>
+    All = Start | Reach | Discover | Examine | Process | Leave | Backtrack | Stop
+}
+
+/// <summary>
+/// A visitor event recorded by a <see cref="TraversalEventStream"/>.
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public readonly struct TraversalEvent
+{
+    private readonly int kind;
+    private readonly int node;
+    private readonly int arc;
+
+    /// <summary>
+    /// Gets the kind of the event.
+    /// </summary>
+    public TraversalEventKind Kind => (TraversalEventKind)kind;
+
+    /// <summary>
+    /// Gets the node of the event. For arc events this is the node the traversal moves to:
+    /// the target of a discovered or examined arc, the source of a backtracked one.
+    /// </summary>
+    public Node Node => new Node(node);
+
+    /// <summary>
+    /// Gets the arc of a discover, examine or backtrack event; <see cref="Arc.Invalid"/> otherwise.
+    /// </summary>
+    public Arc Arc => new Arc(arc);
+
+    public override string ToString() => arc >= 0 ? $"{Kind} {Node} via {Arc}" : $"{Kind} {Node}";
+}
+
+/// <summary>
+/// Runs a breadth-first or depth-first search natively and streams its visitor events to
+/// managed code in chunks, so custom traversal logic does not pay a callback per event.
+/// </summary>
+/// <remarks>
+/// Events are recorded into a native ring buffer. Each <see cref="Read"/> advances the search
+/// (one node at a time for BFS, one arc at a time for DFS) until <see cref="FlushThreshold"/>
+/// events are buffered or the search ends, then copies as many events as fit into the caller's
+/// span. Events excluded by <see cref="EventFilter"/> are not recorded at all. The buffer only
+/// grows beyond its capacity if a single step records more events than are free, e.g. a BFS
+/// node with more out-arcs than the capacity. The graph must not change during a traversal.
+/// </remarks>
+public class TraversalEventStream : IDisposable
+{
+    private readonly LemonDigraph graph;
+    private IntPtr traversalHandle;
+    private bool started = false;
+    private bool disposed = false;
+
+    #region P/Invoke declarations
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern IntPtr lemon_traversal_create(IntPtr graph, int kind, int capacity);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern void lemon_traversal_destroy(IntPtr traversal);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_traversal_start(IntPtr traversal, int* sources, int source_count,
+                                                           int event_mask, int flush_threshold);
+
+    [DllImport("lemon_wrapper", CallingConvention = CallingConvention.Cdecl)]
+    private static extern unsafe int lemon_traversal_read(IntPtr traversal, TraversalEvent* events, int max_events);
+
+    #endregion
+
+    /// <summary>
+    /// Creates a new traversal event stream.
+    /// </summary>
+    /// <param name="graph">The digraph to traverse.</param>
+    /// <param name="kind">Breadth-first or depth-first search.</param>
+    /// <param name="capacity">Number of events the native ring buffer holds.</param>
+    public TraversalEventStream(LemonDigraph graph, TraversalKind kind, int capacity = 4096)
+    {
+        this.graph = graph ?? throw new ArgumentNullException(nameof(graph));
+        if (capacity <= 0)
+            throw new ArgumentOutOfRangeException(nameof(capacity), "Capacity must be positive");
+
+        Kind = kind;
+        Capacity = capacity;
+        traversalHandle = lemon_traversal_create(graph.Handle, (int)kind, capacity);
+
+        if (traversalHandle == IntPtr.Zero)
+        {
+            throw new InvalidOperationException("Failed to create traversal event stream");
+        }
+    }
+
+    /// <summary>
+    /// Gets the search order.
+    /// </summary>
+    public TraversalKind Kind { get; }
+
+    /// <summary>
+    /// Gets the number of events the ring buffer holds.
+    /// </summary>
+    public int Capacity { get; }
+
+    /// <summary>
+    /// Gets or sets the events to record. Takes effect at the next <see cref="Start(ReadOnlySpan{Node})"/>.
+    /// </summary>
+    public TraversalEventKind EventFilter { get; set; } = TraversalEventKind.All;
+
+    /// <summary>
+    /// Gets or sets how many events are buffered before a read returns; smaller values hand out
+    /// events sooner, larger ones cross into native code less often. Zero (the default) selects
+    /// the capacity. Takes effect at the next <see cref="Start(ReadOnlySpan{Node})"/>.
+    /// </summary>
+    public int FlushThreshold { get; set; }
+
+    /// <summary>
+    /// Starts a new traversal from a source node.
+    /// </summary>
+    /// <param name="source">The source node.</param>
+    public void Start(Node source)
+    {
+        Start(stackalloc Node[] { source });
+    }
+
+    /// <summary>
+    /// Starts a new traversal. The first source roots the first search tree; once a search runs
+    /// dry, the next source not reached yet roots another one.
+    /// </summary>
+    /// <param name="sources">The source nodes, e.g. all nodes to cover the whole graph.</param>
+    public unsafe void Start(ReadOnlySpan<Node> sources)
+    {
+        ThrowIfDisposed();
+
+        foreach (var source in sources)
+        {
+            if (!graph.IsValid(source))
+                throw new ArgumentException("Invalid source node", nameof(sources));
+        }
+        if (FlushThreshold < 0 || FlushThreshold > Capacity)
+            throw new InvalidOperationException("FlushThreshold must be between zero and the capacity");
+
+        int threshold = FlushThreshold == 0 ? Capacity : FlushThreshold;
+        int result;
+        fixed (int* ids = MemoryMarshal.Cast<Node, int>(sources))
+        {
+            result = lemon_traversal_start(traversalHandle, ids, sources.Length, (int)EventFilter, threshold);
+        }
+
+        if (result < 0)
+        {
+            throw new InvalidOperationException("Failed to start traversal");
+        }
+
+        started = true;
+    }
+
+    /// <summary>
+    /// Advances the traversal and copies the next events into a buffer.
+    /// </summary>
+    /// <param name="events">Receives the events in the order the visitor saw them.</param>
+    /// <returns>The number of events copied; zero once the traversal is finished.</returns>
+    public unsafe int Read(Span<TraversalEvent> events)
+    {
+        ThrowIfDisposed();
+
+        if (!started)
+            throw new InvalidOperationException("Start must be called before Read");
+        if (events.IsEmpty)
+            throw new ArgumentException("Buffer must hold at least one event", nameof(events));
+
+        fixed (TraversalEvent* buffer = events)
+        {
+            return lemon_traversal_read(traversalHandle, buffer, events.Length);
+        }
+    }
+
+    private void ThrowIfDisposed()
+    {
+        if (disposed)
+        {
+            throw new ObjectDisposedException(GetType().FullName);
+        }
+    }
+
+    protected virtual void Dispose(bool disposing)
+    {
+        if (!disposed)
+        {
+            if (traversalHandle != IntPtr.Zero)
+            {
+                lemon_traversal_destroy(traversalHandle);
+                traversalHandle = IntPtr.Zero;
+            }
+
+            disposed = true;
+        }
+    }
+
+    public void Dispose()
+    {
+        Dispose(disposing: true);
+        GC.SuppressFinalize(this);
+    }
+
+    ~TraversalEventStream()
+    {
+        Dispose(disposing: false);
+    }
+}
@@ -0,0 +1,220 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class AssignmentTests
+{
+    private readonly ITestOutputHelper output;
+
+    public AssignmentTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void SmallMatrix_ReturnsOptimalAssignment()
+    {
+        // Arrange
+        double[] costs =
+        {
+            4, 1, 3,
+            2, 0, 5,
+            3, 2, 2,
+        };
+
+        // Act
+        var result = Assignment.Solve(costs, 3);
+
+        // Assert: 0->1, 1->0, 2->2
+        Assert.NotNull(result);
+        Assert.Equal(5.0, result!.TotalCost);
+        Assert.Equal(new[] { 1, 0, 2 }, result.ColumnForRow.ToArray());
+        output.WriteLine(result.ToString());
+    }
+
+    [Fact]
+    public void RandomMatrices_MatchBruteForce()
+    {
+        var random = new Random(37);
+
+        for (int iteration = 0; iteration < 60; iteration++)
+        {
+            // Arrange
+            int n = random.Next(1, 8);
+            var costs = new double[n * n];
+            for (int i = 0; i < costs.Length; i++)
+            {
+                costs[i] = random.Next(4) == 0 ? double.PositiveInfinity : random.Next(-20, 50);
+            }
+
+            double expected = BruteForce(costs, n);
+            var columnForRow = new int[n];
+
+            // Act
+            bool solved = Assignment.TrySolve(costs, n, columnForRow, out double totalCost);
+
+            // Assert
+            Assert.Equal(!double.IsPositiveInfinity(expected), solved);
+            if (solved)
+            {
+                Assert.Equal(expected, totalCost);
+                Assert.Equal(n, columnForRow.Distinct().Count());
+                Assert.Equal(expected, Enumerable.Range(0, n).Sum(row => costs[row * n + columnForRow[row]]));
+            }
+        }
+    }
+
+    [Fact]
+    public void Sparse_MatchesDense()
+    {
+        var random = new Random(41);
+
+        for (int iteration = 0; iteration < 20; iteration++)
+        {
+            // Arrange: a square problem with a diagonal so that it is always feasible
+            int n = random.Next(2, 40);
+            var dense = Enumerable.Repeat(double.PositiveInfinity, n * n).ToArray();
+            var rows = new List<int>();
+            var columns = new List<int>();
+            var costs = new List<double>();
+            for (int row = 0; row < n; row++)
+            {
+                for (int column = 0; column < n; column++)
+                {
+                    if (row != column && random.Next(3) != 0) continue;
+                    double cost = random.Next(0, 100);
+                    dense[row * n + column] = cost;
+                    rows.Add(row);
+                    columns.Add(column);
+                    costs.Add(cost);
+                }
+            }
+
+            // Act
+            var denseResult = Assignment.Solve(dense, n);
+            var sparseResult = Assignment.SolveSparse(n, n, rows.ToArray(), columns.ToArray(), costs.ToArray());
+
+            // Assert
+            Assert.NotNull(denseResult);
+            Assert.NotNull(sparseResult);
+            Assert.Equal(denseResult!.TotalCost, sparseResult!.TotalCost);
+            Assert.Equal(n, sparseResult.ColumnForRow.Distinct().Count());
+        }
+    }
+
+    [Fact]
+    public void SparseRectangular_MatchesPaddedDense()
+    {
+        var random = new Random(43);
+
+        for (int iteration = 0; iteration < 20; iteration++)
+        {
+            // Arrange: extra zero-cost rows turn the rectangular problem into a square one
+            int rowCount = random.Next(1, 15);
+            int columnCount = rowCount + random.Next(1, 10);
+            var dense = new double[columnCount * columnCount];
+            var rows = new List<int>();
+            var columns = new List<int>();
+            var costs = new List<double>();
+            for (int row = 0; row < rowCount; row++)
+            {
+                for (int column = 0; column < columnCount; column++)
+                {
+                    double cost = random.Next(0, 100);
+                    dense[row * columnCount + column] = cost;
+                    rows.Add(row);
+                    columns.Add(column);
+                    costs.Add(cost);
+                }
+            }
+
+            // Act
+            var denseResult = Assignment.Solve(dense, columnCount);
+            var sparseResult = Assignment.SolveSparse(rowCount, columnCount, rows.ToArray(), columns.ToArray(), costs.ToArray());
+
+            // Assert
+            Assert.Equal(denseResult!.TotalCost, sparseResult!.TotalCost);
+            Assert.Equal(rowCount, sparseResult.ColumnForRow.Distinct().Count());
+        }
+    }
+
+    [Fact]
+    public void Sparse_RectangularAndInfeasible()
+    {
+        // Arrange: two rows, three columns; both rows prefer column 1
+        int[] rows = { 0, 0, 1, 1 };
+        int[] columns = { 1, 2, 1, 0 };
+        double[] costs = { 1, 5, 2, 9 };
+
+        // Act
+        var result = Assignment.SolveSparse(2, 3, rows, columns, costs);
+        var infeasible = Assignment.SolveSparse(2, 3, new[] { 0, 1 }, new[] { 2, 2 }, new[] { 1.0, 1.0 });
+
+        // Assert
+        Assert.NotNull(result);
+        Assert.Equal(7.0, result!.TotalCost);
+        Assert.Equal(new[] { 2, 1 }, result.ColumnForRow.ToArray());
+        Assert.Null(infeasible);
+    }
+
+    [Fact]
+    public void ForbiddenPairs_CanMakeDenseInfeasible()
+    {
+        // Arrange: column 1 is forbidden for every row
+        double inf = double.PositiveInfinity;
+        double[] costs = { 1, inf, 2, inf };
+
+        // Act & Assert
+        Assert.Null(Assignment.Solve(costs, 2));
+        Assert.Throws<ArgumentException>(() => Assignment.Solve(new[] { double.NaN }, 1));
+        Assert.Throws<ArgumentException>(() => Assignment.Solve(costs, 3));
+    }
+
+    [Fact]
+    public void EmptyProblem_HasEmptyAssignment()
+    {
+        // Act
+        var dense = Assignment.Solve(ReadOnlySpan<double>.Empty, 0);
+        var sparse = Assignment.SolveSparse(0, 0, ReadOnlySpan<int>.Empty, ReadOnlySpan<int>.Empty,
+                                            ReadOnlySpan<double>.Empty);
+
+        // Assert
+        Assert.NotNull(dense);
+        Assert.Equal(0.0, dense!.TotalCost);
+        Assert.Empty(dense.ColumnForRow);
+        Assert.NotNull(sparse);
+        Assert.Empty(sparse!.ColumnForRow);
+    }
+
+    private static double BruteForce(double[] costs, int n)
+    {
+        double best = double.PositiveInfinity;
+        var permutation = Enumerable.Range(0, n).ToArray();
+        Permute(0);
+        return best;
+
+        void Permute(int k)
+        {
+            if (k == n)
+            {
+                double total = 0;
+                for (int row = 0; row < n; row++)
+                {
+                    total += costs[row * n + permutation[row]];
+                }
+                best = Math.Min(best, total);
+                return;
+            }
+            for (int i = k; i < n; i++)
+            {
+                (permutation[k], permutation[i]) = (permutation[i], permutation[k]);
+                Permute(k + 1);
+                (permutation[k], permutation[i]) = (permutation[i], permutation[k]);
+            }
+        }
+    }
+}
@@ -0,0 +1,111 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class BellmanFordLongTests
+{
+    private readonly ITestOutputHelper output;
+
+    public BellmanFordLongTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void NegativeWeights_FindsCorrectPath()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc02 = graph.AddArc(node0, node2);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 1;
+        lengthMap[arc12] = -3;
+        lengthMap[arc02] = 2;
+
+        using var bellmanFord = new BellmanFordLong(graph, lengthMap);
+
+        // Act
+        var result = bellmanFord.Run(node0, node2);
+
+        // Assert
+        Assert.True(result.TargetReached);
+        Assert.False(result.HasNegativeCycle);
+        Assert.Equal(-2L, result.Distance);
+        Assert.NotNull(result.Path);
+        Assert.Equal(2, result.Path.Length);
+        output.WriteLine($"Path with negative weight distance: {result.Distance}");
+    }
+
+    [Fact]
+    public void NegativeCycle_DetectsCorrectly()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc20 = graph.AddArc(node2, node0);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 1;
+        lengthMap[arc12] = -2;
+        lengthMap[arc20] = -1;
+
+        using var bellmanFord = new BellmanFordLong(graph, lengthMap);
+
+        // Act
+        var result = bellmanFord.Run(node0, node2);
+
+        // Assert
+        Assert.True(result.HasNegativeCycle);
+        Assert.False(result.TargetReached);
+        Assert.Equal(long.MaxValue, result.Distance);
+        Assert.Null(result.Path);
+    }
+
+    [Fact]
+    public void CompareWithDijkstraLong_SameResultForPositiveWeights()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc13 = graph.AddArc(node1, node3);
+        var arc23 = graph.AddArc(node2, node3);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 2;
+        lengthMap[arc02] = 4;
+        lengthMap[arc13] = 3;
+        lengthMap[arc23] = 1;
+
+        using var dijkstra = new DijkstraLong(graph, lengthMap);
+        using var bellmanFord = new BellmanFordLong(graph, lengthMap);
+
+        // Act
+        var dijkstraResult = dijkstra.Run(node0, node3);
+        var bellmanFordResult = bellmanFord.Run(node0, node3);
+
+        // Assert
+        Assert.Equal(dijkstraResult.Distance, bellmanFordResult.Distance);
+        Assert.Equal(dijkstraResult.TargetReached, bellmanFordResult.TargetReached);
+    }
+}
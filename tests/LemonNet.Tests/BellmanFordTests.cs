@@ -226,4 +226,147 @@ public class BellmanFordTests
         Assert.Equal(dijkstraResult.TargetReached, bellmanFordResult.TargetReached);
         output.WriteLine($"Both algorithms found distance: {dijkstraResult.Distance}");
     }
-}
\ No newline at end of file
+
+    [Theory]
+    [InlineData(BellmanFordMode.Rounds)]
+    [InlineData(BellmanFordMode.Queue)]
+    [InlineData(BellmanFordMode.EdgeList)]
+    public void NegativeCycle_ReturnsCycleArcs(BellmanFordMode mode)
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc23 = graph.AddArc(node2, node3);
+        var arc31 = graph.AddArc(node3, node1);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 1.0;
+        lengthMap[arc12] = 2.0;
+        lengthMap[arc23] = -4.0;
+        lengthMap[arc31] = 1.0;  // Cycle 1 -> 2 -> 3 -> 1 has length -1
+
+        using var bellmanFord = new BellmanFord(graph, lengthMap) { Mode = mode };
+
+        // Act
+        var result = bellmanFord.Run(node0, node3);
+
+        // Assert
+        Assert.True(result.HasNegativeCycle);
+        Assert.NotNull(result.Cycle);
+        Assert.Equal(3, result.Cycle.Length);
+        Assert.Equal(-1.0, result.Cycle.GetTotalCost(lengthMap));
+        for (int i = 0; i < result.Cycle.Length; i++)
+        {
+            var next = result.Cycle[(i + 1) % result.Cycle.Length];
+            Assert.Equal(graph.Target(result.Cycle[i]), graph.Source(next));
+        }
+        output.WriteLine($"Negative cycle: {result.Cycle}");
+    }
+
+    [Fact]
+    public void FindNegativeCycle_ReturnsNullWithoutCycle()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = -1.0;
+
+        using var bellmanFord = new BellmanFord(graph, lengthMap) { Mode = BellmanFordMode.Queue };
+
+        // Act & Assert
+        Assert.Null(bellmanFord.FindNegativeCycle(node0));
+    }
+
+    [Fact]
+    public void QueueMode_MatchesRoundsOnRandomGraph()
+    {
+        // Arrange: lengths shifted by node potentials can be negative,
+        // but every cycle keeps its non-negative length
+        var random = new Random(11);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 150).Select(_ => graph.AddNode()).ToArray();
+        var potential = nodes.Select(_ => random.Next(0, 60)).ToArray();
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 1200; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            var arc = graph.AddArc(nodes[u], nodes[v]);
+            lengthMap[arc] = random.Next(0, 40) + potential[u] - potential[v];
+        }
+
+        using var rounds = new BellmanFord(graph, lengthMap) { Mode = BellmanFordMode.Rounds };
+        using var queue = new BellmanFord(graph, lengthMap) { Mode = BellmanFordMode.Queue };
+
+        // Act & Assert
+        foreach (var node in nodes)
+        {
+            var expected = rounds.Run(nodes[0], node);
+            var actual = queue.Run(nodes[0], node);
+
+            Assert.False(actual.HasNegativeCycle);
+            Assert.Equal(expected.TargetReached, actual.TargetReached);
+            Assert.Equal(expected.Distance, actual.Distance);
+            if (actual.TargetReached)
+            {
+                Assert.Equal(actual.Distance, actual.Path!.GetTotalCost(lengthMap));
+            }
+        }
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(3)]
+    [InlineData(8)]
+    public void EdgeListMode_MatchesRoundsOnRandomGraph(int threadCount)
+    {
+        // Arrange
+        var random = new Random(23);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 200).Select(_ => graph.AddNode()).ToArray();
+        var potential = nodes.Select(_ => random.Next(0, 60)).ToArray();
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 3000; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            var arc = graph.AddArc(nodes[u], nodes[v]);
+            lengthMap[arc] = random.Next(0, 40) + potential[u] - potential[v];
+        }
+
+        using var rounds = new BellmanFord(graph, lengthMap) { Mode = BellmanFordMode.Rounds };
+        using var edgeList = new BellmanFord(graph, lengthMap)
+        {
+            Mode = BellmanFordMode.EdgeList,
+            ThreadCount = threadCount
+        };
+
+        // Act & Assert
+        foreach (var node in nodes)
+        {
+            var expected = rounds.Run(nodes[0], node);
+            var actual = edgeList.Run(nodes[0], node);
+
+            Assert.False(actual.HasNegativeCycle);
+            Assert.Equal(expected.TargetReached, actual.TargetReached);
+            Assert.Equal(expected.Distance, actual.Distance);
+            if (actual.TargetReached)
+            {
+                Assert.Equal(actual.Distance, actual.Path!.GetTotalCost(lengthMap));
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class BreadthFirstSearchTests
+{
+    private readonly ITestOutputHelper output;
+
+    public BreadthFirstSearchTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public void SimpleGraph_ComputesHopDistances(bool directionOptimizing)
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        var arc01 = graph.AddArc(nodes[0], nodes[1]);
+        graph.AddArc(nodes[0], nodes[2]);
+        var arc13 = graph.AddArc(nodes[1], nodes[3]);
+        graph.AddArc(nodes[3], nodes[0]);
+
+        using var bfs = new BreadthFirstSearch(graph) { DirectionOptimizing = directionOptimizing };
+        var distances = new int[graph.NodeCount];
+        var predecessors = new int[graph.NodeCount];
+
+        // Act
+        int reached = bfs.Run(nodes[0], distances, predecessors);
+
+        // Assert
+        Assert.Equal(4, reached);
+        Assert.Equal(new[] { 0, 1, 1, 2, -1 }, distances);
+        Assert.Equal(-1, predecessors[0]);
+        Assert.Equal(arc01.GetHashCode(), predecessors[1]);
+        Assert.Equal(arc13.GetHashCode(), predecessors[3]);
+        Assert.Equal(-1, predecessors[4]);
+    }
+
+    [Theory]
+    [InlineData(0, 0, 1)]
+    [InlineData(1, 1, 1)]
+    [InlineData(1000, 2, 1)]
+    [InlineData(2, 1000, 1)]
+    [InlineData(0, 0, 4)]
+    [InlineData(0, 0, 0)]
+    public void PowerLawGraph_MatchesTopDown(int alpha, int beta, int threadCount)
+    {
+        // Arrange: hubs with many low-degree nodes so the search switches direction
+        var random = new Random(71);
+        using var graph = new LemonDigraph();
+        int nodeCount = 2000;
+        var nodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+        var sources = new List<int>();
+        var targets = new List<int>();
+        for (int i = 0; i < 12000; i++)
+        {
+            int u = (int)(nodeCount * Math.Pow(random.NextDouble(), 3));
+            int v = random.Next(nodeCount);
+            graph.AddArc(nodes[u], nodes[v]);
+            graph.AddArc(nodes[v], nodes[u]);
+            sources.Add(u);
+            targets.Add(v);
+            sources.Add(v);
+            targets.Add(u);
+        }
+
+        using var topDown = new BreadthFirstSearch(graph) { DirectionOptimizing = false };
+        using var hybrid = new BreadthFirstSearch(graph) { Alpha = alpha, Beta = beta, ThreadCount = threadCount };
+        var expected = new int[nodeCount];
+        var distances = new int[nodeCount];
+        var predecessors = new int[nodeCount];
+
+        // Act
+        int expectedReached = topDown.Run(nodes[0], expected, new int[nodeCount]);
+        int reached = hybrid.Run(nodes[0], distances, predecessors);
+
+        // Assert: same distances, and every tree arc ends one level deeper than it starts
+        Assert.Equal(expectedReached, reached);
+        Assert.Equal(expected, distances);
+        for (int v = 0; v < nodeCount; v++)
+        {
+            int arc = predecessors[v];
+            if (arc < 0) continue;
+            Assert.Equal(v, targets[arc]);
+            Assert.Equal(distances[v] - 1, distances[sources[arc]]);
+        }
+        output.WriteLine($"Reached {reached} nodes, depth {distances.Max()}");
+    }
+}
@@ -0,0 +1,355 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class ConnectivityTests
+{
+    private readonly ITestOutputHelper output;
+
+    public ConnectivityTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void TwoCycles_FormTwoComponentsInOrder()
+    {
+        // Arrange: cycle 0-1-2 feeds cycle 3-4, node 5 hangs off 4
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 6).Select(_ => graph.AddNode()).ToArray();
+        graph.AddArc(nodes[0], nodes[1]);
+        graph.AddArc(nodes[1], nodes[2]);
+        graph.AddArc(nodes[2], nodes[0]);
+        graph.AddArc(nodes[2], nodes[3]);
+        graph.AddArc(nodes[1], nodes[4]);
+        graph.AddArc(nodes[3], nodes[4]);
+        graph.AddArc(nodes[4], nodes[3]);
+        graph.AddArc(nodes[4], nodes[5]);
+
+        var component = new int[graph.NodeCount];
+
+        // Act
+        int count = Connectivity.StronglyConnectedComponents(graph, component);
+
+        // Assert
+        Assert.Equal(3, count);
+        Assert.Equal(component[0], component[1]);
+        Assert.Equal(component[0], component[2]);
+        Assert.Equal(component[3], component[4]);
+        Assert.True(component[0] < component[3]);
+        Assert.True(component[3] < component[5]);
+        Assert.False(Connectivity.IsDag(graph));
+        Assert.False(Connectivity.TopologicalSort(graph, new Node[graph.NodeCount]));
+    }
+
+    [Fact]
+    public void EmptyGraph_HasNoComponents()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+
+        // Act
+        int count = Connectivity.StronglyConnectedComponents(graph, Span<int>.Empty);
+        bool sorted = Connectivity.TopologicalSort(graph, Span<Node>.Empty);
+        using var condensed = Connectivity.Condense(graph, Span<int>.Empty);
+
+        // Assert
+        Assert.Equal(0, count);
+        Assert.True(sorted);
+        Assert.Equal(0, condensed.NodeCount);
+        Assert.Equal(0, condensed.ArcCount);
+    }
+
+    [Fact]
+    public void EmptyGraph_HasNoConnectedComponents()
+    {
+        // Arrange
+        using var digraph = new LemonDigraph();
+        using var graph = new LemonGraph();
+
+        // Act & Assert
+        Assert.Equal(0, Connectivity.ConnectedComponents(digraph, Span<int>.Empty));
+        Assert.Equal(0, Connectivity.ConnectedComponents(graph, Span<int>.Empty, threadCount: 4));
+    }
+
+    [Fact]
+    public void Dag_TopologicalOrderRespectsArcs()
+    {
+        // Arrange
+        var random = new Random(59);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 40).Select(_ => graph.AddNode()).ToArray();
+        var rank = Enumerable.Range(0, nodes.Length).OrderBy(_ => random.Next()).ToArray();
+        var arcs = new List<Arc>();
+        for (int i = 0; i < 120; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            if (rank[u] == rank[v]) continue;
+            arcs.Add(rank[u] < rank[v] ? graph.AddArc(nodes[u], nodes[v]) : graph.AddArc(nodes[v], nodes[u]));
+        }
+
+        var order = new Node[graph.NodeCount];
+
+        // Act
+        bool sorted = Connectivity.TopologicalSort(graph, order);
+
+        // Assert
+        Assert.True(sorted);
+        Assert.True(Connectivity.IsDag(graph));
+        Assert.Equal(nodes.Length, order.Distinct().Count());
+        var position = new int[nodes.Length];
+        for (int i = 0; i < order.Length; i++)
+        {
+            position[order[i].GetHashCode()] = i;
+        }
+        Assert.All(arcs, arc => Assert.True(position[graph.Source(arc).GetHashCode()] < position[graph.Target(arc).GetHashCode()]));
+    }
+
+    [Fact]
+    public void RandomGraph_ComponentsMatchMutualReachability()
+    {
+        // Arrange
+        var random = new Random(61);
+        using var graph = new LemonDigraph();
+        int nodeCount = 30;
+        var nodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+        var reach = new bool[nodeCount, nodeCount];
+        var endpoints = new List<(int U, int V)>();
+        for (int i = 0; i < nodeCount; i++) reach[i, i] = true;
+        for (int i = 0; i < 45; i++)
+        {
+            int u = random.Next(nodeCount);
+            int v = random.Next(nodeCount);
+            graph.AddArc(nodes[u], nodes[v]);
+            endpoints.Add((u, v));
+            reach[u, v] = true;
+        }
+        for (int k = 0; k < nodeCount; k++)
+            for (int i = 0; i < nodeCount; i++)
+                for (int j = 0; j < nodeCount; j++)
+                    reach[i, j] |= reach[i, k] && reach[k, j];
+
+        var component = new int[nodeCount];
+
+        // Act
+        using var condensed = Connectivity.Condense(graph, component);
+
+        // Assert
+        for (int u = 0; u < nodeCount; u++)
+        {
+            for (int v = 0; v < nodeCount; v++)
+            {
+                Assert.Equal(reach[u, v] && reach[v, u], component[u] == component[v]);
+                if (reach[u, v] && !reach[v, u]) Assert.True(component[u] < component[v]);
+            }
+        }
+        Assert.Equal(component.Max() + 1, condensed.NodeCount);
+        Assert.True(Connectivity.IsDag(condensed));
+        int expectedArcs = endpoints.Select(e => (component[e.U], component[e.V]))
+                                    .Where(p => p.Item1 != p.Item2)
+                                    .Distinct()
+                                    .Count();
+        Assert.Equal(expectedArcs, condensed.ArcCount);
+        output.WriteLine($"{nodeCount} nodes -> {condensed.NodeCount} components, {condensed.ArcCount} arcs");
+    }
+
+    [Fact]
+    public void BowTie_FindsCutNodeBridgeAndBlocks()
+    {
+        // Arrange: triangles 0-1-2 and 3-4-5 joined by the edge 2-3; 0-1 is doubled
+        using var graph = new LemonGraph();
+        var nodes = new Node[6];
+        graph.AddNodes(nodes);
+        var edges = new[]
+        {
+            graph.AddEdge(nodes[0], nodes[1]),
+            graph.AddEdge(nodes[1], nodes[2]),
+            graph.AddEdge(nodes[2], nodes[0]),
+            graph.AddEdge(nodes[2], nodes[3]),
+            graph.AddEdge(nodes[3], nodes[4]),
+            graph.AddEdge(nodes[4], nodes[5]),
+            graph.AddEdge(nodes[5], nodes[3]),
+            graph.AddEdge(nodes[1], nodes[0]),
+        };
+
+        var cutNodes = new ulong[Connectivity.BitsetLength(graph.NodeCount)];
+        var bridges = new ulong[Connectivity.BitsetLength(graph.EdgeCount)];
+        var blocks = new int[graph.EdgeCount];
+
+        // Act
+        int cutNodeCount = Connectivity.CutNodes(graph, cutNodes);
+        int bridgeCount = Connectivity.Bridges(graph, bridges);
+        int blockCount = Connectivity.BiconnectedComponents(graph, blocks);
+
+        // Assert
+        Assert.Equal(2, cutNodeCount);
+        Assert.True(Connectivity.IsSet(cutNodes, nodes[2]));
+        Assert.True(Connectivity.IsSet(cutNodes, nodes[3]));
+        Assert.Equal(1, bridgeCount);
+        Assert.True(Connectivity.IsSet(bridges, edges[3]));
+        Assert.False(Connectivity.IsSet(bridges, edges[0]));
+        Assert.Equal(3, blockCount);
+        Assert.Equal(blocks[0], blocks[7]);
+        Assert.Equal(blocks[4], blocks[6]);
+        Assert.Equal(3, blocks.Distinct().Count());
+    }
+
+    [Fact]
+    public void ArclessGraph_HasNoCutNodesBridgesOrBlocks()
+    {
+        // Arrange: isolated nodes, so the arc and edge buffers are empty
+        using var digraph = new LemonDigraph();
+        using var graph = new LemonGraph();
+        for (int i = 0; i < 3; i++) digraph.AddNode();
+        graph.AddNodes(new Node[3]);
+        var cutNodes = new ulong[Connectivity.BitsetLength(3)];
+
+        // Act & Assert
+        Assert.Equal(0, Connectivity.CutNodes(digraph, cutNodes));
+        Assert.Equal(0, Connectivity.Bridges(digraph, Span<ulong>.Empty));
+        Assert.Equal(0, Connectivity.BiconnectedComponents(digraph, Span<int>.Empty));
+        Assert.Equal(0, Connectivity.CutNodes(graph, cutNodes));
+        Assert.Equal(0, Connectivity.Bridges(graph, Span<ulong>.Empty));
+        Assert.Equal(0, Connectivity.BiconnectedComponents(graph, Span<int>.Empty));
+
+        // Without nodes the node bitset is empty too
+        using var empty = new LemonGraph();
+        Assert.Equal(0, Connectivity.CutNodes(empty, Span<ulong>.Empty));
+    }
+
+    [Fact]
+    public void RandomDigraph_MatchesRemovalCheck()
+    {
+        var random = new Random(67);
+
+        for (int iteration = 0; iteration < 20; iteration++)
+        {
+            // Arrange: sparse random graphs have plenty of cut nodes and bridges
+            using var graph = new LemonDigraph();
+            int nodeCount = random.Next(2, 25);
+            var nodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+            var endpoints = new List<(int U, int V)>();
+            var arcs = new List<Arc>();
+            int arcCount = random.Next(1, nodeCount * 2);
+            for (int i = 0; i < arcCount; i++)
+            {
+                int u = random.Next(nodeCount);
+                int v = random.Next(nodeCount);
+                arcs.Add(graph.AddArc(nodes[u], nodes[v]));
+                endpoints.Add((u, v));
+            }
+
+            var cutNodes = new ulong[Connectivity.BitsetLength(nodeCount)];
+            var bridges = new ulong[Connectivity.BitsetLength(arcCount)];
+            var blocks = new int[arcCount];
+
+            // Act
+            int cutNodeCount = Connectivity.CutNodes(graph, cutNodes);
+            int bridgeCount = Connectivity.Bridges(graph, bridges);
+            Connectivity.BiconnectedComponents(graph, blocks);
+
+            // Assert
+            int components = CountComponents(nodeCount, endpoints, -1, -1);
+            int expectedCutNodes = 0;
+            for (int node = 0; node < nodeCount; node++)
+            {
+                // Removing a node leaves its other nodes; isolated nodes vanish with it
+                bool isolated = endpoints.All(e => e.U != node && e.V != node || e.U == e.V);
+                int remaining = CountComponents(nodeCount, endpoints, node, -1) - 1;
+                bool isCut = remaining > components - (isolated ? 1 : 0);
+                Assert.Equal(isCut, Connectivity.IsSet(cutNodes, nodes[node]));
+                if (isCut) expectedCutNodes++;
+
+                var incidentBlocks = Enumerable.Range(0, arcCount)
+                    .Where(a => endpoints[a].U != endpoints[a].V && (endpoints[a].U == node || endpoints[a].V == node))
+                    .Select(a => blocks[a])
+                    .Distinct()
+                    .Count();
+                Assert.Equal(isCut, incidentBlocks > 1);
+            }
+            Assert.Equal(expectedCutNodes, cutNodeCount);
+
+            int expectedBridges = 0;
+            for (int a = 0; a < arcCount; a++)
+            {
+                bool isBridge = CountComponents(nodeCount, endpoints, -1, a) > components;
+                Assert.Equal(isBridge, Connectivity.IsSet(bridges, arcs[a]));
+                if (isBridge) expectedBridges++;
+            }
+            Assert.Equal(expectedBridges, bridgeCount);
+        }
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(4)]
+    public void RandomSparseGraph_ConnectedComponentsMatchUnionFind(int threadCount)
+    {
+        // Arrange: sparse enough to leave many components, large enough to split across threads
+        var random = new Random(43);
+        int nodeCount = 20000;
+        using var digraph = new LemonDigraph();
+        using var graph = new LemonGraph();
+        var digraphNodes = Enumerable.Range(0, nodeCount).Select(_ => digraph.AddNode()).ToArray();
+        var graphNodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+        var endpoints = new List<(int U, int V)>();
+        for (int i = 0; i < 18000; i++)
+        {
+            int u = random.Next(nodeCount);
+            int v = random.Next(nodeCount);
+            digraph.AddArc(digraphNodes[u], digraphNodes[v]);
+            graph.AddEdge(graphNodes[u], graphNodes[v]);
+            endpoints.Add((u, v));
+        }
+
+        var digraphComponents = new int[nodeCount];
+        var graphComponents = new int[nodeCount];
+
+        // Act
+        int digraphCount = Connectivity.ConnectedComponents(digraph, digraphComponents, threadCount);
+        int graphCount = Connectivity.ConnectedComponents(graph, graphComponents, threadCount);
+
+        // Assert: same partition as a sequential union-find, numbered by smallest node
+        Assert.Equal(CountComponents(nodeCount, endpoints, -1, -1), digraphCount);
+        Assert.Equal(digraphCount, graphCount);
+        Assert.Equal(digraphComponents, graphComponents);
+        foreach (var (u, v) in endpoints)
+        {
+            Assert.Equal(digraphComponents[u], digraphComponents[v]);
+        }
+        int nextComponent = 0;
+        for (int v = 0; v < nodeCount; v++)
+        {
+            Assert.True(digraphComponents[v] <= nextComponent);
+            if (digraphComponents[v] == nextComponent) nextComponent++;
+        }
+        Assert.Equal(digraphCount, nextComponent);
+        output.WriteLine($"{digraphCount} components");
+    }
+
+    private static int CountComponents(int nodeCount, List<(int U, int V)> endpoints, int removedNode, int removedArc)
+    {
+        var parent = Enumerable.Range(0, nodeCount).ToArray();
+        int Find(int x) => parent[x] == x ? x : parent[x] = Find(parent[x]);
+
+        int components = nodeCount;
+        for (int a = 0; a < endpoints.Count; a++)
+        {
+            var (u, v) = endpoints[a];
+            if (a == removedArc || u == removedNode || v == removedNode) continue;
+            int ru = Find(u);
+            int rv = Find(v);
+            if (ru != rv)
+            {
+                parent[ru] = rv;
+                components--;
+            }
+        }
+        return components;
+    }
+}
@@ -0,0 +1,144 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class DeltaSteppingTests
+{
+    private readonly ITestOutputHelper output;
+
+    public DeltaSteppingTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void SimpleGraph_ComputesTree()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+        var node4 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc13 = graph.AddArc(node1, node3);
+        var arc23 = graph.AddArc(node2, node3);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 2.0;
+        lengthMap[arc02] = 4.0;
+        lengthMap[arc13] = 3.0;
+        lengthMap[arc23] = 1.0;
+
+        using var deltaStepping = new DeltaStepping(graph, lengthMap);
+
+        // Act
+        var tree = deltaStepping.Run(node0);
+
+        // Assert
+        Assert.Equal(4, tree.ReachedCount);
+        Assert.Equal(0.0, tree.Distance(node0));
+        Assert.Equal(5.0, tree.Distance(node3));
+        Assert.Equal(arc13, tree.PredecessorArc(node3));
+        Assert.Equal(Arc.Invalid, tree.PredecessorArc(node0));
+        Assert.False(tree.Reached(node4));
+        Assert.Equal(double.PositiveInfinity, tree.Distance(node4));
+        Assert.Null(tree.PathTo(node4));
+        Assert.Equal(new[] { arc01, arc13 }, tree.PathTo(node3)!.ToArray());
+    }
+
+    [Theory]
+    [InlineData(1, 0.0)]
+    [InlineData(2, 0.0)]
+    [InlineData(4, 0.0)]
+    [InlineData(3, 5.0)]
+    [InlineData(4, 1000.0)]
+    public void RandomGraph_MatchesDijkstra(int threadCount, double delta)
+    {
+        // Arrange
+        var random = new Random(7);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 300).Select(_ => graph.AddNode()).ToArray();
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 2000; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            lengthMap[arc] = random.Next(0, 100);
+        }
+
+        using var dijkstra = new Dijkstra(graph, lengthMap);
+        using var deltaStepping = new DeltaStepping(graph, lengthMap)
+        {
+            ThreadCount = threadCount,
+            Delta = delta
+        };
+
+        // Act
+        var tree = deltaStepping.Run(nodes[0]);
+
+        // Assert
+        foreach (var node in nodes)
+        {
+            var expected = dijkstra.Run(nodes[0], node);
+            Assert.Equal(expected.Distance, tree.Distance(node));
+
+            if (expected.TargetReached)
+            {
+                var path = tree.PathTo(node)!;
+                Assert.Equal(expected.Distance, path.GetTotalCost(lengthMap));
+            }
+        }
+        output.WriteLine($"Reached {tree.ReachedCount} of {nodes.Length} nodes with {threadCount} threads");
+    }
+
+    [Fact]
+    public void CallerBuffers_AreFilled()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var arc01 = graph.AddArc(node0, node1);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 1.5;
+
+        using var deltaStepping = new DeltaStepping(graph, lengthMap) { ThreadCount = 2 };
+        var distances = new double[2];
+        var predecessors = new int[2];
+
+        // Act
+        int reached = deltaStepping.Run(node0, distances, predecessors);
+
+        // Assert
+        Assert.Equal(2, reached);
+        Assert.Equal(new[] { 0.0, 1.5 }, distances);
+        Assert.Equal(new[] { -1, 0 }, predecessors);
+        Assert.Throws<ArgumentException>(() => deltaStepping.Run(node0, new double[1], predecessors));
+    }
+
+    [Fact]
+    public void NegativeLength_Throws()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var arc01 = graph.AddArc(node0, node1);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = -1.0;
+
+        using var deltaStepping = new DeltaStepping(graph, lengthMap);
+
+        // Act & Assert
+        Assert.Throws<InvalidOperationException>(() => deltaStepping.Run(node0));
+    }
+}
@@ -0,0 +1,161 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class DijkstraLongTests
+{
+    private readonly ITestOutputHelper output;
+
+    public DijkstraLongTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Theory]
+    [InlineData(IntegerHeap.Radix)]
+    [InlineData(IntegerHeap.Bucket)]
+    public void SimpleGraph_FindsShortestPath(IntegerHeap heap)
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc13 = graph.AddArc(node1, node3);
+        var arc23 = graph.AddArc(node2, node3);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 2;
+        lengthMap[arc02] = 4;
+        lengthMap[arc13] = 3;
+        lengthMap[arc23] = 1;
+
+        using var dijkstra = new DijkstraLong(graph, lengthMap, heap);
+
+        // Act
+        var result = dijkstra.Run(node0, node3);
+
+        // Assert
+        Assert.True(result.TargetReached);
+        Assert.Equal(5L, result.Distance);
+        Assert.NotNull(result.Path);
+        Assert.Equal(new[] { arc01, arc13 }, result.Path.ToArray());
+        output.WriteLine($"Shortest path distance: {result.Distance}");
+    }
+
+    [Fact]
+    public void UnreachableTarget_ReturnsMaxValue()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 1;
+
+        using var dijkstra = new DijkstraLong(graph, lengthMap);
+
+        // Act
+        var result = dijkstra.Run(node0, node2);
+
+        // Assert
+        Assert.False(result.TargetReached);
+        Assert.Equal(long.MaxValue, result.Distance);
+        Assert.Null(result.Path);
+    }
+
+    [Fact]
+    public void NegativeLength_Throws()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = -1;
+
+        using var dijkstra = new DijkstraLong(graph, lengthMap);
+
+        // Act & Assert
+        Assert.Throws<InvalidOperationException>(() => dijkstra.Run(node0, node1));
+    }
+
+    [Fact]
+    public void LengthsBeyondIntRange_ReturnExactDistance()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+
+        using var lengthMap = new ArcMap(graph);
+        lengthMap[arc01] = 3_000_000_000L;
+        lengthMap[arc12] = 3_000_000_001L;
+
+        using var dijkstra = new DijkstraLong(graph, lengthMap, IntegerHeap.Bucket);
+
+        // Act
+        var result = dijkstra.Run(node0, node2);
+
+        // Assert
+        Assert.True(result.TargetReached);
+        Assert.Equal(6_000_000_001L, result.Distance);
+    }
+
+    [Theory]
+    [InlineData(IntegerHeap.Radix)]
+    [InlineData(IntegerHeap.Bucket)]
+    public void RandomGraph_MatchesDoubleDijkstra(IntegerHeap heap)
+    {
+        // Arrange
+        var random = new Random(42);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 200).Select(_ => graph.AddNode()).ToArray();
+
+        using var longLengths = new ArcMap(graph);
+        using var doubleLengths = new ArcMapDouble(graph);
+
+        for (int i = 0; i < 1000; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            long length = random.Next(0, 600);
+            longLengths[arc] = length;
+            doubleLengths[arc] = length;
+        }
+
+        using var integerDijkstra = new DijkstraLong(graph, longLengths, heap);
+        using var dijkstra = new Dijkstra(graph, doubleLengths);
+
+        // Act & Assert
+        for (int t = 0; t < nodes.Length; t += 7)
+        {
+            var expected = dijkstra.Run(nodes[0], nodes[t]);
+            var actual = integerDijkstra.Run(nodes[0], nodes[t]);
+
+            Assert.Equal(expected.TargetReached, actual.TargetReached);
+            if (expected.TargetReached)
+            {
+                Assert.Equal((long)expected.Distance, actual.Distance);
+                Assert.Equal(actual.Distance, actual.Path!.Sum(a => longLengths[a]));
+            }
+        }
+    }
+}
@@ -203,4 +203,113 @@ public class DijkstraTests
         Assert.Equal(node0, path.Source);
         Assert.Equal(node2, path.Target);
     }
-}
\ No newline at end of file
+
+    [Theory]
+    [InlineData(1, 5.0)]
+    [InlineData(3, 4.0)]
+    [InlineData(3, 0.0)]
+    public void RunBounded_MatchesFullTreesWithinBound(int sourceCount, double bound)
+    {
+        // Arrange
+        var random = new Random(45 + sourceCount);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 400).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        var arcs = new Arc[1600];
+        for (int i = 0; i < arcs.Length; i++)
+        {
+            arcs[i] = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            lengthMap[arcs[i]] = random.Next(1, 10) / 4.0;
+        }
+
+        var sources = Enumerable.Range(0, sourceCount).Select(i => nodes[i * 7]).ToArray();
+        var expected = Enumerable.Repeat(double.PositiveInfinity, nodes.Length).ToArray();
+        using var deltaStepping = new DeltaStepping(graph, lengthMap) { ThreadCount = 1 };
+        foreach (var source in sources)
+        {
+            var tree = deltaStepping.Run(source);
+            for (int v = 0; v < nodes.Length; v++)
+            {
+                expected[v] = Math.Min(expected[v], tree.Distances[v]);
+            }
+        }
+
+        using var dijkstra = new Dijkstra(graph, lengthMap);
+
+        // Act
+        var isochrone = dijkstra.RunBounded(sources, bound);
+
+        // Assert: exactly the nodes within the bound, closest first, with consistent tree arcs
+        Assert.Equal(expected.Count(d => d <= bound), isochrone.Count);
+        var settled = new double[nodes.Length];
+        Array.Fill(settled, double.PositiveInfinity);
+        for (int i = 0; i < isochrone.Count; i++)
+        {
+            var node = isochrone.Nodes[i];
+            double distance = isochrone.Distances[i];
+            Assert.Equal(expected[node.GetHashCode()], distance);
+            if (i > 0) Assert.True(isochrone.Distances[i - 1] <= distance);
+
+            int arcId = isochrone.PredecessorArcIds[i];
+            if (arcId < 0)
+            {
+                Assert.Contains(node, sources);
+            }
+            else
+            {
+                var arc = arcs[arcId];
+                Assert.Equal(node, graph.Target(arc));
+                Assert.Equal(distance, settled[graph.Source(arc).GetHashCode()] + lengthMap[arc]);
+            }
+            settled[node.GetHashCode()] = distance;
+        }
+        output.WriteLine($"{isochrone.Count} of {nodes.Length} nodes within {bound}");
+    }
+
+    [Fact]
+    public void TryRunBounded_ReportsSmallBuffers()
+    {
+        // Arrange: path 0 -> 1 -> 2 -> 3 with unit lengths
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 4).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i + 1 < nodes.Length; i++)
+        {
+            lengthMap[graph.AddArc(nodes[i], nodes[i + 1])] = 1.0;
+        }
+        using var dijkstra = new Dijkstra(graph, lengthMap);
+        var buffer = new Node[2];
+
+        // Act & Assert
+        Assert.False(dijkstra.TryRunBounded(new[] { nodes[0] }, 2.0, buffer, new double[2], new int[2], out _));
+        Assert.True(dijkstra.TryRunBounded(new[] { nodes[0] }, 1.5, buffer, new double[2], new int[2], out int count));
+        Assert.Equal(2, count);
+        Assert.Equal(new[] { nodes[0], nodes[1] }, buffer);
+        Assert.Equal(0, dijkstra.RunBounded(nodes[0], -1.0).Count);
+    }
+
+    [Fact]
+    public void RunBounded_RejectsNegativeAndNaNLengths()
+    {
+        // Arrange: path 0 -> 1 -> 2 -> 3 with a negative length on 1 -> 2
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 4).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        var arcs = Enumerable.Range(0, 3).Select(i => graph.AddArc(nodes[i], nodes[i + 1])).ToArray();
+        lengthMap[arcs[0]] = 1.0;
+        lengthMap[arcs[1]] = -0.5;
+        lengthMap[arcs[2]] = 1.0;
+        using var dijkstra = new Dijkstra(graph, lengthMap);
+
+        // Act & Assert: the buffers are not grown and retried
+        Assert.Throws<ArgumentException>(() => dijkstra.RunBounded(nodes[0], 5.0));
+        Assert.Throws<ArgumentException>(() =>
+            dijkstra.TryRunBounded(new[] { nodes[0] }, 5.0, new Node[1], new double[1], new int[1], out _));
+
+        lengthMap[arcs[1]] = double.NaN;
+        Assert.Throws<ArgumentException>(() => dijkstra.RunBounded(nodes[0], 5.0));
+
+        // Arcs beyond the bound are never relaxed
+        Assert.Equal(1, dijkstra.RunBounded(nodes[0], 0.5).Count);
+    }
+}
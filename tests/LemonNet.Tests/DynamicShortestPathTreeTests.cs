@@ -0,0 +1,177 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class DynamicShortestPathTreeTests
+{
+    private readonly ITestOutputHelper output;
+
+    public DynamicShortestPathTreeTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void Diamond_RepairsAfterIncreaseAndDecrease()
+    {
+        // Arrange: 0 -> 1 -> 3 (length 2) and 0 -> 2 -> 3 (length 4), then 3 -> 4
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        var arc01 = graph.AddArc(nodes[0], nodes[1]);
+        var arc13 = graph.AddArc(nodes[1], nodes[3]);
+        var arc02 = graph.AddArc(nodes[0], nodes[2]);
+        var arc23 = graph.AddArc(nodes[2], nodes[3]);
+        var arc34 = graph.AddArc(nodes[3], nodes[4]);
+        lengthMap[arc01] = 1.0;
+        lengthMap[arc13] = 1.0;
+        lengthMap[arc02] = 2.0;
+        lengthMap[arc23] = 2.0;
+        lengthMap[arc34] = 1.0;
+
+        using var tree = new DynamicShortestPathTree(graph, lengthMap, nodes[0]);
+        Assert.Equal(new[] { 0.0, 1.0, 2.0, 2.0, 3.0 }, tree.GetTree().Distances.ToArray());
+
+        // Act & Assert: lengthening 1 -> 3 moves node 3 and its subtree over to 2 -> 3
+        var changed = tree.Update(new[] { arc13 }, new[] { 5.0 });
+        Assert.Equal(new[] { nodes[3], nodes[4] }, changed.OrderBy(n => n.GetHashCode()).ToArray());
+        var snapshot = tree.GetTree();
+        Assert.Equal(4.0, snapshot.Distance(nodes[3]));
+        Assert.Equal(5.0, snapshot.Distance(nodes[4]));
+        Assert.Equal(arc23, snapshot.PredecessorArc(nodes[3]));
+
+        // Lengthening a non-tree arc changes nothing
+        Assert.Empty(tree.Update(new[] { arc13 }, new[] { 6.0 }));
+
+        // Shortening 0 -> 1 below the old route brings node 3 back
+        changed = tree.Update(new[] { arc01, arc13 }, new[] { 0.0, 1.0 });
+        Assert.Equal(new[] { nodes[1], nodes[3], nodes[4] }, changed.OrderBy(n => n.GetHashCode()).ToArray());
+        Assert.Equal(new[] { 0.0, 0.0, 2.0, 1.0, 2.0 }, tree.GetTree().Distances.ToArray());
+
+        Assert.Throws<ArgumentException>(() => tree.Update(new[] { arc01 }, new[] { -1.0 }));
+        Assert.Equal(0.0, tree.GetTree().Distance(nodes[1]));
+    }
+
+    [Theory]
+    [InlineData(true)]
+    [InlineData(false)]
+    public void RandomBatches_MatchDijkstra(bool integerLengths)
+    {
+        // Arrange: small integer lengths, including zero, make ties frequent; fractional
+        // lengths make every shortest path unique, so the tree arcs are fixed too
+        var random = new Random(47);
+        double NextLength() => integerLengths ? random.Next(0, 6) : random.NextDouble() * 5.0;
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 400).Select(_ => graph.AddNode()).ToArray();
+        var arcs = new List<Arc>();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 1600; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            lengthMap[arc] = NextLength();
+            arcs.Add(arc);
+        }
+
+        using var tree = new DynamicShortestPathTree(graph, lengthMap, nodes[0]);
+        using var dijkstra = new Dijkstra(graph, lengthMap);
+        var changedNodes = new Node[graph.NodeCount];
+        int totalChanged = 0;
+
+        for (int step = 0; step < 50; step++)
+        {
+            // Act: a batch of increases and decreases
+            var before = tree.GetTree();
+            int batchSize = 1 + random.Next(step % 2 == 0 ? 3 : 80);
+            var batchArcs = new Arc[batchSize];
+            var batchLengths = new double[batchSize];
+            for (int i = 0; i < batchSize; i++)
+            {
+                batchArcs[i] = arcs[random.Next(arcs.Count)];
+                batchLengths[i] = NextLength();
+                lengthMap[batchArcs[i]] = batchLengths[i];
+            }
+            int changedCount = tree.Update(batchArcs, batchLengths, changedNodes);
+            totalChanged += changedCount;
+
+            // Assert: same distances as a fresh Dijkstra search, and a valid tree
+            var after = tree.GetTree();
+            foreach (var node in nodes)
+            {
+                var expected = dijkstra.Run(nodes[0], node);
+                Assert.Equal(expected.TargetReached, after.Reached(node));
+                var arc = after.PredecessorArc(node);
+                if (node == nodes[0] || !after.Reached(node))
+                {
+                    Assert.Equal(Arc.Invalid, arc);
+                    continue;
+                }
+                Assert.Equal(expected.Distance, after.Distance(node));
+                Assert.Equal(node, graph.Target(arc));
+                Assert.Equal(after.Distance(node), after.Distance(graph.Source(arc)) + lengthMap[arc]);
+                if (!integerLengths)
+                {
+                    Assert.Equal(expected.Path![expected.Path.Length - 1], arc);
+                }
+            }
+
+            // The changed nodes are exactly those with a new distance or tree arc
+            var expectedChanged = nodes.Where(n => before.Distance(n) != after.Distance(n) ||
+                                                   before.PredecessorArc(n) != after.PredecessorArc(n));
+            Assert.Equal(expectedChanged.ToArray(), changedNodes.Take(changedCount).OrderBy(n => n.GetHashCode()).ToArray());
+        }
+
+        output.WriteLine($"{totalChanged} node labels changed over 50 batches");
+    }
+
+    [Fact]
+    public void SaveLoad_RoundTripsTreeAndLengths()
+    {
+        // Arrange
+        var random = new Random(7);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 100).Select(_ => graph.AddNode()).ToArray();
+        var arcs = new List<Arc>();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 400; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            lengthMap[arc] = random.Next(1, 10);
+            arcs.Add(arc);
+        }
+
+        using var tree = new DynamicShortestPathTree(graph, lengthMap, nodes[3]);
+        tree.Update(arcs.Take(20).ToArray(), Enumerable.Repeat(0.5, 20).ToArray());
+
+        // Act
+        using var stream = new MemoryStream();
+        tree.Save(stream);
+        stream.Position = 0;
+        using var loaded = DynamicShortestPathTree.Load(stream, graph);
+
+        // Assert: the loaded tree keeps the updated lengths and repairs like the original
+        Assert.Equal(nodes[3], loaded.Source);
+        Assert.Equal(tree.GetTree().Distances.ToArray(), loaded.GetTree().Distances.ToArray());
+        Assert.Equal(tree.GetTree().PredecessorArcIds.ToArray(), loaded.GetTree().PredecessorArcIds.ToArray());
+        var lengths = new double[graph.ArcCount];
+        loaded.GetLengths(lengths);
+        Assert.Equal(0.5, lengths[arcs[0].GetHashCode()]);
+
+        var batch = arcs.Skip(10).Take(30).ToArray();
+        var batchLengths = batch.Select(_ => (double)random.Next(0, 10)).ToArray();
+        Assert.Equal(tree.Update(batch, batchLengths).OrderBy(n => n.GetHashCode()).ToArray(),
+                     loaded.Update(batch, batchLengths).OrderBy(n => n.GetHashCode()).ToArray());
+        Assert.Equal(tree.GetTree().Distances.ToArray(), loaded.GetTree().Distances.ToArray());
+
+        // A corrupted distance is rejected
+        stream.SetLength(0);
+        tree.Save(stream);
+        var bytes = stream.ToArray();
+        BitConverter.GetBytes(-1.0).CopyTo(bytes, 16 + nodes[3].GetHashCode() * 12);
+        Assert.Throws<InvalidDataException>(() => DynamicShortestPathTree.Load(new MemoryStream(bytes), graph));
+    }
+}
@@ -0,0 +1,138 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class GlobalMinCutTests
+{
+    private readonly ITestOutputHelper output;
+
+    public GlobalMinCutTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void DirectedCycle_FindsWeakestArc()
+    {
+        // Arrange: cycle 0->1->2->3->0 with a strong chord 0->2
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 4).Select(_ => graph.AddNode()).ToArray();
+        using var capacityMap = new ArcMap(graph);
+        capacityMap[graph.AddArc(nodes[0], nodes[1])] = 5;
+        capacityMap[graph.AddArc(nodes[1], nodes[2])] = 6;
+        capacityMap[graph.AddArc(nodes[2], nodes[3])] = 2;
+        capacityMap[graph.AddArc(nodes[3], nodes[0])] = 7;
+        capacityMap[graph.AddArc(nodes[0], nodes[2])] = 10;
+
+        // Act
+        var result = GlobalMinCut.Run(graph, capacityMap);
+
+        // Assert: every minimum cut separates 2 from 3 with only arc 2->3 leaving
+        Assert.Equal(2, result.Value);
+        Assert.True(result.IsOnSourceSide(nodes[2]));
+        Assert.False(result.IsOnSourceSide(nodes[3]));
+        output.WriteLine(result.ToString());
+    }
+
+    [Fact]
+    public void Undirected_IgnoresArcDirections()
+    {
+        // Arrange: two triangles joined by two weak links
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 6).Select(_ => graph.AddNode()).ToArray();
+        using var capacityMap = new ArcMap(graph);
+        capacityMap[graph.AddArc(nodes[0], nodes[1])] = 5;
+        capacityMap[graph.AddArc(nodes[1], nodes[2])] = 5;
+        capacityMap[graph.AddArc(nodes[2], nodes[0])] = 5;
+        capacityMap[graph.AddArc(nodes[3], nodes[4])] = 4;
+        capacityMap[graph.AddArc(nodes[4], nodes[5])] = 4;
+        capacityMap[graph.AddArc(nodes[5], nodes[3])] = 4;
+        capacityMap[graph.AddArc(nodes[2], nodes[3])] = 1;
+        capacityMap[graph.AddArc(nodes[4], nodes[1])] = 2;
+
+        // Act
+        var directed = GlobalMinCut.Run(graph, capacityMap);
+        var undirected = GlobalMinCut.Run(graph, capacityMap, undirected: true);
+
+        // Assert
+        Assert.Equal(1, directed.Value);
+        Assert.Equal(3, undirected.Value);
+        Assert.Equal(3, undirected.SourceSide.Count(inside => inside));
+        Assert.Equal(undirected.SourceSide[0], undirected.SourceSide[2]);
+        Assert.NotEqual(undirected.SourceSide[2], undirected.SourceSide[3]);
+    }
+
+    [Theory]
+    [InlineData(false)]
+    [InlineData(true)]
+    public void RandomNetwork_MatchesAllPairsPreflow(bool undirected)
+    {
+        var random = new Random(23);
+
+        for (int iteration = 0; iteration < 10; iteration++)
+        {
+            // Arrange
+            using var graph = new LemonDigraph();
+            var nodes = Enumerable.Range(0, random.Next(2, 15)).Select(_ => graph.AddNode()).ToArray();
+            using var capacityMap = new ArcMap(graph);
+            var arcs = new List<Arc>();
+            for (int i = 0; i < nodes.Length * 4; i++)
+            {
+                int u = random.Next(nodes.Length);
+                int v = random.Next(nodes.Length);
+                long capacity = random.Next(0, 20);
+                arcs.Add(graph.AddArc(nodes[u], nodes[v]));
+                capacityMap[arcs[^1]] = capacity;
+                if (undirected)
+                {
+                    // Symmetric arcs, so directed max flows give the undirected cuts
+                    arcs.Add(graph.AddArc(nodes[v], nodes[u]));
+                    capacityMap[arcs[^1]] = capacity;
+                }
+            }
+
+            // Act
+            var result = GlobalMinCut.Run(graph, capacityMap, undirected);
+
+            // Assert
+            long expected = long.MaxValue;
+            using var preflow = new Preflow(graph, capacityMap);
+            for (int t = 1; t < nodes.Length; t++)
+            {
+                expected = Math.Min(expected, preflow.Run(nodes[0], nodes[t]).MaxFlowValue);
+                expected = Math.Min(expected, preflow.Run(nodes[t], nodes[0]).MaxFlowValue);
+            }
+
+            long leaving = 0;
+            foreach (var arc in arcs)
+            {
+                if (result.IsOnSourceSide(graph.Source(arc)) && !result.IsOnSourceSide(graph.Target(arc)))
+                {
+                    leaving += capacityMap[arc];
+                }
+            }
+
+            // Undirected cuts count both arcs of every symmetric pair
+            Assert.Equal(undirected ? 2 * expected : expected, result.Value);
+            Assert.Equal(expected, leaving);
+            Assert.Contains(result.SourceSide, inside => inside);
+            Assert.Contains(result.SourceSide, inside => !inside);
+        }
+    }
+
+    [Fact]
+    public void SingleNode_Throws()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        graph.AddNode();
+        using var capacityMap = new ArcMap(graph);
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => GlobalMinCut.Run(graph, capacityMap));
+    }
+}
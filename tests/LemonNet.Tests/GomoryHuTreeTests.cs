@@ -0,0 +1,119 @@
+using System;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class GomoryHuTreeTests
+{
+    private readonly ITestOutputHelper output;
+
+    public GomoryHuTreeTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void SmallNetwork_ReturnsPairwiseMinCuts()
+    {
+        // Arrange: two triangles joined by a single weak link 2-3
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 6).Select(_ => graph.AddNode()).ToArray();
+        using var capacityMap = new ArcMap(graph);
+        capacityMap[graph.AddArc(nodes[0], nodes[1])] = 5;
+        capacityMap[graph.AddArc(nodes[1], nodes[2])] = 5;
+        capacityMap[graph.AddArc(nodes[2], nodes[0])] = 5;
+        capacityMap[graph.AddArc(nodes[3], nodes[4])] = 4;
+        capacityMap[graph.AddArc(nodes[4], nodes[5])] = 4;
+        capacityMap[graph.AddArc(nodes[5], nodes[3])] = 4;
+        var link = graph.AddArc(nodes[2], nodes[3]);
+        capacityMap[link] = 2;
+
+        // Act
+        using var tree = GomoryHuTree.Build(graph, capacityMap);
+
+        // Assert
+        Assert.Equal(10, tree.MinCutValue(nodes[0], nodes[1]));
+        Assert.Equal(8, tree.MinCutValue(nodes[4], nodes[3]));
+        Assert.Equal(2, tree.MinCutValue(nodes[0], nodes[5]));
+        Assert.Equal(new[] { link }, tree.MinCutEdges(nodes[1], nodes[4]).ToArray());
+
+        var side = tree.MinCutNodes(nodes[1], nodes[4]);
+        Assert.Equal(new[] { true, true, true, false, false, false }, side);
+        output.WriteLine($"Cut between 1 and 4: {tree.MinCutValue(nodes[1], nodes[4])}");
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(4)]
+    public void RandomNetwork_MatchesPreflow(int threadCount)
+    {
+        // Arrange
+        var random = new Random(19);
+        using var graph = new LemonDigraph();
+        using var bidirected = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 25).Select(_ => graph.AddNode()).ToArray();
+        var bidirectedNodes = Enumerable.Range(0, 25).Select(_ => bidirected.AddNode()).ToArray();
+        using var capacityMap = new ArcMap(graph);
+        using var bidirectedCapacity = new ArcMap(bidirected);
+
+        for (int i = 0; i < 80; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            long capacity = random.Next(1, 20);
+            capacityMap[graph.AddArc(nodes[u], nodes[v])] = capacity;
+            bidirectedCapacity[bidirected.AddArc(bidirectedNodes[u], bidirectedNodes[v])] = capacity;
+            bidirectedCapacity[bidirected.AddArc(bidirectedNodes[v], bidirectedNodes[u])] = capacity;
+        }
+
+        // Act
+        using var tree = GomoryHuTree.Build(graph, capacityMap, threadCount);
+        using var preflow = new Preflow(bidirected, bidirectedCapacity);
+
+        // Assert
+        for (int u = 0; u < nodes.Length; u++)
+        {
+            for (int v = u + 1; v < nodes.Length; v++)
+            {
+                long expected = preflow.Run(bidirectedNodes[u], bidirectedNodes[v]).MaxFlowValue;
+                Assert.Equal(expected, tree.MinCutValue(nodes[u], nodes[v]));
+                Assert.Equal(expected, tree.MinCutEdges(nodes[u], nodes[v]).Sum(a => capacityMap[a]));
+            }
+        }
+    }
+
+    [Fact]
+    public void SaveAndLoad_RoundTrips()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        using var capacityMap = new ArcMap(graph);
+        for (int i = 0; i < nodes.Length; i++)
+        {
+            capacityMap[graph.AddArc(nodes[i], nodes[(i + 1) % nodes.Length])] = i + 1;
+        }
+
+        using var tree = GomoryHuTree.Build(graph, capacityMap);
+        using var stream = new MemoryStream();
+
+        // Act
+        tree.Save(stream);
+        stream.Position = 0;
+        using var loaded = GomoryHuTree.Load(stream, graph);
+
+        // Assert
+        for (int u = 0; u < nodes.Length; u++)
+        {
+            for (int v = 0; v < nodes.Length; v++)
+            {
+                if (u == v) continue;
+                Assert.Equal(tree.MinCutValue(nodes[u], nodes[v]), loaded.MinCutValue(nodes[u], nodes[v]));
+            }
+        }
+        Assert.Equal(4, loaded.MinCutValue(nodes[0], nodes[2]));
+    }
+}
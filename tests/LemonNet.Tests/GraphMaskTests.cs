@@ -0,0 +1,148 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class GraphMaskTests
+{
+    private readonly ITestOutputHelper output;
+
+    public GraphMaskTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void MaxFlow_SkipsDisabledArcsAndNodes()
+    {
+        // Arrange: 0 -> 1 -> 3 and 0 -> 2 -> 3, capacities 5 and 3
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 4).Select(_ => graph.AddNode()).ToArray();
+        var arc01 = graph.AddArc(nodes[0], nodes[1]);
+        var arc13 = graph.AddArc(nodes[1], nodes[3]);
+        var arc02 = graph.AddArc(nodes[0], nodes[2]);
+        var arc23 = graph.AddArc(nodes[2], nodes[3]);
+        using var preflow = new Preflow(graph);
+        preflow.SetCapacity(arc01, 5).SetCapacity(arc13, 5).SetCapacity(arc02, 3).SetCapacity(arc23, 3);
+        using var edmondsKarp = new EdmondsKarp(graph, preflow.CapacityMap);
+        var mask = new GraphMask(graph);
+
+        // Act & Assert
+        Assert.Equal(8, preflow.Run(nodes[0], nodes[3], mask).MaxFlowValue);
+
+        mask.Disable(arc13);
+        var result = preflow.Run(nodes[0], nodes[3], mask);
+        Assert.Equal(3, result.MaxFlowValue);
+        Assert.False(result.EdgeFlows.Any(f => f.Arc == arc01 || f.Arc == arc13));
+        Assert.Equal(3, edmondsKarp.Run(nodes[0], nodes[3], mask).MaxFlowValue);
+
+        mask.EnableAll();
+        mask.Disable(nodes[2]);
+        Assert.False(mask.IsEnabled(nodes[2]));
+        Assert.True(mask.IsEnabled(arc23));
+        Assert.Equal(5, edmondsKarp.Run(nodes[0], nodes[3], mask).MaxFlowValue);
+
+        mask.Disable(nodes[3]);
+        Assert.Equal(0, preflow.Run(nodes[0], nodes[3], mask).MaxFlowValue);
+        Assert.Empty(preflow.Run(nodes[0], nodes[3], mask).EdgeFlows);
+
+        // The graph itself is unchanged
+        Assert.Equal(8, preflow.Run(nodes[0], nodes[3]).MaxFlowValue);
+    }
+
+    [Theory]
+    [InlineData(BellmanFordMode.Rounds)]
+    [InlineData(BellmanFordMode.Queue)]
+    [InlineData(BellmanFordMode.EdgeList)]
+    public void ShortestPaths_MatchRebuiltGraph(BellmanFordMode mode)
+    {
+        var random = new Random(49);
+        for (int scenario = 0; scenario < 40; scenario++)
+        {
+            // Arrange: a random graph and a copy without the failed arcs and nodes
+            using var graph = new LemonDigraph();
+            using var copy = new LemonDigraph();
+            var nodes = Enumerable.Range(0, 40).Select(_ => graph.AddNode()).ToArray();
+            var copyNodes = nodes.Select(_ => copy.AddNode()).ToArray();
+            using var lengths = new ArcMapDouble(graph);
+            using var copyLengths = new ArcMapDouble(copy);
+            var endpoints = new (int U, int V)[160];
+            var arcs = new Arc[endpoints.Length];
+            for (int i = 0; i < arcs.Length; i++)
+            {
+                endpoints[i] = (random.Next(nodes.Length), random.Next(nodes.Length));
+                arcs[i] = graph.AddArc(nodes[endpoints[i].U], nodes[endpoints[i].V]);
+                lengths[arcs[i]] = random.Next(0, 10);
+            }
+
+            var mask = new GraphMask(graph);
+            for (int i = 1; i < nodes.Length; i++)
+            {
+                if (random.Next(8) == 0) mask.Disable(nodes[i]);
+            }
+            for (int i = 0; i < arcs.Length; i++)
+            {
+                var (u, v) = endpoints[i];
+                mask.SetEnabled(arcs[i], random.Next(4) != 0);
+                if (mask.IsEnabled(arcs[i]) && mask.IsEnabled(nodes[u]) && mask.IsEnabled(nodes[v]))
+                {
+                    copyLengths[copy.AddArc(copyNodes[u], copyNodes[v])] = lengths[arcs[i]];
+                }
+            }
+            int target = 1 + random.Next(nodes.Length - 1);
+
+            using var dijkstra = new Dijkstra(graph, lengths);
+            using var bellmanFord = new BellmanFord(graph, lengths) { Mode = mode, ThreadCount = 2 };
+            using var copyDijkstra = new Dijkstra(copy, copyLengths);
+
+            // Act
+            var masked = dijkstra.Run(nodes[0], nodes[target], mask);
+            var maskedBellmanFord = bellmanFord.Run(nodes[0], nodes[target], mask);
+            var rebuilt = copyDijkstra.Run(copyNodes[0], copyNodes[target]);
+
+            // Assert: same distances, and paths only over enabled arcs
+            bool reachable = rebuilt.TargetReached && mask.IsEnabled(nodes[target]);
+            Assert.Equal(reachable, masked.TargetReached);
+            Assert.Equal(reachable, maskedBellmanFord.TargetReached);
+            if (reachable)
+            {
+                Assert.Equal(rebuilt.Distance, masked.Distance);
+                Assert.Equal(rebuilt.Distance, maskedBellmanFord.Distance);
+                Assert.True(masked.Path!.All(arc => mask.IsEnabled(arc)));
+                Assert.True(maskedBellmanFord.Path!.All(arc => mask.IsEnabled(arc)));
+            }
+        }
+    }
+
+    [Fact]
+    public void BellmanFord_DisabledArcBreaksNegativeCycle()
+    {
+        // Arrange: 0 -> 1 -> 2 -> 1 with the cycle 1 -> 2 -> 1 of length -1
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 3).Select(_ => graph.AddNode()).ToArray();
+        using var lengths = new ArcMapDouble(graph);
+        lengths[graph.AddArc(nodes[0], nodes[1])] = 1.0;
+        var arc12 = graph.AddArc(nodes[1], nodes[2]);
+        lengths[arc12] = 1.0;
+        var arc21 = graph.AddArc(nodes[2], nodes[1]);
+        lengths[arc21] = -2.0;
+        using var bellmanFord = new BellmanFord(graph, lengths);
+        var mask = new GraphMask(graph);
+
+        // Act & Assert
+        Assert.True(bellmanFord.Run(nodes[0], nodes[2], mask).HasNegativeCycle);
+
+        mask.Disable(arc21);
+        var result = bellmanFord.Run(nodes[0], nodes[2], mask);
+        Assert.False(result.HasNegativeCycle);
+        Assert.Equal(2.0, result.Distance);
+
+        // A mask built before the graph grew does not cover it
+        var arc20 = graph.AddArc(nodes[2], nodes[0]);
+        Assert.Throws<ArgumentException>(() => bellmanFord.Run(nodes[0], nodes[2], mask));
+        Assert.Throws<ArgumentException>(() => mask.Disable(arc20));
+        output.WriteLine($"Mask covers {mask.NodeCount} nodes and {mask.ArcCount} arcs");
+    }
+}
@@ -0,0 +1,197 @@
+using System;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class JohnsonTests
+{
+    private readonly ITestOutputHelper output;
+
+    public JohnsonTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void NegativeArcs_ComputesAllPairs()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc23 = graph.AddArc(node2, node3);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 4.0;
+        lengthMap[arc12] = -3.0;
+        lengthMap[arc02] = 2.0;
+        lengthMap[arc23] = 1.0;
+
+        using var johnson = new Johnson(graph, lengthMap);
+        var matrix = new double[16];
+
+        // Act
+        johnson.Run(matrix);
+
+        // Assert
+        Assert.False(johnson.HasNegativeCycle);
+        Assert.Equal(0.0, matrix[0 * 4 + 0]);
+        Assert.Equal(4.0, matrix[0 * 4 + 1]);
+        Assert.Equal(1.0, matrix[0 * 4 + 2]);
+        Assert.Equal(2.0, matrix[0 * 4 + 3]);
+        Assert.Equal(-2.0, matrix[1 * 4 + 3]);
+        Assert.True(double.IsPositiveInfinity(matrix[3 * 4 + 0]));
+        output.WriteLine($"Row 0: {string.Join(", ", matrix.Take(4))}");
+    }
+
+    [Fact]
+    public void NegativeCycle_IsDetected()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc10 = graph.AddArc(node1, node0);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 1.0;
+        lengthMap[arc10] = -2.0;
+
+        using var johnson = new Johnson(graph, lengthMap);
+
+        // Act & Assert
+        Assert.True(johnson.HasNegativeCycle);
+        Assert.Throws<InvalidOperationException>(() => johnson.Run(new double[4]));
+    }
+
+    [Fact]
+    public void RandomGraph_MatchesBellmanFord()
+    {
+        // Arrange: potential-shifted lengths are negative on many arcs but no cycle is negative
+        var random = new Random(17);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 60).Select(_ => graph.AddNode()).ToArray();
+        var potential = nodes.Select(_ => random.Next(0, 50)).ToArray();
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 400; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            var arc = graph.AddArc(nodes[u], nodes[v]);
+            lengthMap[arc] = random.Next(0, 30) + potential[u] - potential[v];
+        }
+
+        using var johnson = new Johnson(graph, lengthMap) { ThreadCount = 4 };
+        using var bellmanFord = new BellmanFord(graph, lengthMap);
+        var matrix = new double[nodes.Length * nodes.Length];
+
+        // Act
+        johnson.Run(matrix);
+
+        // Assert
+        for (int s = 0; s < nodes.Length; s++)
+        {
+            for (int t = 0; t < nodes.Length; t++)
+            {
+                double expected = bellmanFord.FindDistance(nodes[s], nodes[t]);
+                Assert.Equal(expected, matrix[s * nodes.Length + t], 9);
+            }
+        }
+    }
+
+    [Fact]
+    public void RowBatchesAndFile_MatchFullMatrix()
+    {
+        // Arrange
+        var random = new Random(5);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 40).Select(_ => graph.AddNode()).ToArray();
+
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 200; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            var arc = graph.AddArc(nodes[u], nodes[v]);
+            lengthMap[arc] = random.Next(0, 20) + u - v;
+        }
+
+        using var johnson = new Johnson(graph, lengthMap);
+        Assert.False(johnson.HasNegativeCycle);
+
+        var matrix = new double[nodes.Length * nodes.Length];
+        johnson.Run(matrix);
+
+        string path = System.IO.Path.GetTempFileName();
+        try
+        {
+            // Act
+            var rows = new double[3 * nodes.Length];
+            johnson.Run(new[] { nodes[7], nodes[0], nodes[39] }, rows);
+            johnson.RunToFile(path, rowsPerBatch: 16);
+            byte[] bytes = File.ReadAllBytes(path);
+
+            // Assert
+            Assert.Equal(matrix.AsSpan(7 * nodes.Length, nodes.Length).ToArray(), rows.AsSpan(0, nodes.Length).ToArray());
+            Assert.Equal(matrix.AsSpan(0, nodes.Length).ToArray(), rows.AsSpan(nodes.Length, nodes.Length).ToArray());
+            Assert.Equal(matrix.AsSpan(39 * nodes.Length, nodes.Length).ToArray(), rows.AsSpan(2 * nodes.Length).ToArray());
+
+            Assert.Equal(matrix.Length * sizeof(double), bytes.Length);
+            for (int i = 0; i < matrix.Length; i++)
+            {
+                Assert.Equal(matrix[i], BitConverter.ToDouble(bytes, i * sizeof(double)));
+            }
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Fact]
+    public void GraphGrowth_RecomputesPotentials()
+    {
+        // Arrange: potentials cached for two nodes
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[graph.AddArc(node0, node1)] = 1.0;
+        using var johnson = new Johnson(graph, lengthMap);
+        Assert.Equal(2, johnson.Potentials.Length);
+
+        // Act: grow the graph by a negative arc into a long chain
+        var previous = node1;
+        for (int i = 0; i < 2000; i++)
+        {
+            var node = graph.AddNode();
+            lengthMap[graph.AddArc(previous, node)] = i == 0 ? -3.0 : 1.0;
+            previous = node;
+        }
+        var row = new double[graph.NodeCount];
+        johnson.Run(new[] { node0 }, row);
+
+        // Assert
+        Assert.Equal(graph.NodeCount, johnson.Potentials.Length);
+        Assert.Equal(-2.0, row[2]);
+        Assert.Equal(1997.0, row[graph.NodeCount - 1]);
+
+        // An empty graph has an empty matrix
+        using var empty = new LemonDigraph();
+        using var emptyLengths = new ArcMapDouble(empty);
+        using var emptyJohnson = new Johnson(empty, emptyLengths);
+        emptyJohnson.Run(Span<double>.Empty);
+    }
+}
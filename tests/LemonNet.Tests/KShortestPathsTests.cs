@@ -0,0 +1,137 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class KShortestPathsTests
+{
+    private readonly ITestOutputHelper output;
+
+    public KShortestPathsTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void SmallGraph_ReturnsPathsInOrder()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc13 = graph.AddArc(node1, node3);
+        var arc23 = graph.AddArc(node2, node3);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 1.0;
+        lengthMap[arc02] = 3.0;
+        lengthMap[arc12] = 1.0;
+        lengthMap[arc13] = 4.0;
+        lengthMap[arc23] = 1.0;
+
+        using var kShortestPaths = new KShortestPaths(graph, lengthMap);
+
+        // Act
+        var paths = kShortestPaths.Run(node0, node3, 10);
+
+        // Assert: 0-1-2-3 (3), 0-2-3 (4), 0-1-3 (5)
+        Assert.Equal(3, paths.Count);
+        Assert.Equal(new[] { 3.0, 4.0, 5.0 }, paths.Select(p => p.Distance).ToArray());
+        Assert.Equal(new[] { arc01, arc12, arc23 }, paths[0].Path!.ToArray());
+        Assert.Equal(new[] { arc02, arc23 }, paths[1].Path!.ToArray());
+        Assert.Equal(new[] { arc01, arc13 }, paths[2].Path!.ToArray());
+        foreach (var path in paths)
+        {
+            output.WriteLine(path.ToString());
+        }
+    }
+
+    [Fact]
+    public void UnreachableTarget_ReturnsNoPaths()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        graph.AddArc(node1, node0);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        using var kShortestPaths = new KShortestPaths(graph, lengthMap);
+
+        // Act & Assert
+        Assert.Empty(kShortestPaths.Run(node0, node1, 5));
+    }
+
+    [Fact]
+    public void RandomGraphs_MatchEnumeratedSimplePaths()
+    {
+        var random = new Random(31);
+
+        for (int iteration = 0; iteration < 40; iteration++)
+        {
+            // Arrange
+            using var graph = new LemonDigraph();
+            int nodeCount = random.Next(3, 9);
+            var nodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+            using var lengthMap = new ArcMapDouble(graph);
+
+            var adjacency = nodes.Select(_ => new List<(int Target, Arc Arc)>()).ToArray();
+            for (int i = 0; i < nodeCount * 3; i++)
+            {
+                int u = random.Next(nodeCount);
+                int v = random.Next(nodeCount);
+                var arc = graph.AddArc(nodes[u], nodes[v]);
+                lengthMap[arc] = random.Next(0, 6);
+                adjacency[u].Add((v, arc));
+            }
+
+            var expected = new List<double>();
+            EnumerateSimplePaths(adjacency, lengthMap, 0, nodeCount - 1, new bool[nodeCount], 0.0, expected);
+            expected.Sort();
+
+            int k = random.Next(1, 12);
+            using var kShortestPaths = new KShortestPaths(graph, lengthMap);
+
+            // Act
+            var paths = kShortestPaths.Run(nodes[0], nodes[nodeCount - 1], k);
+
+            // Assert
+            Assert.Equal(expected.Take(k).ToArray(), paths.Select(p => p.Distance).ToArray());
+            foreach (var path in paths)
+            {
+                Assert.Equal(path.Distance, path.Path!.GetTotalCost(lengthMap));
+                var visited = path.Path.GetNodes().ToArray();
+                Assert.Equal(visited.Length, visited.Distinct().Count());
+            }
+        }
+    }
+
+    private static void EnumerateSimplePaths(List<(int Target, Arc Arc)>[] adjacency, ArcMapDouble lengthMap,
+                                             int node, int target, bool[] onPath, double cost, List<double> costs)
+    {
+        if (node == target)
+        {
+            costs.Add(cost);
+            return;
+        }
+
+        onPath[node] = true;
+        foreach (var (next, arc) in adjacency[node])
+        {
+            if (!onPath[next])
+            {
+                EnumerateSimplePaths(adjacency, lengthMap, next, target, onPath, cost + lengthMap[arc], costs);
+            }
+        }
+        onPath[node] = false;
+    }
+}
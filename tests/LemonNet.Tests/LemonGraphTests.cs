@@ -0,0 +1,138 @@
+using System;
+using Xunit;
+using Xunit.Abstractions;
+using LemonNet;
+
+namespace LemonNet.Tests;
+
+public class LemonGraphTests : IDisposable
+{
+    private readonly ITestOutputHelper output;
+    private LemonGraph graph;
+
+    public LemonGraphTests(ITestOutputHelper output)
+    {
+        this.output = output;
+        this.graph = new LemonGraph();
+    }
+
+    public void Dispose()
+    {
+        graph?.Dispose();
+    }
+
+    [Fact]
+    public void AddEdge_ValidNodes_ReturnsValidEdge()
+    {
+        // Arrange
+        var u = graph.AddNode();
+        var v = graph.AddNode();
+
+        // Act
+        var edge = graph.AddEdge(u, v);
+
+        // Assert
+        Assert.True(edge.IsValid);
+        Assert.Equal(1, graph.EdgeCount);
+        Assert.Equal(u, graph.U(edge));
+        Assert.Equal(v, graph.V(edge));
+    }
+
+    [Fact]
+    public void AddEdges_Bulk_AddsEdgesInOrder()
+    {
+        // Arrange
+        var nodes = new Node[4];
+        graph.AddNodes(nodes);
+        var u = new[] { nodes[0], nodes[1], nodes[2], nodes[3] };
+        var v = new[] { nodes[1], nodes[2], nodes[3], nodes[0] };
+        var edges = new Edge[4];
+
+        // Act
+        graph.AddEdges(u, v, edges);
+
+        // Assert
+        Assert.Equal(4, graph.NodeCount);
+        Assert.Equal(4, graph.EdgeCount);
+        for (int i = 0; i < edges.Length; i++)
+        {
+            Assert.Equal(u[i], graph.U(edges[i]));
+            Assert.Equal(v[i], graph.V(edges[i]));
+        }
+    }
+
+    [Fact]
+    public void AddEdges_InvalidNode_AddsNothing()
+    {
+        // Arrange
+        var nodes = new Node[2];
+        graph.AddNodes(nodes);
+        var u = new[] { nodes[0], nodes[1] };
+        var v = new[] { nodes[1], Node.Invalid };
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => graph.AddEdges(u, v));
+        Assert.Equal(0, graph.EdgeCount);
+    }
+
+    [Fact]
+    public void EdgeMaps_SpanAccess_RoundTrips()
+    {
+        // Arrange
+        var nodes = new Node[5];
+        graph.AddNodes(nodes);
+        var edges = new Edge[4];
+        graph.AddEdges(nodes.AsSpan(0, 4), nodes.AsSpan(1, 4), edges);
+        using var capacityMap = new EdgeMap(graph);
+        using var lengthMap = new EdgeMapDouble(graph);
+
+        // Act
+        capacityMap.SetValues(new long[] { 10, 20, 30, 40 });
+        lengthMap[edges[2]] = 2.5;
+        lengthMap.SetValues(new[] { 7.5 }, edges[3]);
+        var capacities = new long[3];
+        capacityMap.CopyTo(capacities, edges[1]);
+        var lengths = new double[4];
+        lengthMap.CopyTo(lengths);
+
+        // Assert
+        Assert.Equal(30, capacityMap[edges[2]]);
+        Assert.Equal(new long[] { 20, 30, 40 }, capacities);
+        Assert.Equal(new[] { 0.0, 0.0, 2.5, 7.5 }, lengths);
+        Assert.Throws<ArgumentException>(() => capacityMap.CopyTo(new long[2], edges[3]));
+    }
+
+    [Fact]
+    public void GlobalMinCut_MatchesDigraphUndirectedMode()
+    {
+        // Arrange: a 6-cycle with one weak edge and a heavy chord
+        using var digraph = new LemonDigraph();
+        using var arcCapacity = new ArcMap(digraph);
+        var nodes = new Node[6];
+        graph.AddNodes(nodes);
+        var digraphNodes = new Node[6];
+        for (int i = 0; i < 6; i++)
+        {
+            digraphNodes[i] = digraph.AddNode();
+        }
+
+        using var capacityMap = new EdgeMap(graph);
+        long[] capacities = { 4, 4, 1, 4, 4, 3, 9 };
+        int[] us = { 0, 1, 2, 3, 4, 5, 0 };
+        int[] vs = { 1, 2, 3, 4, 5, 0, 3 };
+        for (int i = 0; i < us.Length; i++)
+        {
+            capacityMap[graph.AddEdge(nodes[us[i]], nodes[vs[i]])] = capacities[i];
+            arcCapacity[digraph.AddArc(digraphNodes[us[i]], digraphNodes[vs[i]])] = capacities[i];
+        }
+
+        // Act
+        var result = GlobalMinCut.Run(graph, capacityMap);
+        var expected = GlobalMinCut.Run(digraph, arcCapacity, undirected: true);
+
+        // Assert
+        Assert.Equal(expected.Value, result.Value);
+        Assert.Equal(5, result.Value);
+        output.WriteLine(result.ToString());
+    }
+}
@@ -0,0 +1,181 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class MaxWeightedMatchingTests
+{
+    private readonly ITestOutputHelper output;
+
+    public MaxWeightedMatchingTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void Path_PrefersHeavierOuterEdges()
+    {
+        // Arrange: path 0-1-2-3 with weights 3, 4, 3
+        using var graph = new LemonGraph();
+        var nodes = new Node[4];
+        graph.AddNodes(nodes);
+        using var weightMap = new EdgeMap(graph);
+        weightMap[graph.AddEdge(nodes[0], nodes[1])] = 3;
+        weightMap[graph.AddEdge(nodes[1], nodes[2])] = 4;
+        weightMap[graph.AddEdge(nodes[2], nodes[3])] = 3;
+
+        using var matching = new MaxWeightedMatching(graph, weightMap);
+
+        // Act
+        var result = matching.Run();
+
+        // Assert
+        Assert.Equal(6, result.Weight);
+        Assert.Equal(nodes[1], result.Mate(nodes[0]));
+        Assert.Equal(nodes[2], result.Mate(nodes[3]));
+        output.WriteLine(result.ToString());
+    }
+
+    [Fact]
+    public void WeightChange_ReSolvesWithSameInstance()
+    {
+        // Arrange
+        using var graph = new LemonGraph();
+        var nodes = new Node[4];
+        graph.AddNodes(nodes);
+        using var weightMap = new EdgeMap(graph);
+        var edges = new Edge[3];
+        graph.AddEdges(nodes.AsSpan(0, 3), nodes.AsSpan(1, 3), edges);
+        weightMap.SetValues(new long[] { 3, 4, 3 });
+
+        using var matching = new MaxWeightedMatching(graph, weightMap);
+        var mates = new Node[4];
+
+        // Act
+        long before = matching.Run(mates);
+        weightMap[edges[1]] = 10;
+        long after = matching.Run(mates);
+
+        // Assert
+        Assert.Equal(6, before);
+        Assert.Equal(10, after);
+        Assert.Equal(Node.Invalid, mates[0]);
+        Assert.Equal(nodes[2], mates[1]);
+    }
+
+    [Fact]
+    public void Perfect_OddNodeCount_ReturnsNull()
+    {
+        // Arrange: a triangle has no perfect matching
+        using var graph = new LemonGraph();
+        var nodes = new Node[3];
+        graph.AddNodes(nodes);
+        using var weightMap = new EdgeMap(graph);
+        graph.AddEdges(nodes, new[] { nodes[1], nodes[2], nodes[0] });
+        weightMap.SetValues(new long[] { 1, 1, 1 });
+
+        using var matching = new MaxWeightedPerfectMatching(graph, weightMap);
+
+        // Act & Assert
+        Assert.Null(matching.Run());
+    }
+
+    [Theory]
+    [InlineData(true)]
+    [InlineData(false)]
+    public void RandomGraphs_MatchBruteForce(bool jumpstart)
+    {
+        var random = new Random(47);
+
+        for (int iteration = 0; iteration < 30; iteration++)
+        {
+            // Arrange
+            using var graph = new LemonGraph();
+            var nodes = new Node[random.Next(2, 9)];
+            graph.AddNodes(nodes);
+            int edgeCount = random.Next(1, nodes.Length * 2);
+            var us = new Node[edgeCount];
+            var vs = new Node[edgeCount];
+            for (int i = 0; i < edgeCount; i++)
+            {
+                us[i] = nodes[random.Next(nodes.Length)];
+                vs[i] = nodes[random.Next(nodes.Length)];
+            }
+            graph.AddEdges(us, vs);
+
+            using var weightMap = new EdgeMap(graph);
+            var weights = Enumerable.Range(0, edgeCount).Select(_ => (long)random.Next(-5, 20)).ToArray();
+            weightMap.SetValues(weights);
+
+            var endpoints = us.Zip(vs, (u, v) => (U: NodeIndex(nodes, u), V: NodeIndex(nodes, v))).ToArray();
+            var (bestAny, bestPerfect) = BruteForce(endpoints, weights, new bool[nodes.Length], 0);
+
+            using var matching = new MaxWeightedMatching(graph, weightMap) { Jumpstart = jumpstart };
+            using var perfectMatching = new MaxWeightedPerfectMatching(graph, weightMap) { Jumpstart = jumpstart };
+
+            // Act
+            var result = matching.Run();
+            var perfectResult = perfectMatching.Run();
+
+            // Assert
+            Assert.Equal(bestAny, result.Weight);
+            AssertConsistent(result, nodes);
+            if (bestPerfect == long.MinValue)
+            {
+                Assert.Null(perfectResult);
+            }
+            else
+            {
+                Assert.NotNull(perfectResult);
+                Assert.Equal(bestPerfect, perfectResult!.Weight);
+                Assert.All(perfectResult.Mates, mate => Assert.True(mate.IsValid));
+                AssertConsistent(perfectResult, nodes);
+            }
+        }
+    }
+
+    private static int NodeIndex(Node[] nodes, Node node) => Array.IndexOf(nodes, node);
+
+    private static void AssertConsistent(MatchingResult result, Node[] nodes)
+    {
+        foreach (var node in nodes)
+        {
+            var mate = result.Mate(node);
+            if (mate.IsValid)
+            {
+                Assert.Equal(node, result.Mate(mate));
+            }
+        }
+    }
+
+    // Best weight of any matching and of a perfect matching (long.MinValue if none)
+    // using the edges from index 'next' on, given the already matched nodes
+    private static (long Any, long Perfect) BruteForce((int U, int V)[] edges, long[] weights,
+                                                      bool[] matched, int next)
+    {
+        if (next == edges.Length)
+        {
+            return (0, matched.All(m => m) ? 0 : long.MinValue);
+        }
+
+        var (bestAny, bestPerfect) = BruteForce(edges, weights, matched, next + 1);
+
+        var (u, v) = edges[next];
+        if (u != v && !matched[u] && !matched[v])
+        {
+            matched[u] = matched[v] = true;
+            var (any, perfect) = BruteForce(edges, weights, matched, next + 1);
+            matched[u] = matched[v] = false;
+
+            bestAny = Math.Max(bestAny, any + weights[next]);
+            if (perfect != long.MinValue)
+            {
+                bestPerfect = Math.Max(bestPerfect, perfect + weights[next]);
+            }
+        }
+
+        return (bestAny, bestPerfect);
+    }
+}
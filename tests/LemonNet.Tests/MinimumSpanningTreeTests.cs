@@ -0,0 +1,158 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class MinimumSpanningTreeTests
+{
+    private readonly ITestOutputHelper output;
+
+    public MinimumSpanningTreeTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Theory]
+    [InlineData(SpanningTreeAlgorithm.Kruskal)]
+    [InlineData(SpanningTreeAlgorithm.Boruvka)]
+    public void SmallGraph_SelectsLightestTree(SpanningTreeAlgorithm algorithm)
+    {
+        // Arrange: a square 0-1-2-3 with a heavy diagonal
+        using var graph = new LemonGraph();
+        var nodes = Enumerable.Range(0, 4).Select(_ => graph.AddNode()).ToArray();
+        using var weightMap = new EdgeMap(graph);
+        var edge01 = graph.AddEdge(nodes[0], nodes[1]);
+        var edge12 = graph.AddEdge(nodes[1], nodes[2]);
+        var edge23 = graph.AddEdge(nodes[2], nodes[3]);
+        var edge30 = graph.AddEdge(nodes[3], nodes[0]);
+        var edge02 = graph.AddEdge(nodes[0], nodes[2]);
+        weightMap[edge01] = 1;
+        weightMap[edge12] = 2;
+        weightMap[edge23] = 3;
+        weightMap[edge30] = 4;
+        weightMap[edge02] = 5;
+
+        var forest = new Edge[graph.NodeCount - 1];
+
+        // Act
+        int count = MinimumSpanningTree.Run(graph, weightMap, forest, out long totalWeight, algorithm, 2);
+
+        // Assert
+        Assert.Equal(3, count);
+        Assert.Equal(6, totalWeight);
+        Assert.Equal(new[] { edge01, edge12, edge23 }, forest.OrderBy(e => weightMap[e]).ToArray());
+        output.WriteLine($"{algorithm}: {totalWeight}");
+    }
+
+    [Fact]
+    public void RandomGraphs_KruskalAndBoruvkaAgree()
+    {
+        var random = new Random(53);
+
+        for (int iteration = 0; iteration < 30; iteration++)
+        {
+            // Arrange: small integer weights produce many ties
+            using var graph = new LemonGraph();
+            int nodeCount = random.Next(1, 60);
+            var nodes = new Node[nodeCount];
+            graph.AddNodes(nodes);
+            using var weightMap = new EdgeMapDouble(graph);
+            var endpoints = new List<(int U, int V)>();
+            int edgeCount = random.Next(0, 150);
+            for (int i = 0; i < edgeCount; i++)
+            {
+                int u = random.Next(nodeCount);
+                int v = random.Next(nodeCount);
+                weightMap[graph.AddEdge(nodes[u], nodes[v])] = random.Next(-5, 6) * 0.5;
+                endpoints.Add((u, v));
+            }
+
+            var kruskal = new Edge[nodeCount];
+            var boruvka = new Edge[nodeCount];
+
+            // Act
+            int kruskalCount = MinimumSpanningTree.Run(graph, weightMap, kruskal, out double kruskalWeight,
+                                                       SpanningTreeAlgorithm.Kruskal);
+            int boruvkaCount = MinimumSpanningTree.Run(graph, weightMap, boruvka, out double boruvkaWeight,
+                                                       SpanningTreeAlgorithm.Boruvka, 4);
+
+            // Assert: one edge fewer than nodes per connected component
+            Assert.Equal(nodeCount - CountComponents(nodeCount, endpoints), kruskalCount);
+            Assert.Equal(kruskalCount, boruvkaCount);
+            Assert.Equal(kruskalWeight, boruvkaWeight);
+            Assert.Equal(kruskal.Take(kruskalCount).OrderBy(e => e.GetHashCode()),
+                         boruvka.Take(boruvkaCount).OrderBy(e => e.GetHashCode()));
+        }
+    }
+
+    [Fact]
+    public void Digraph_TreatsArcsAsEdges()
+    {
+        // Arrange: arcs point in both directions; direction must not matter
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 3).Select(_ => graph.AddNode()).ToArray();
+        using var weightMap = new ArcMapDouble(graph);
+        var arc10 = graph.AddArc(nodes[1], nodes[0]);
+        var arc12 = graph.AddArc(nodes[1], nodes[2]);
+        var arc02 = graph.AddArc(nodes[0], nodes[2]);
+        weightMap[arc10] = 0.5;
+        weightMap[arc12] = 0.25;
+        weightMap[arc02] = 1.0;
+
+        var forest = new Arc[2];
+
+        // Act
+        int count = MinimumSpanningTree.Run(graph, weightMap, forest, out double totalWeight);
+
+        // Assert
+        Assert.Equal(2, count);
+        Assert.Equal(0.75, totalWeight);
+        Assert.DoesNotContain(arc02, forest);
+        Assert.Throws<ArgumentException>(() => MinimumSpanningTree.Run(graph, weightMap, new Arc[1], out _));
+    }
+
+    [Fact]
+    public void SingleNode_SelectsNoEdges()
+    {
+        // Arrange: one node with a self-loop, so the forest buffer is empty
+        using var graph = new LemonGraph();
+        var node = graph.AddNode();
+        using var weightMap = new EdgeMap(graph);
+        weightMap[graph.AddEdge(node, node)] = 4;
+        using var digraph = new LemonDigraph();
+        digraph.AddNode();
+        using var arcWeights = new ArcMapDouble(digraph);
+
+        // Act
+        int count = MinimumSpanningTree.Run(graph, weightMap, Span<Edge>.Empty, out long totalWeight);
+        int arcCount = MinimumSpanningTree.Run(digraph, arcWeights, Span<Arc>.Empty, out double arcWeight);
+
+        // Assert
+        Assert.Equal(0, count);
+        Assert.Equal(0, totalWeight);
+        Assert.Equal(0, arcCount);
+        Assert.Equal(0.0, arcWeight);
+    }
+
+    private static int CountComponents(int nodeCount, List<(int U, int V)> endpoints)
+    {
+        var parent = Enumerable.Range(0, nodeCount).ToArray();
+        int Find(int x) => parent[x] == x ? x : parent[x] = Find(parent[x]);
+
+        int components = nodeCount;
+        foreach (var (u, v) in endpoints)
+        {
+            int a = Find(u);
+            int b = Find(v);
+            if (a != b)
+            {
+                parent[a] = b;
+                components--;
+            }
+        }
+        return components;
+    }
+}
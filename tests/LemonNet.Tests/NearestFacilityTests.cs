@@ -0,0 +1,122 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class NearestFacilityTests
+{
+    private readonly ITestOutputHelper output;
+
+    public NearestFacilityTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void Path_SplitsBetweenFacilities()
+    {
+        // Arrange: bidirected path 0 - 1 - 2 - 3 - 4 with unit lengths, facilities at both ends
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i + 1 < nodes.Length; i++)
+        {
+            lengthMap[graph.AddArc(nodes[i], nodes[i + 1])] = 1.0;
+            lengthMap[graph.AddArc(nodes[i + 1], nodes[i])] = 1.0;
+        }
+
+        // Act
+        using var labels = new NearestFacility(graph, lengthMap, new[] { nodes[0], nodes[4] });
+        var nearest = new Node[graph.NodeCount];
+        var distances = new double[graph.NodeCount];
+        labels.GetLabels(nearest, distances);
+
+        // Assert: the tie at node 2 goes to the smaller facility id
+        Assert.Equal(2, labels.FacilityCount);
+        Assert.Equal(new[] { nodes[0], nodes[0], nodes[0], nodes[4], nodes[4] }, nearest);
+        Assert.Equal(new[] { 0.0, 1.0, 2.0, 1.0, 0.0 }, distances);
+
+        Assert.Equal(2, labels.AddFacility(nodes[2]));
+        Assert.Equal(nodes[0], labels.Nearest(nodes[1], out double distance));
+        Assert.Equal(nodes[2], labels.Nearest(nodes[3], out distance));
+        Assert.Equal(1.0, distance);
+        Assert.Equal(0, labels.AddFacility(nodes[2]));
+
+        Assert.Equal(2, labels.RemoveFacility(nodes[0]));
+        Assert.Equal(nodes[2], labels.Nearest(nodes[0], out distance));
+        Assert.Equal(2.0, distance);
+
+        Assert.Equal(4, labels.RemoveFacility(nodes[2]));
+        Assert.Equal(5, labels.RemoveFacility(nodes[4]));
+        Assert.Equal(Node.Invalid, labels.Nearest(nodes[3], out distance));
+        Assert.Equal(double.PositiveInfinity, distance);
+    }
+
+    [Fact]
+    public void IncrementalUpdates_MatchRebuild()
+    {
+        // Arrange: small integer lengths, including zero, so that ties are frequent
+        var random = new Random(46);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 300).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < 1200; i++)
+        {
+            var arc = graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+            lengthMap[arc] = random.Next(0, 5);
+        }
+
+        var facilities = new HashSet<Node>(Enumerable.Range(0, 20).Select(_ => nodes[random.Next(nodes.Length)]));
+        using var labels = new NearestFacility(graph, lengthMap, facilities.ToArray());
+        var nearest = new Node[nodes.Length];
+        var distances = new double[nodes.Length];
+        var expectedNearest = new Node[nodes.Length];
+        var expectedDistances = new double[nodes.Length];
+
+        for (int step = 0; step < 60; step++)
+        {
+            // Act
+            var node = nodes[random.Next(nodes.Length)];
+            if (random.Next(2) == 0 && facilities.Count > 0)
+            {
+                node = facilities.ElementAt(random.Next(facilities.Count));
+                labels.RemoveFacility(node);
+                facilities.Remove(node);
+            }
+            else
+            {
+                labels.AddFacility(node);
+                facilities.Add(node);
+            }
+            labels.GetLabels(nearest, distances);
+
+            // Assert
+            using var rebuilt = new NearestFacility(graph, lengthMap, facilities.ToArray());
+            rebuilt.GetLabels(expectedNearest, expectedDistances);
+            Assert.Equal(facilities.Count, labels.FacilityCount);
+            Assert.Equal(expectedNearest, nearest);
+            Assert.Equal(expectedDistances, distances);
+        }
+
+        // The labels are the closest facilities by full shortest path trees
+        using var deltaStepping = new DeltaStepping(graph, lengthMap) { ThreadCount = 1 };
+        var best = Enumerable.Repeat(double.PositiveInfinity, nodes.Length).ToArray();
+        foreach (var facility in facilities)
+        {
+            var tree = deltaStepping.Run(facility);
+            for (int v = 0; v < nodes.Length; v++)
+            {
+                best[v] = Math.Min(best[v], tree.Distances[v]);
+            }
+            for (int v = 0; v < nodes.Length; v++)
+            {
+                if (nearest[v] == facility) Assert.Equal(tree.Distances[v], distances[v]);
+            }
+        }
+        Assert.Equal(best, distances);
+        output.WriteLine($"{facilities.Count} facilities, {distances.Count(double.IsFinite)} nodes reached");
+    }
+}
@@ -0,0 +1,169 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class ReachabilityIndexTests
+{
+    private readonly ITestOutputHelper output;
+
+    public ReachabilityIndexTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void CycleAndChain_AnswersPairs()
+    {
+        // Arrange: cycle 0 <-> 1, then 1 -> 2 -> 3, plus 4 -> 2 and an isolated node 5
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 6).Select(_ => graph.AddNode()).ToArray();
+        graph.AddArc(nodes[0], nodes[1]);
+        graph.AddArc(nodes[1], nodes[0]);
+        graph.AddArc(nodes[1], nodes[2]);
+        graph.AddArc(nodes[2], nodes[3]);
+        graph.AddArc(nodes[4], nodes[2]);
+
+        // Act
+        using var index = ReachabilityIndex.Build(graph);
+
+        // Assert
+        Assert.Equal(5, index.ComponentCount);
+        Assert.True(index.CanReach(nodes[1], nodes[0]));
+        Assert.True(index.CanReach(nodes[0], nodes[3]));
+        Assert.True(index.CanReach(nodes[4], nodes[3]));
+        Assert.True(index.CanReach(nodes[5], nodes[5]));
+        Assert.False(index.CanReach(nodes[3], nodes[0]));
+        Assert.False(index.CanReach(nodes[4], nodes[0]));
+        Assert.False(index.CanReach(nodes[0], nodes[4]));
+        Assert.False(index.CanReach(nodes[0], nodes[5]));
+
+        var results = new bool[3];
+        int reachable = index.CanReach(new[] { (nodes[0], nodes[2]), (nodes[2], nodes[4]), (nodes[4], nodes[4]) }, results);
+        Assert.Equal(2, reachable);
+        Assert.Equal(new[] { true, false, true }, results);
+    }
+
+    [Theory]
+    [InlineData(0L)]
+    [InlineData(512L)]
+    [InlineData(1L << 20)]
+    public void RandomGraph_MatchesSearch(long maxBitsetBytes)
+    {
+        // Arrange: mostly forward arcs, so the graph is DAG-like with a few cycles
+        var random = new Random(48);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 600).Select(_ => graph.AddNode()).ToArray();
+        var successors = nodes.Select(_ => new List<int>()).ToArray();
+        for (int i = 0; i < 1500; i++)
+        {
+            int u = random.Next(nodes.Length);
+            int v = random.Next(nodes.Length);
+            if (u > v && random.Next(20) != 0) (u, v) = (v, u);
+            graph.AddArc(nodes[u], nodes[v]);
+            successors[u].Add(v);
+        }
+
+        var reaches = new bool[nodes.Length][];
+        for (int s = 0; s < nodes.Length; s++)
+        {
+            reaches[s] = new bool[nodes.Length];
+            reaches[s][s] = true;
+            var queue = new Queue<int>(new[] { s });
+            while (queue.Count > 0)
+            {
+                foreach (int w in successors[queue.Dequeue()])
+                {
+                    if (!reaches[s][w])
+                    {
+                        reaches[s][w] = true;
+                        queue.Enqueue(w);
+                    }
+                }
+            }
+        }
+
+        var sources = Enumerable.Range(0, 50000).Select(_ => nodes[random.Next(nodes.Length)]).ToArray();
+        var targets = Enumerable.Range(0, 50000).Select(_ => nodes[random.Next(nodes.Length)]).ToArray();
+        var results = new bool[sources.Length];
+
+        // Act
+        using var index = ReachabilityIndex.Build(graph, labelCount: 2, maxBitsetBytes: maxBitsetBytes, threadCount: 2);
+        int reachable = index.CanReach(sources, targets, results, threadCount: 4);
+
+        // Assert
+        var expected = sources.Select((s, i) => reaches[s.GetHashCode()][targets[i].GetHashCode()]).ToArray();
+        Assert.Equal(expected, results);
+        Assert.Equal(expected.Count(r => r), reachable);
+        if (maxBitsetBytes == 0) Assert.Equal(0, index.BitsetComponentCount);
+        output.WriteLine($"{index.ComponentCount} components, {index.BitsetComponentCount} with bitsets, {reachable} reachable pairs");
+    }
+
+    [Fact]
+    public void SaveLoad_RoundTripsIndex()
+    {
+        // Arrange
+        var random = new Random(5);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 200).Select(_ => graph.AddNode()).ToArray();
+        for (int i = 0; i < 400; i++)
+        {
+            graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+        }
+        using var index = ReachabilityIndex.Build(graph, maxBitsetBytes: 1024);
+
+        // Act
+        using var stream = new MemoryStream();
+        index.Save(stream);
+        stream.Position = 0;
+        using var loaded = ReachabilityIndex.Load(stream, graph);
+
+        // Assert
+        Assert.Equal(index.ComponentCount, loaded.ComponentCount);
+        Assert.Equal(index.BitsetComponentCount, loaded.BitsetComponentCount);
+        var pairs = Enumerable.Range(0, 5000)
+            .Select(_ => (nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]))
+            .ToArray();
+        var expected = new bool[pairs.Length];
+        var actual = new bool[pairs.Length];
+        Assert.Equal(index.CanReach(pairs, expected), loaded.CanReach(pairs, actual));
+        Assert.Equal(expected, actual);
+
+        // A truncated index is rejected
+        var bytes = stream.ToArray().AsSpan(0, (int)stream.Length - 8).ToArray();
+        BitConverter.GetBytes(bytes.Length - 8).CopyTo(bytes, 4);
+        Assert.Throws<InvalidDataException>(() => ReachabilityIndex.Load(new MemoryStream(bytes), graph));
+
+        // The index only loads for the graph it was built from
+        graph.AddNode();
+        stream.Position = 0;
+        Assert.Throws<InvalidDataException>(() => ReachabilityIndex.Load(stream, graph));
+    }
+
+    [Fact]
+    public void Load_RejectsCorruptedArcOffsets()
+    {
+        // Arrange: 0 -> 1 gives two components joined by one condensation arc
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 2).Select(_ => graph.AddNode()).ToArray();
+        graph.AddArc(nodes[0], nodes[1]);
+        using var index = ReachabilityIndex.Build(graph);
+        using var stream = new MemoryStream();
+        index.Save(stream);
+        var bytes = stream.ToArray();
+
+        // Act: magic, size, 6 header ints, the 8-byte bit window and the node components
+        // precede the arc offsets {0, 1, 1}; the middle one now points far past the single arc
+        int offsets = 8 + 24 + 8 + 4 * graph.NodeCount;
+        Assert.Equal(new[] { 0, 1, 1 }, Enumerable.Range(0, 3).Select(i => BitConverter.ToInt32(bytes, offsets + 4 * i)));
+        BitConverter.GetBytes(100000).CopyTo(bytes, offsets + 4);
+
+        // Assert: the stream has the right size, but the offsets are rejected
+        Assert.Equal(stream.Length, bytes.Length);
+        Assert.Throws<InvalidDataException>(() => ReachabilityIndex.Load(new MemoryStream(bytes), graph));
+    }
+}
@@ -0,0 +1,107 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class ReachabilityTests
+{
+    private readonly ITestOutputHelper output;
+
+    public ReachabilityTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void SmallGraph_ReportsReachableNodes()
+    {
+        // Arrange: 0 -> 1 -> 2, 3 -> 2, 4 isolated
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        graph.AddArc(nodes[0], nodes[1]);
+        graph.AddArc(nodes[1], nodes[2]);
+        graph.AddArc(nodes[3], nodes[2]);
+
+        var sources = new[] { nodes[0], nodes[3], nodes[4] };
+        int words = Connectivity.BitsetLength(graph.NodeCount);
+        var reachable = new ulong[words * sources.Length];
+        var distances = new int[graph.NodeCount * sources.Length];
+
+        // Act
+        long pairs = Reachability.FromSources(graph, sources, reachable);
+        long distancePairs = Reachability.HopDistances(graph, sources, distances);
+
+        // Assert
+        Assert.Equal(6, pairs);
+        Assert.Equal(pairs, distancePairs);
+        Assert.Equal(0b00111UL, reachable[0]);
+        Assert.Equal(0b01100UL, reachable[1]);
+        Assert.Equal(0b10000UL, reachable[2]);
+        Assert.True(Connectivity.IsSet(reachable.AsSpan(words, words), nodes[2]));
+        Assert.Equal(new[] { 0, 1, 2, -1, -1 }, distances.Take(5).ToArray());
+        Assert.Equal(new[] { -1, -1, 1, 0, -1 }, distances.Skip(5).Take(5).ToArray());
+        Assert.Equal(new[] { -1, -1, -1, -1, 0 }, distances.Skip(10).ToArray());
+    }
+
+    [Theory]
+    [InlineData(1)]
+    [InlineData(64)]
+    [InlineData(70)]
+    [InlineData(600)]
+    public void RandomGraph_MatchesBreadthFirstSearch(int sourceCount)
+    {
+        // Arrange
+        var random = new Random(sourceCount);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 300).Select(_ => graph.AddNode()).ToArray();
+        for (int i = 0; i < 700; i++)
+        {
+            graph.AddArc(nodes[random.Next(nodes.Length)], nodes[random.Next(nodes.Length)]);
+        }
+
+        var sources = Enumerable.Range(0, sourceCount).Select(_ => nodes[random.Next(nodes.Length)]).ToArray();
+        int nodeCount = graph.NodeCount;
+        int words = Connectivity.BitsetLength(nodeCount);
+        var distances = new int[nodeCount * sourceCount];
+        var reachable = new ulong[words * sourceCount];
+
+        // Act
+        long pairs = Reachability.HopDistances(graph, sources, distances);
+        Reachability.FromSources(graph, sources, reachable);
+
+        // Assert
+        using var bfs = new BreadthFirstSearch(graph);
+        var expected = new int[nodeCount];
+        var predecessors = new int[nodeCount];
+        long expectedPairs = 0;
+        for (int s = 0; s < sourceCount; s++)
+        {
+            expectedPairs += bfs.Run(sources[s], expected, predecessors);
+            Assert.Equal(expected, distances.AsSpan(s * nodeCount, nodeCount).ToArray());
+
+            var row = reachable.AsSpan(s * words, words);
+            for (int v = 0; v < nodeCount; v++)
+            {
+                Assert.Equal(expected[v] >= 0, Connectivity.IsSet(row, nodes[v]));
+            }
+        }
+        Assert.Equal(expectedPairs, pairs);
+        output.WriteLine($"{sourceCount} sources reach {pairs} (source, node) pairs");
+    }
+
+    [Fact]
+    public void InvalidArguments_Throw()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node = graph.AddNode();
+        var sources = new[] { node, node };
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() => Reachability.HopDistances(graph, sources, new int[1]));
+        Assert.Throws<ArgumentException>(() => Reachability.FromSources(graph, sources, new ulong[1]));
+        Assert.Equal(0, Reachability.FromSources(graph, ReadOnlySpan<Node>.Empty, Span<ulong>.Empty));
+    }
+}
@@ -0,0 +1,145 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class ScenarioBatchTests
+{
+    private readonly ITestOutputHelper output;
+
+    public ScenarioBatchTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    private static (Node[] Nodes, Arc[] Arcs) AddRandomGraph(LemonDigraph graph, Random random, int nodeCount, int arcCount)
+    {
+        var nodes = Enumerable.Range(0, nodeCount).Select(_ => graph.AddNode()).ToArray();
+        var arcs = Enumerable.Range(0, arcCount)
+            .Select(_ => graph.AddArc(nodes[random.Next(nodeCount)], nodes[random.Next(nodeCount)]))
+            .ToArray();
+        return (nodes, arcs);
+    }
+
+    [Theory]
+    [InlineData(ScenarioAlgorithm.Preflow)]
+    [InlineData(ScenarioAlgorithm.EdmondsKarp)]
+    public void MaxFlow_MatchesSingleRuns(ScenarioAlgorithm algorithm)
+    {
+        // Arrange
+        var random = new Random(50);
+        using var graph = new LemonDigraph();
+        var (nodes, arcs) = AddRandomGraph(graph, random, 60, 400);
+        const int scenarioCount = 24;
+        var capacities = Enumerable.Range(0, scenarioCount * arcs.Length).Select(_ => (long)random.Next(0, 30)).ToArray();
+        var flowValues = new long[scenarioCount];
+        var arcFlows = new long[capacities.Length];
+
+        // Act
+        ScenarioBatch.Run(graph, algorithm, nodes[0], nodes[1], capacities, flowValues, arcFlows, threadCount: 4);
+
+        // Assert: each scenario as solved on its own arc map
+        using var capacityMap = new ArcMap(graph);
+        for (int k = 0; k < scenarioCount; k++)
+        {
+            foreach (var arc in arcs)
+            {
+                capacityMap[arc] = capacities[k * arcs.Length + arc.GetHashCode()];
+            }
+
+            MaxFlowResult expected;
+            if (algorithm == ScenarioAlgorithm.Preflow)
+            {
+                using var preflow = new Preflow(graph, capacityMap);
+                expected = preflow.Run(nodes[0], nodes[1]);
+            }
+            else
+            {
+                using var edmondsKarp = new EdmondsKarp(graph, capacityMap);
+                expected = edmondsKarp.Run(nodes[0], nodes[1]);
+            }
+
+            Assert.Equal(expected.MaxFlowValue, flowValues[k]);
+            var expectedFlows = new long[arcs.Length];
+            foreach (var edgeFlow in expected.EdgeFlows)
+            {
+                expectedFlows[edgeFlow.Arc.GetHashCode()] = edgeFlow.Flow;
+            }
+            Assert.Equal(expectedFlows, arcFlows.AsSpan(k * arcs.Length, arcs.Length).ToArray());
+        }
+
+        // The flow values alone come out the same
+        var valuesOnly = new long[scenarioCount];
+        ScenarioBatch.Run(graph, algorithm, nodes[0], nodes[1], capacities, valuesOnly);
+        Assert.Equal(flowValues, valuesOnly);
+        output.WriteLine($"Flow values: {string.Join(", ", flowValues)}");
+    }
+
+    [Fact]
+    public void Dijkstra_MatchesSingleRuns()
+    {
+        // Arrange
+        var random = new Random(51);
+        using var graph = new LemonDigraph();
+        var (nodes, arcs) = AddRandomGraph(graph, random, 80, 240);
+        const int scenarioCount = 30;
+        var lengths = Enumerable.Range(0, scenarioCount * arcs.Length).Select(_ => (long)random.Next(0, 100)).ToArray();
+        var distances = new long[scenarioCount];
+        var onPath = new long[lengths.Length];
+
+        // Act
+        ScenarioBatch.Run(graph, ScenarioAlgorithm.Dijkstra, nodes[0], nodes[5], lengths, distances, onPath, threadCount: 3);
+
+        // Assert
+        using var lengthMap = new ArcMap(graph);
+        using var dijkstra = new DijkstraLong(graph, lengthMap);
+        int reachedCount = 0;
+        for (int k = 0; k < scenarioCount; k++)
+        {
+            foreach (var arc in arcs)
+            {
+                lengthMap[arc] = lengths[k * arcs.Length + arc.GetHashCode()];
+            }
+
+            var expected = dijkstra.Run(nodes[0], nodes[5]);
+            Assert.Equal(expected.Distance, distances[k]);
+
+            var path = arcs.Where(arc => onPath[k * arcs.Length + arc.GetHashCode()] == 1).ToArray();
+            if (!expected.TargetReached)
+            {
+                Assert.Empty(path);
+                continue;
+            }
+            reachedCount++;
+            Assert.Equal(expected.Distance, path.Sum(arc => lengths[k * arcs.Length + arc.GetHashCode()]));
+        }
+
+        Assert.True(reachedCount > 0);
+        output.WriteLine($"{reachedCount} of {scenarioCount} scenarios reach the target");
+    }
+
+    [Fact]
+    public void InvalidInput_Throws()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var a = graph.AddNode();
+        var b = graph.AddNode();
+        graph.AddArc(a, b);
+        graph.AddArc(b, a);
+        var objectives = new long[2];
+
+        // Act & Assert
+        Assert.Throws<ArgumentException>(() =>
+            ScenarioBatch.Run(graph, ScenarioAlgorithm.Preflow, a, b, new long[3], objectives));
+        Assert.Throws<ArgumentException>(() =>
+            ScenarioBatch.Run(graph, ScenarioAlgorithm.Preflow, a, a, new long[4], objectives));
+        Assert.Throws<ArgumentException>(() =>
+            ScenarioBatch.Run(graph, ScenarioAlgorithm.Dijkstra, a, b, new long[] { 1, 1, -1, 1 }, objectives));
+
+        ScenarioBatch.Run(graph, ScenarioAlgorithm.Dijkstra, a, a, new long[] { 1, 1, 2, 2 }, objectives);
+        Assert.Equal(new long[] { 0, 0 }, objectives);
+    }
+}
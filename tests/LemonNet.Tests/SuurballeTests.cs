@@ -0,0 +1,139 @@
+using System;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class SuurballeTests
+{
+    private readonly ITestOutputHelper output;
+
+    public SuurballeTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void TrapTopology_FindsBothPaths()
+    {
+        // Arrange: the shortest path 0-1-2-3 blocks every second path,
+        // removing its arcs and searching again would find only one
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+        var node3 = graph.AddNode();
+
+        var arc01 = graph.AddArc(node0, node1);
+        var arc12 = graph.AddArc(node1, node2);
+        var arc23 = graph.AddArc(node2, node3);
+        var arc02 = graph.AddArc(node0, node2);
+        var arc13 = graph.AddArc(node1, node3);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arc01] = 1.0;
+        lengthMap[arc12] = 1.0;
+        lengthMap[arc23] = 1.0;
+        lengthMap[arc02] = 2.0;
+        lengthMap[arc13] = 2.0;
+
+        using var suurballe = new Suurballe(graph, lengthMap);
+
+        // Act
+        var result = suurballe.Run(node0, node3);
+
+        // Assert: 0-1-3 and 0-2-3
+        Assert.Equal(2, result.Paths.Count);
+        Assert.Equal(6.0, result.TotalLength);
+        Assert.Equal(6.0, result.Paths.Sum(p => p.GetTotalCost(lengthMap)));
+        Assert.DoesNotContain(arc12, result.Paths.SelectMany(p => p));
+        output.WriteLine(result.ToString());
+    }
+
+    [Fact]
+    public void NodeDisjoint_AvoidsSharedNode()
+    {
+        // Arrange: two arc-disjoint paths exist, but both pass node 1
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        var node2 = graph.AddNode();
+
+        var arcA = graph.AddArc(node0, node1);
+        var arcB = graph.AddArc(node0, node1);
+        var arcC = graph.AddArc(node1, node2);
+        var arcD = graph.AddArc(node1, node2);
+        var arcE = graph.AddArc(node0, node2);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        lengthMap[arcA] = 1.0;
+        lengthMap[arcB] = 1.0;
+        lengthMap[arcC] = 1.0;
+        lengthMap[arcD] = 1.0;
+        lengthMap[arcE] = 10.0;
+
+        using var arcDisjoint = new Suurballe(graph, lengthMap, Disjointness.Arcs);
+        using var nodeDisjoint = new Suurballe(graph, lengthMap, Disjointness.Nodes);
+
+        // Act
+        var arcResult = arcDisjoint.Run(node0, node2, 3);
+        var nodeResult = nodeDisjoint.Run(node0, node2, 3);
+
+        // Assert
+        Assert.Equal(3, arcResult.Paths.Count);
+        Assert.Equal(14.0, arcResult.TotalLength);
+        Assert.Equal(2, nodeResult.Paths.Count);
+        Assert.Equal(12.0, nodeResult.TotalLength);
+        Assert.Contains(nodeResult.Paths, p => p.Length == 1 && p[0] == arcE);
+    }
+
+    [Fact]
+    public void RepeatedQueries_ReuseInstance()
+    {
+        // Arrange: a ring 0-1-2-3-4-5-0 in both directions
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 6).Select(_ => graph.AddNode()).ToArray();
+        using var lengthMap = new ArcMapDouble(graph);
+        for (int i = 0; i < nodes.Length; i++)
+        {
+            var next = nodes[(i + 1) % nodes.Length];
+            lengthMap[graph.AddArc(nodes[i], next)] = 1.0;
+            lengthMap[graph.AddArc(next, nodes[i])] = 1.0;
+        }
+
+        using var suurballe = new Suurballe(graph, lengthMap, Disjointness.Nodes);
+
+        // Act & Assert: both ways around the ring always sum to its length
+        for (int t = 1; t < nodes.Length; t++)
+        {
+            var result = suurballe.Run(nodes[0], nodes[t]);
+            Assert.Equal(2, result.Paths.Count);
+            Assert.Equal(6.0, result.TotalLength);
+            Assert.All(result.Paths, p => Assert.Equal(nodes[t], p.Target));
+        }
+
+        Assert.Single(suurballe.Run(nodes[0], nodes[3], 1).Paths);
+        Assert.Empty(suurballe.Run(nodes[2], nodes[4], 0).Paths);
+    }
+
+    [Fact]
+    public void UnreachableTarget_ReturnsNoPaths()
+    {
+        // Arrange
+        using var graph = new LemonDigraph();
+        var node0 = graph.AddNode();
+        var node1 = graph.AddNode();
+        graph.AddArc(node1, node0);
+
+        using var lengthMap = new ArcMapDouble(graph);
+        using var suurballe = new Suurballe(graph, lengthMap);
+
+        // Act
+        var result = suurballe.Run(node0, node1);
+
+        // Assert
+        Assert.Empty(result.Paths);
+        Assert.Equal(0.0, result.TotalLength);
+    }
+}
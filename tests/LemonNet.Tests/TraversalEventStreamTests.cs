@@ -0,0 +1,161 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace LemonNet.Tests;
+
+public class TraversalEventStreamTests
+{
+    private readonly ITestOutputHelper output;
+
+    public TraversalEventStreamTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void DepthFirst_StreamsVisitorEventsInOrder()
+    {
+        // Arrange: diamond 0 -> {1, 2} -> 3 with a back arc 3 -> 0, and an isolated node 4
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 5).Select(_ => graph.AddNode()).ToArray();
+        var arc01 = graph.AddArc(nodes[0], nodes[1]);
+        var arc02 = graph.AddArc(nodes[0], nodes[2]);
+        var arc13 = graph.AddArc(nodes[1], nodes[3]);
+        var arc23 = graph.AddArc(nodes[2], nodes[3]);
+        var arc30 = graph.AddArc(nodes[3], nodes[0]);
+
+        // A tiny buffer, so that reads span several chunks and single steps overflow it
+        using var stream = new TraversalEventStream(graph, TraversalKind.DepthFirst, capacity: 2) { FlushThreshold = 1 };
+        var buffer = new TraversalEvent[3];
+        var events = new List<TraversalEvent>();
+
+        // Act
+        stream.Start(new[] { nodes[0], nodes[4] });
+        for (int count; (count = stream.Read(buffer)) > 0;)
+        {
+            events.AddRange(buffer.Take(count));
+        }
+
+        // Assert: SmartDigraph lists out-arcs newest first, so 0 -> 2 is explored before 0 -> 1
+        var expected = new (TraversalEventKind Kind, Node Node, Arc Arc)[]
+        {
+            (TraversalEventKind.Start, nodes[0], Arc.Invalid),
+            (TraversalEventKind.Reach, nodes[0], Arc.Invalid),
+            (TraversalEventKind.Discover, nodes[2], arc02),
+            (TraversalEventKind.Reach, nodes[2], Arc.Invalid),
+            (TraversalEventKind.Discover, nodes[3], arc23),
+            (TraversalEventKind.Reach, nodes[3], Arc.Invalid),
+            (TraversalEventKind.Examine, nodes[0], arc30),
+            (TraversalEventKind.Leave, nodes[3], Arc.Invalid),
+            (TraversalEventKind.Backtrack, nodes[2], arc23),
+            (TraversalEventKind.Leave, nodes[2], Arc.Invalid),
+            (TraversalEventKind.Backtrack, nodes[0], arc02),
+            (TraversalEventKind.Discover, nodes[1], arc01),
+            (TraversalEventKind.Reach, nodes[1], Arc.Invalid),
+            (TraversalEventKind.Examine, nodes[3], arc13),
+            (TraversalEventKind.Leave, nodes[1], Arc.Invalid),
+            (TraversalEventKind.Backtrack, nodes[0], arc01),
+            (TraversalEventKind.Leave, nodes[0], Arc.Invalid),
+            (TraversalEventKind.Stop, nodes[0], Arc.Invalid),
+            (TraversalEventKind.Start, nodes[4], Arc.Invalid),
+            (TraversalEventKind.Reach, nodes[4], Arc.Invalid),
+            (TraversalEventKind.Leave, nodes[4], Arc.Invalid),
+            (TraversalEventKind.Stop, nodes[4], Arc.Invalid),
+        };
+        Assert.Equal(expected, events.Select(e => (e.Kind, e.Node, e.Arc)).ToArray());
+        Assert.Equal(0, stream.Read(buffer));
+        foreach (var e in events)
+        {
+            output.WriteLine(e.ToString());
+        }
+    }
+
+    [Fact]
+    public void BreadthFirst_ReachOrderMatchesHopDistances()
+    {
+        // Arrange
+        var random = new Random(44);
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 500).Select(_ => graph.AddNode()).ToArray();
+        var arcSources = new List<int>();
+        for (int i = 0; i < 1500; i++)
+        {
+            int u = random.Next(nodes.Length);
+            graph.AddArc(nodes[u], nodes[random.Next(nodes.Length)]);
+            arcSources.Add(u);
+        }
+
+        using var bfs = new BreadthFirstSearch(graph) { DirectionOptimizing = false };
+        var distances = new int[graph.NodeCount];
+        int expectedReached = bfs.Run(nodes[0], distances, new int[graph.NodeCount]);
+
+        using var stream = new TraversalEventStream(graph, TraversalKind.BreadthFirst, capacity: 64)
+        {
+            EventFilter = TraversalEventKind.Reach | TraversalEventKind.Discover,
+            FlushThreshold = 16
+        };
+        var buffer = new TraversalEvent[10];
+        var reachOrder = new List<Node>();
+        var level = new int[graph.NodeCount];
+
+        // Act
+        stream.Start(nodes[0]);
+        for (int count; (count = stream.Read(buffer)) > 0;)
+        {
+            foreach (var e in buffer.AsSpan(0, count))
+            {
+                Assert.NotEqual(TraversalEventKind.Examine, e.Kind);
+                if (e.Kind == TraversalEventKind.Reach)
+                {
+                    reachOrder.Add(e.Node);
+                }
+                else
+                {
+                    level[e.Node.GetHashCode()] = level[arcSources[e.Arc.GetHashCode()]] + 1;
+                }
+            }
+        }
+
+        // Assert: nodes are reached level by level, and tree arcs give the hop distances
+        Assert.Equal(expectedReached, reachOrder.Count);
+        var reachedDistances = reachOrder.Select(n => distances[n.GetHashCode()]).ToArray();
+        Assert.Equal(reachedDistances.OrderBy(d => d).ToArray(), reachedDistances);
+        foreach (var node in reachOrder)
+        {
+            Assert.Equal(distances[node.GetHashCode()], level[node.GetHashCode()]);
+        }
+    }
+
+    [Fact]
+    public void Restart_ResetsTraversal()
+    {
+        // Arrange: path 0 -> 1 -> 2
+        using var graph = new LemonDigraph();
+        var nodes = Enumerable.Range(0, 3).Select(_ => graph.AddNode()).ToArray();
+        graph.AddArc(nodes[0], nodes[1]);
+        graph.AddArc(nodes[1], nodes[2]);
+
+        using var stream = new TraversalEventStream(graph, TraversalKind.BreadthFirst)
+        {
+            EventFilter = TraversalEventKind.Reach
+        };
+        var buffer = new TraversalEvent[8];
+
+        // Act & Assert
+        Assert.Throws<InvalidOperationException>(() => stream.Read(buffer));
+
+        stream.Start(nodes[0]);
+        Assert.Equal(3, stream.Read(buffer));
+        Assert.Equal(0, stream.Read(buffer));
+
+        stream.Start(nodes[1]);
+        Assert.Equal(2, stream.Read(buffer));
+        Assert.Equal(new[] { nodes[1], nodes[2] }, buffer.Take(2).Select(e => e.Node).ToArray());
+
+        stream.FlushThreshold = 5000;
+        Assert.Throws<InvalidOperationException>(() => stream.Start(nodes[0]));
+    }
+}